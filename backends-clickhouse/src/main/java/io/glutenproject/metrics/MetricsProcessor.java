@@ -39,6 +39,18 @@ public class MetricsProcessor {
   @JsonProperty("output_bytes")
   protected long outputBytes = 0;
 
+  @JsonProperty("total_row_groups")
+  protected long totalRowGroups = 0;
+
+  @JsonProperty("skipped_row_groups")
+  protected long skippedRowGroups = 0;
+
+  @JsonProperty("metadata_cache_hits")
+  protected long metadataCacheHits = 0;
+
+  @JsonProperty("metadata_cache_misses")
+  protected long metadataCacheMisses = 0;
+
   public String getName() {
     return name;
   }
@@ -102,4 +114,36 @@ public class MetricsProcessor {
   public void setOutputBytes(long outputBytes) {
     this.outputBytes = outputBytes;
   }
+
+  public long getTotalRowGroups() {
+    return totalRowGroups;
+  }
+
+  public void setTotalRowGroups(long totalRowGroups) {
+    this.totalRowGroups = totalRowGroups;
+  }
+
+  public long getSkippedRowGroups() {
+    return skippedRowGroups;
+  }
+
+  public void setSkippedRowGroups(long skippedRowGroups) {
+    this.skippedRowGroups = skippedRowGroups;
+  }
+
+  public long getMetadataCacheHits() {
+    return metadataCacheHits;
+  }
+
+  public void setMetadataCacheHits(long metadataCacheHits) {
+    this.metadataCacheHits = metadataCacheHits;
+  }
+
+  public long getMetadataCacheMisses() {
+    return metadataCacheMisses;
+  }
+
+  public void setMetadataCacheMisses(long metadataCacheMisses) {
+    this.metadataCacheMisses = metadataCacheMisses;
+  }
 }
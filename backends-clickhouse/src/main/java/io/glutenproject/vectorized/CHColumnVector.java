@@ -22,12 +22,21 @@ import org.apache.spark.sql.types.Decimal;
 import org.apache.spark.sql.vectorized.ColumnVector;
 import org.apache.spark.sql.vectorized.ColumnarArray;
 import org.apache.spark.sql.vectorized.ColumnarMap;
+import org.apache.spark.unsafe.Platform;
 import org.apache.spark.unsafe.types.UTF8String;
 
 public class CHColumnVector extends ColumnVector {
   private final int columnPosition;
   private long blockAddress;
 
+  // Addresses of the native buffers of the column, see nativeGetBuffers. Columns that have them
+  // are read in place, the others with a JNI call per value.
+  private boolean buffersLoaded = false;
+  private long nullMapAddress = 0;
+  private long dataAddress = 0;
+  private long offsetsAddress = 0;
+  private long valueSize = 0;
+
   public CHColumnVector(DataType type, long blockAddress, int columnPosition) {
     super(type);
     this.blockAddress = blockAddress;
@@ -43,6 +52,26 @@ public class CHColumnVector extends ColumnVector {
     // blockAddress = 0;
   }
 
+  private native long[] nativeGetBuffers(long blockAddress, int columnPosition);
+
+  private boolean hasBuffers() {
+    if (!buffersLoaded) {
+      long[] buffers = nativeGetBuffers(blockAddress, columnPosition);
+      if (buffers != null) {
+        nullMapAddress = buffers[0];
+        dataAddress = buffers[1];
+        offsetsAddress = buffers[2];
+        valueSize = buffers[3];
+      }
+      buffersLoaded = true;
+    }
+    return dataAddress != 0;
+  }
+
+  private boolean hasFixedSizeBuffers(int size) {
+    return hasBuffers() && valueSize == size;
+  }
+
   private native boolean nativeHasNull(long blockAddress, int columnPosition);
 
   @Override
@@ -61,6 +90,9 @@ public class CHColumnVector extends ColumnVector {
 
   @Override
   public boolean isNullAt(int rowId) {
+    if (hasBuffers()) {
+      return nullMapAddress != 0 && Platform.getByte(null, nullMapAddress + rowId) != 0;
+    }
     return nativeIsNullAt(rowId, blockAddress, columnPosition);
   }
 
@@ -68,6 +100,9 @@ public class CHColumnVector extends ColumnVector {
 
   @Override
   public boolean getBoolean(int rowId) {
+    if (hasFixedSizeBuffers(1)) {
+      return Platform.getByte(null, dataAddress + rowId) != 0;
+    }
     return nativeGetBoolean(rowId, blockAddress, columnPosition);
   }
 
@@ -75,6 +110,9 @@ public class CHColumnVector extends ColumnVector {
 
   @Override
   public byte getByte(int rowId) {
+    if (hasFixedSizeBuffers(1)) {
+      return Platform.getByte(null, dataAddress + rowId);
+    }
     return nativeGetByte(rowId, blockAddress, columnPosition);
   }
 
@@ -82,6 +120,9 @@ public class CHColumnVector extends ColumnVector {
 
   @Override
   public short getShort(int rowId) {
+    if (hasFixedSizeBuffers(2)) {
+      return Platform.getShort(null, dataAddress + rowId * 2L);
+    }
     return nativeGetShort(rowId, blockAddress, columnPosition);
   }
 
@@ -89,6 +130,10 @@ public class CHColumnVector extends ColumnVector {
 
   @Override
   public int getInt(int rowId) {
+    // Date is stored in 2 bytes and still takes the native path.
+    if (hasFixedSizeBuffers(4)) {
+      return Platform.getInt(null, dataAddress + rowId * 4L);
+    }
     return nativeGetInt(rowId, blockAddress, columnPosition);
   }
 
@@ -96,6 +141,9 @@ public class CHColumnVector extends ColumnVector {
 
   @Override
   public long getLong(int rowId) {
+    if (hasFixedSizeBuffers(8)) {
+      return Platform.getLong(null, dataAddress + rowId * 8L);
+    }
     return nativeGetLong(rowId, blockAddress, columnPosition);
   }
 
@@ -103,6 +151,9 @@ public class CHColumnVector extends ColumnVector {
 
   @Override
   public float getFloat(int rowId) {
+    if (hasFixedSizeBuffers(4)) {
+      return Platform.getFloat(null, dataAddress + rowId * 4L);
+    }
     return nativeGetFloat(rowId, blockAddress, columnPosition);
   }
 
@@ -110,6 +161,9 @@ public class CHColumnVector extends ColumnVector {
 
   @Override
   public double getDouble(int rowId) {
+    if (hasFixedSizeBuffers(8)) {
+      return Platform.getDouble(null, dataAddress + rowId * 8L);
+    }
     return nativeGetDouble(rowId, blockAddress, columnPosition);
   }
 
@@ -132,6 +186,12 @@ public class CHColumnVector extends ColumnVector {
 
   @Override
   public UTF8String getUTF8String(int rowId) {
+    if (hasBuffers() && offsetsAddress != 0) {
+      // The offset before the first row is 0, and each string is followed by a zero byte.
+      long start = Platform.getLong(null, offsetsAddress + (rowId - 1) * 8L);
+      long end = Platform.getLong(null, offsetsAddress + rowId * 8L);
+      return UTF8String.fromAddress(null, dataAddress + start, (int) (end - start - 1));
+    }
     return UTF8String.fromString(nativeGetString(rowId, blockAddress, columnPosition));
   }
 
@@ -30,7 +30,9 @@ public class CHShuffleSplitterJniWrapper {
       String codec,
       String dataFile,
       String localDirs,
-      int subDirsPerLocalDir) {
+      int subDirsPerLocalDir,
+      long allocId,
+      long spillThreshold) {
     return nativeMake(
         part.getShortName(),
         part.getNumPartitions(),
@@ -42,7 +44,9 @@ public class CHShuffleSplitterJniWrapper {
         codec,
         dataFile,
         localDirs,
-        subDirsPerLocalDir);
+        subDirsPerLocalDir,
+        allocId,
+        spillThreshold);
   }
 
   public native long nativeMake(
@@ -56,7 +60,9 @@ public class CHShuffleSplitterJniWrapper {
       String codec,
       String dataFile,
       String localDirs,
-      int subDirsPerLocalDir);
+      int subDirsPerLocalDir,
+      long allocId,
+      long spillThreshold);
 
   public native void split(long splitterId, int numRows, long block);
 
@@ -26,6 +26,8 @@ public class CHStreamReader implements AutoCloseable {
   private long nativeShuffleReader;
   private boolean compressed;
   private int bufferSize;
+  // the stats of the native reader, kept once it is closed
+  private long[] readStats = new long[3];
 
   public CHStreamReader(InputStream inputStream, int bufferSize) {
     this(inputStream, false, false, bufferSize);
@@ -57,11 +59,31 @@ public class CHStreamReader implements AutoCloseable {
 
   private native void nativeClose(long shuffleReader);
 
+  // calls to the input stream, bytes read and nanoseconds spent in them by the native reader
+  private native long[] nativeReadStats(long shuffleReader);
+
+  public long getReadCalls() {
+    return nativeShuffleReader != 0L ? nativeReadStats(nativeShuffleReader)[0] : readStats[0];
+  }
+
+  public long getReadBytes() {
+    return nativeShuffleReader != 0L ? nativeReadStats(nativeShuffleReader)[1] : readStats[1];
+  }
+
+  public long getReadNanos() {
+    return nativeShuffleReader != 0L ? nativeReadStats(nativeShuffleReader)[2] : readStats[2];
+  }
+
   @Override
   public void close() throws Exception {
-    // close input stream and release buffer
-    this.inputStream.close();
+    if (nativeShuffleReader == 0L) {
+      return;
+    }
+    readStats = nativeReadStats(nativeShuffleReader);
+    // release the native reader first, it may still be reading ahead from the input stream
     nativeClose(nativeShuffleReader);
     nativeShuffleReader = 0L;
+    // close input stream and release buffer
+    this.inputStream.close();
   }
 }
@@ -72,6 +72,13 @@ object CHBackendSettings extends BackendSettingsApi with Logging {
   // unit: SECONDS, default 1 day
   val GLUTEN_CLICKHOUSE_BROADCAST_CACHE_EXPIRED_TIME_DEFAULT: Int = 86400
 
+  // Bytes of buffered shuffle data after which the splitter spills its largest partitions, even if
+  // Spark would grant more memory. 0 means spill only when a memory reservation is refused.
+  val GLUTEN_CLICKHOUSE_SHUFFLE_SPILL_THRESHOLD: String =
+    GlutenConfig.GLUTEN_CONFIG_PREFIX + GlutenConfig.GLUTEN_CLICKHOUSE_BACKEND +
+      ".shuffle.spill.threshold"
+  val GLUTEN_CLICKHOUSE_SHUFFLE_SPILL_THRESHOLD_DEFAULT = "0"
+
   val GLUTNE_CLICKHOUSE_SHUFFLE_SUPPORTED_CODEC: Set[String] = Set("lz4", "zstd", "snappy")
 
   override def supportFileFormatRead(
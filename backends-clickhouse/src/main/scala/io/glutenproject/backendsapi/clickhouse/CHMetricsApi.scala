@@ -104,7 +104,14 @@ class CHMetricsApi extends MetricsApi with Logging with LogLevelUtil {
       "pruningTime" ->
         SQLMetrics.createTimingMetric(sparkContext, "dynamic partition pruning time"),
       "numOutputRows" -> SQLMetrics.createMetric(sparkContext, "number of output rows"),
-      "extraTime" -> SQLMetrics.createTimingMetric(sparkContext, "extra operators time")
+      "extraTime" -> SQLMetrics.createTimingMetric(sparkContext, "extra operators time"),
+      "totalRowGroups" -> SQLMetrics.createMetric(sparkContext, "number of row groups to read"),
+      "skippedRowGroups" ->
+        SQLMetrics.createMetric(sparkContext, "number of row groups skipped by statistics"),
+      "metadataCacheHits" ->
+        SQLMetrics.createMetric(sparkContext, "number of file footer cache hits"),
+      "metadataCacheMisses" ->
+        SQLMetrics.createMetric(sparkContext, "number of file footer cache misses")
     )
 
   override def genFileSourceScanTransformerMetricsUpdater(
@@ -207,7 +214,13 @@ class CHMetricsApi extends MetricsApi with Logging with LogLevelUtil {
       "inputBatches" -> SQLMetrics
         .createMetric(sparkContext, "number of input batches"),
       "outputBatches" -> SQLMetrics
-        .createMetric(sparkContext, "number of output batches")
+        .createMetric(sparkContext, "number of output batches"),
+      "shuffleReadCalls" -> SQLMetrics
+        .createMetric(sparkContext, "number of shuffle input stream reads"),
+      "shuffleReadBytes" -> SQLMetrics
+        .createSizeMetric(sparkContext, "shuffle bytes read from input stream"),
+      "shuffleReadTime" -> SQLMetrics
+        .createNanoTimingMetric(sparkContext, "totaltime to read shuffle input stream")
     )
 
   override def genWindowTransformerMetrics(sparkContext: SparkContext): Map[String, SQLMetric] =
@@ -225,7 +225,10 @@ class CHSparkPlanExecApi extends SparkPlanExecApi {
     new CHColumnarBatchSerializer(
       metrics("avgReadBatchNumRows"),
       metrics("numOutputRows"),
-      metrics("dataSize"))
+      metrics("dataSize"),
+      metrics("shuffleReadCalls"),
+      metrics("shuffleReadBytes"),
+      metrics("shuffleReadTime"))
   }
 
   /** Create broadcast relation for BroadcastExchangeExec */
@@ -35,6 +35,10 @@ class FileSourceScanMetricsUpdater(@transient val metrics: Map[String, SQLMetric
   val extraTime: SQLMetric = metrics("extraTime")
   val inputWaitTime: SQLMetric = metrics("inputWaitTime")
   val outputWaitTime: SQLMetric = metrics("outputWaitTime")
+  val totalRowGroups: SQLMetric = metrics("totalRowGroups")
+  val skippedRowGroups: SQLMetric = metrics("skippedRowGroups")
+  val metadataCacheHits: SQLMetric = metrics("metadataCacheHits")
+  val metadataCacheMisses: SQLMetric = metrics("metadataCacheMisses")
 
   override def updateInputMetrics(inputMetrics: InputMetricsWrapper): Unit = {
     // inputMetrics.bridgeIncBytesRead(metrics("inputBytes").value)
@@ -61,6 +65,15 @@ class FileSourceScanMetricsUpdater(@transient val metrics: Map[String, SQLMetric
           FileSourceScanMetricsUpdater.INCLUDING_PROCESSORS,
           FileSourceScanMetricsUpdater.CH_PLAN_NODE_NAME
         )
+        MetricsUtil
+          .getAllProcessorList(metricsData)
+          .foreach(
+            processor => {
+              totalRowGroups += processor.totalRowGroups
+              skippedRowGroups += processor.skippedRowGroups
+              metadataCacheHits += processor.metadataCacheHits
+              metadataCacheMisses += processor.metadataCacheMisses
+            })
       }
     }
   }
@@ -19,7 +19,7 @@ package io.glutenproject.vectorized
 import io.glutenproject.GlutenConfig
 import io.glutenproject.backendsapi.clickhouse.CHBackendSettings
 
-import org.apache.spark.SparkEnv
+import org.apache.spark.{SparkEnv, TaskContext}
 import org.apache.spark.internal.Logging
 import org.apache.spark.serializer.{DeserializationStream, SerializationStream, Serializer, SerializerInstance}
 import org.apache.spark.shuffle.GlutenShuffleUtils
@@ -35,13 +35,22 @@ import scala.reflect.ClassTag
 class CHColumnarBatchSerializer(
     readBatchNumRows: SQLMetric,
     numOutputRows: SQLMetric,
-    dataSize: SQLMetric)
+    dataSize: SQLMetric,
+    readCalls: SQLMetric,
+    readBytes: SQLMetric,
+    readTime: SQLMetric)
   extends Serializer
   with Serializable {
 
   /** Creates a new [[SerializerInstance]]. */
   override def newInstance(): SerializerInstance = {
-    new CHColumnarBatchSerializerInstance(readBatchNumRows, numOutputRows, dataSize)
+    new CHColumnarBatchSerializerInstance(
+      readBatchNumRows,
+      numOutputRows,
+      dataSize,
+      readCalls,
+      readBytes,
+      readTime)
   }
 
   override def supportsRelocationOfSerializedObjects: Boolean = true
@@ -50,7 +59,10 @@ class CHColumnarBatchSerializer(
 private class CHColumnarBatchSerializerInstance(
     readBatchNumRows: SQLMetric,
     numOutputRows: SQLMetric,
-    dataSize: SQLMetric)
+    dataSize: SQLMetric,
+    readCalls: SQLMetric,
+    readBytes: SQLMetric,
+    readTime: SQLMetric)
   extends SerializerInstance
   with Logging {
 
@@ -118,6 +130,9 @@ private class CHColumnarBatchSerializerInstance(
             isUseColumnarShufflemanager,
             isCustomizedShuffleCodec,
             customizeBufferSize)
+          // the stream is closed on EOF only, a task that stops reading early (e.g. under a limit)
+          // closes it on completion, so that the native reader joins its read ahead thread
+          Option(TaskContext.get()).foreach(_.addTaskCompletionListener[Unit](_ => close()))
           readValue()
         }
       }
@@ -137,7 +152,12 @@ private class CHColumnarBatchSerializerInstance(
             cb.close()
             cb = null
           }
-          if (reader != null) reader.close()
+          if (reader != null) {
+            reader.close()
+            readCalls += reader.getReadCalls
+            readBytes += reader.getReadBytes
+            readTime += reader.getReadNanos
+          }
           isClosed = true
         }
       }
@@ -17,6 +17,8 @@
 package org.apache.spark.shuffle
 
 import io.glutenproject.GlutenConfig
+import io.glutenproject.backendsapi.clickhouse.CHBackendSettings
+import io.glutenproject.memory.alloc.CHNativeMemoryAllocators
 import io.glutenproject.vectorized._
 
 import org.apache.spark.SparkEnv
@@ -54,6 +56,9 @@ class CHColumnarShuffleWriter[K, V](
     GlutenConfig.getConf.columnarShuffleBatchCompressThreshold;
   private val preferSpill = GlutenConfig.getConf.columnarShufflePreferSpill
   private val writeSchema = GlutenConfig.getConf.columnarShuffleWriteSchema
+  private val spillThreshold = conf.getSizeAsBytes(
+    CHBackendSettings.GLUTEN_CLICKHOUSE_SHUFFLE_SPILL_THRESHOLD,
+    CHBackendSettings.GLUTEN_CLICKHOUSE_SHUFFLE_SPILL_THRESHOLD_DEFAULT)
   private val jniWrapper = new CHShuffleSplitterJniWrapper
   // Are we in the process of stopping? Because map tasks can call stop() with success = true
   // and then call stop() with success = false if they get an exception, we want to make sure
@@ -99,7 +104,9 @@ class CHColumnarShuffleWriter[K, V](
         customizedCompressCodec,
         dataTmp.getAbsolutePath,
         localDirs,
-        subDirsPerLocalDir)
+        subDirsPerLocalDir,
+        CHNativeMemoryAllocators.contextInstance().getNativeInstanceId,
+        spillThreshold)
     }
     while (records.hasNext) {
       val cb = records.next()._2.asInstanceOf[ColumnarBatch]
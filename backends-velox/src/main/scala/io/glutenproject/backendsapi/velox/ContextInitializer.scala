@@ -19,9 +19,10 @@ package io.glutenproject.backendsapi.velox
 import io.glutenproject.GlutenConfig
 import io.glutenproject.backendsapi.ContextApi
 import io.glutenproject.utils._
-import io.glutenproject.vectorized.{JniLibLoader, JniWorkspace}
+import io.glutenproject.vectorized.{JniLibLoader, JniWorkspace, PlanCacheJniWrapper}
 import io.glutenproject.expression.UDFMappings
 import io.glutenproject.init.JniTaskContext
+import com.codahale.metrics.{Gauge, MetricRegistry}
 import org.apache.commons.lang3.StringUtils
 import org.apache.spark.SparkConf
 import org.apache.spark.util.TaskResource
@@ -81,6 +82,15 @@ class ContextInitializer extends ContextApi {
     loader.mapAndLoad(GlutenConfig.GLUTEN_VELOX_BACKEND, true)
   }
 
+  override def registerMetrics(registry: MetricRegistry): Unit = {
+    registry.register("planCache.hits", new Gauge[Long] {
+      override def getValue: Long = PlanCacheJniWrapper.hits()
+    })
+    registry.register("planCache.misses", new Gauge[Long] {
+      override def getValue: Long = PlanCacheJniWrapper.misses()
+    })
+  }
+
   override def shutdown(): Unit = {
     // TODO shutdown implementation in velox to release resources
   }
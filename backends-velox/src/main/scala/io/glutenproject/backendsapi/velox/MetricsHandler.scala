@@ -239,8 +239,14 @@ class MetricsHandler extends MetricsApi with Logging{
       "splitTime" -> SQLMetrics.createNanoTimingMetric(sparkContext, "totaltime to split"),
       "spillTime" -> SQLMetrics.createNanoTimingMetric(sparkContext, "totaltime to spill"),
       "compressTime" -> SQLMetrics.createNanoTimingMetric(sparkContext, "totaltime to compress"),
+      "compressWallTime" -> SQLMetrics
+        .createNanoTimingMetric(sparkContext, "time of the task to compress or wait for it"),
+      "writeWallTime" -> SQLMetrics
+        .createNanoTimingMetric(sparkContext, "time of the task to write or wait for it"),
       "prepareTime" -> SQLMetrics.createNanoTimingMetric(sparkContext, "totaltime to prepare"),
       "decompressTime" -> SQLMetrics.createNanoTimingMetric(sparkContext, "totaltime_decompress"),
+      "consumerWaitTime" -> SQLMetrics
+        .createNanoTimingMetric(sparkContext, "totaltime to wait for shuffle read"),
       "avgReadBatchNumRows" -> SQLMetrics
         .createAverageMetric(sparkContext, "avg read batch num rows"),
       "numInputRows" -> SQLMetrics.createMetric(sparkContext, "number of input rows"),
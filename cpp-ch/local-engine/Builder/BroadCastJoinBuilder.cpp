@@ -1,4 +1,5 @@
 #include "BroadCastJoinBuilder.h"
+#include <Builder/BroadcastJoinCache.h>
 #include <jni.h>
 #include <Parser/SerializedPlanParser.h>
 #include <Parser/TypeParser.h>
@@ -25,6 +26,12 @@ namespace BroadCastJoinBuilder
 {
     static jclass Java_CHBroadcastBuildSideCache = nullptr;
     static jmethodID Java_get = nullptr;
+
+    static BroadcastJoinCache<StorageJoinFromReadBuffer> & joinCache()
+    {
+        static BroadcastJoinCache<StorageJoinFromReadBuffer> cache;
+        return cache;
+    }
     jlong callJavaGet(const std::string & id)
     {
         GET_JNIENV(env)
@@ -44,6 +51,7 @@ namespace BroadCastJoinBuilder
         DB::JoinKind kind;
         DB::JoinStrictness strictness;
         DB::ColumnsDescription columns;
+        size_t build_threads;
     };
 
     std::shared_ptr<StorageJoinFromReadBuffer> buildInBackground(
@@ -56,7 +64,9 @@ namespace BroadCastJoinBuilder
         const DB::ColumnsDescription & columns_)
     {
         std::shared_ptr<StorageJoinFromReadBuffer> result;
-        StorageJoinContext context{key, input, io_buffer_size, key_names_, kind_, strictness_, columns_};
+        /// Threads building one hash table, each fills a partition of it, see PartitionedHashJoin.
+        size_t build_threads = SerializedPlanParser::global_context->getConfigRef().getUInt64("broadcast_join_build_threads", 1);
+        StorageJoinContext context{key, input, io_buffer_size, key_names_, kind_, strictness_, columns_, build_threads};
         // use another thread, exclude broadcast memory allocation from current memory tracker
         auto func = [&context, &result]() -> void
         {
@@ -72,7 +82,8 @@ namespace BroadCastJoinBuilder
                     context.columns,
                     ConstraintsDescription(),
                     context.key,
-                    true);
+                    true,
+                    context.build_threads);
                 LOG_DEBUG(&Poco::Logger::get("BroadCastJoinBuilder"), "Create broadcast storage join {}.", context.key);
             }
             catch (DB::Exception & e)
@@ -97,6 +108,9 @@ namespace BroadCastJoinBuilder
 
     std::shared_ptr<StorageJoinFromReadBuffer> getJoin(const std::string & key)
     {
+        if (auto join = joinCache().get(key))
+            return join;
+
         jlong result = callJavaGet(key);
 
         if (unlikely(result == 0))
@@ -110,7 +124,7 @@ namespace BroadCastJoinBuilder
             throw Exception(ErrorCodes::LOGICAL_ERROR, "broadcast table {} not found, cache value is invalidated.", key);
         }
 
-        return wrapper;
+        return joinCache().put(key, wrapper);
     }
 
     std::shared_ptr<StorageJoinFromReadBuffer> buildJoin(
@@ -159,7 +173,9 @@ namespace BroadCastJoinBuilder
 
         Block header = TypeParser::buildBlockFromNamedStruct(*substrait_struct);
         ColumnsDescription columns_description(header.getNamesAndTypesList());
-        return buildInBackground(key, input, io_buffer_size, key_names, kind, strictness, columns_description);
+        /// The input isn't read if a task of this executor still holds the join of key.
+        return joinCache().getOrBuild(
+            key, [&] { return buildInBackground(key, input, io_buffer_size, key_names, kind, strictness, columns_description); });
     }
 
     void init(JNIEnv * env)
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <base/types.h>
+
+namespace local_engine
+{
+/// Built broadcast joins of the process keyed by broadcast hash table id, so that the tasks of an executor share one
+/// build and look it up without a JNI call. The entries are weak, CHBroadcastBuildSideCache on the JVM side owns the
+/// joins and decides when they are released. A join that is still used by a running task after the JVM cache dropped
+/// it is found here and reused instead of being built again.
+template <typename Join>
+class BroadcastJoinCache
+{
+public:
+    using JoinPtr = std::shared_ptr<Join>;
+
+    /// Returns the live join of key, or nullptr.
+    JoinPtr get(const String & key)
+    {
+        std::lock_guard lock(mutex);
+        if (auto it = joins.find(key); it != joins.end())
+        {
+            if (auto join = it->second.lock())
+            {
+                ++hits;
+                return join;
+            }
+            joins.erase(it);
+        }
+        ++misses;
+        return nullptr;
+    }
+
+    /// Registers a join built or found elsewhere, a live join already cached for key is kept and returned instead.
+    JoinPtr put(const String & key, JoinPtr join)
+    {
+        if (!join)
+            return join;
+        std::lock_guard lock(mutex);
+        auto & entry = joins[key];
+        if (auto cached = entry.lock())
+            return cached;
+        entry = join;
+        removeExpired();
+        return join;
+    }
+
+    /// Returns the live join of key, or the one returned by build(). Concurrent misses of one key may build it more
+    /// than once, the first registered build wins and the others are dropped.
+    template <typename Build>
+    JoinPtr getOrBuild(const String & key, Build && build)
+    {
+        if (auto join = get(key))
+            return join;
+        return put(key, build());
+    }
+
+    size_t getHits() const { return hits; }
+    size_t getMisses() const { return misses; }
+
+private:
+    void removeExpired()
+    {
+        for (auto it = joins.begin(); it != joins.end();)
+        {
+            if (it->second.expired())
+                it = joins.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    std::mutex mutex;
+    std::unordered_map<String, std::weak_ptr<Join>> joins;
+    std::atomic<size_t> hits = 0;
+    std::atomic<size_t> misses = 0;
+};
+}
@@ -1,11 +1,151 @@
 #include "SparkFunctionGetJsonObject.h"
+#include <Columns/ColumnConst.h>
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnTuple.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypeTuple.h>
 #include <Functions/FunctionFactory.h>
+#include <Functions/FunctionHelpers.h>
+#include <Functions/IFunction.h>
+#include <Functions/JSONPath/Parsers/ParserJSONPath.h>
+#include <Interpreters/Context.h>
+#include <Parsers/TokenIterator.h>
+#include "config.h"
 
+namespace DB
+{
+namespace ErrorCodes
+{
+    extern const int BAD_ARGUMENTS;
+    extern const int ILLEGAL_COLUMN;
+    extern const int ILLEGAL_TYPE_OF_ARGUMENT;
+    extern const int NUMBER_OF_ARGUMENTS_DOESNT_MATCH;
+}
+}
 
 namespace local_engine
 {
+namespace
+{
+    class FunctionGetJsonObjectMulti : public DB::IFunction, DB::WithConstContext
+    {
+    public:
+        static constexpr auto name = GetJsonObjectMulti::name;
+
+        static DB::FunctionPtr create(DB::ContextPtr context_) { return std::make_shared<FunctionGetJsonObjectMulti>(context_); }
+
+        explicit FunctionGetJsonObjectMulti(DB::ContextPtr context_) : WithConstContext(context_) { }
+
+        String getName() const override { return name; }
+
+        bool isVariadic() const override { return true; }
+
+        size_t getNumberOfArguments() const override { return 0; }
+
+        bool isSuitableForShortCircuitArgumentsExecution(const DB::DataTypesWithConstInfo & /*arguments*/) const override { return true; }
+
+        /// A null document gives null for every path, a Tuple can't be made Nullable.
+        bool useDefaultImplementationForNulls() const override { return false; }
+
+        DB::DataTypePtr getReturnTypeImpl(const DB::DataTypes & arguments) const override
+        {
+            if (arguments.size() < 2)
+                throw DB::Exception(
+                    DB::ErrorCodes::NUMBER_OF_ARGUMENTS_DOESNT_MATCH,
+                    "Function {} requires at least 2 arguments, passed {}",
+                    getName(),
+                    arguments.size());
+
+            for (const auto & argument : arguments)
+            {
+                if (!isString(DB::removeNullable(argument)))
+                    throw DB::Exception(
+                        DB::ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT,
+                        "Illegal type {} of argument of function {}, should be String",
+                        argument->getName(),
+                        getName());
+            }
+
+            auto element_type = std::make_shared<DB::DataTypeNullable>(std::make_shared<DB::DataTypeString>());
+            return std::make_shared<DB::DataTypeTuple>(DB::DataTypes(arguments.size() - 1, element_type));
+        }
+
+        DB::ColumnPtr executeImpl(
+            const DB::ColumnsWithTypeAndName & arguments, const DB::DataTypePtr & result_type, size_t input_rows_count) const override
+        {
+#if USE_SIMDJSON
+            if (getContext()->getSettingsRef().allow_simdjson)
+                return execute<DB::SimdJSONParser>(arguments, result_type, input_rows_count);
+#endif
+            return execute<DB::DummyJSONParser>(arguments, result_type, input_rows_count);
+        }
+
+    private:
+        DB::ASTPtr parsePath(const DB::ColumnWithTypeAndName & argument) const
+        {
+            const auto * path_const = typeid_cast<const DB::ColumnConst *>(argument.column.get());
+            if (!path_const)
+                throw DB::Exception(DB::ErrorCodes::ILLEGAL_COLUMN, "The paths of function {} must be constant strings", getName());
+
+            auto path = path_const->getDataAt(0);
+            DB::Tokens tokens(path.data, path.data + path.size);
+            DB::IParser::Pos token_iterator(tokens, static_cast<uint32_t>(getContext()->getSettingsRef().max_parser_depth));
+            DB::Expected expected;
+            DB::ASTPtr res;
+            DB::ParserJSONPath parser;
+            if (!parser.parse(token_iterator, res, expected))
+                throw DB::Exception(DB::ErrorCodes::BAD_ARGUMENTS, "Unable to parse JSONPath {}", path.toView());
+            return res;
+        }
+
+        template <typename JSONParser>
+        DB::ColumnPtr
+        execute(const DB::ColumnsWithTypeAndName & arguments, const DB::DataTypePtr & result_type, size_t input_rows_count) const
+        {
+            size_t paths = arguments.size() - 1;
+            std::vector<DB::ASTPtr> path_asts;
+            std::vector<GetJsonObjectImpl<JSONParser>> impls(paths);
+            for (size_t i = 0; i < paths; ++i)
+                path_asts.emplace_back(parsePath(arguments[i + 1]));
+
+            const auto & tuple_type = assert_cast<const DB::DataTypeTuple &>(*result_type);
+            DB::MutableColumns results;
+            for (const auto & element_type : tuple_type.getElements())
+            {
+                results.emplace_back(element_type->createColumn());
+                results.back()->reserve(input_rows_count);
+            }
+
+            auto json_column = arguments[0].column->convertToFullColumnIfConst();
+            const DB::NullMap * null_map = nullptr;
+            if (const auto * nullable = DB::checkAndGetColumn<DB::ColumnNullable>(*json_column))
+            {
+                null_map = &nullable->getNullMapData();
+                json_column = nullable->getNestedColumnPtr();
+            }
+            const auto & json_strings = assert_cast<const DB::ColumnString &>(*json_column);
+
+            JSONParser json_parser;
+            typename JSONParser::Element document;
+            auto context = getContext();
+            for (size_t row = 0; row < input_rows_count; ++row)
+            {
+                bool document_ok = !(null_map && (*null_map)[row]);
+                document_ok = document_ok && json_parser.parse(json_strings.getDataAt(row).toView(), document);
+                for (size_t i = 0; i < paths; ++i)
+                {
+                    if (!document_ok || !impls[i].insertResultToColumn(*results[i], document, path_asts[i], context))
+                        results[i]->insertDefault();
+                }
+            }
+            return DB::ColumnTuple::create(std::move(results));
+        }
+    };
+}
+
 REGISTER_FUNCTION(GetJsonObject)
 {
     factory.registerFunction<DB::FunctionSQLJSON<GetJsonObject, GetJsonObjectImpl>>();
+    factory.registerFunction<FunctionGetJsonObjectMulti>();
 }
 }
@@ -30,6 +30,14 @@ struct GetJsonObject
     static constexpr auto name{"get_json_object"};
 };
 
+/// get_json_object_multi(json, path_1, ..., path_n) returns a Tuple(Nullable(String), ...) whose i-th element is
+/// get_json_object(json, path_i). Each document is parsed once for all the paths, the plan parser uses it for the
+/// get_json_object calls of a projection that share their json argument.
+struct GetJsonObjectMulti
+{
+    static constexpr auto name{"get_json_object_multi"};
+};
+
 template <typename JSONParser>
 class GetJsonObjectImpl
 {
@@ -53,7 +61,8 @@ public:
         DB::GeneratorJSONPath<JSONParser> generator_json_path(query_ptr);
         Element current_element = root;
         DB::VisitorStatus status;
-        std::stringstream out; // STYLE_CHECK_ALLOW_STD_STRING_STREAM
+        out.str({});
+        out.clear();
         /// Create json array of results: [res1, res2, ...]
         bool success = false;
         size_t element_count = 0;
@@ -106,6 +115,8 @@ public:
     }
 private:
     UInt8 has_array_wildcard_flag = 0;
+    /// Reused by the rows, creating a stream per row costs more than the lookup.
+    std::stringstream out; // STYLE_CHECK_ALLOW_STD_STRING_STREAM
 
     void setupArrayWildcardFlag(DB::ASTPtr & query_ptr)
     {
@@ -6,9 +6,9 @@
 #include <Functions/FunctionFactory.h>
 #include <Functions/FunctionHelpers.h>
 #include <Functions/IFunction.h>
-#include <Functions/Regexps.h>
 #include <Interpreters/Context.h>
 #include <Common/FunctionDocumentation.h>
+#include "SparkRegexpCache.h"
 
 namespace DB
 {
@@ -94,10 +94,11 @@ namespace
             ColumnString::Chars & res_strings_chars = res_strings.getChars();
             ColumnString::Offsets & res_strings_offsets = res_strings.getOffsets();
 
+            auto regexp = cached_regexp.get(col_pattern->getValue<String>());
             if (col_const)
                 constantVector(
                     col_const->getValue<String>(),
-                    col_pattern->getValue<String>(),
+                    *regexp,
                     column_index,
                     res_offsets,
                     res_strings_chars,
@@ -109,7 +110,7 @@ namespace
                 vectorConstant(
                     col->getChars(),
                     col->getOffsets(),
-                    col_pattern->getValue<String>(),
+                    *regexp,
                     index,
                     res_offsets,
                     res_strings_chars,
@@ -119,7 +120,7 @@ namespace
                 vectorVector(
                     col->getChars(),
                     col->getOffsets(),
-                    col_pattern->getValue<String>(),
+                    *regexp,
                     column_index,
                     res_offsets,
                     res_strings_chars,
@@ -129,10 +130,13 @@ namespace
         }
 
     private:
+        /// Same flags as Regexps::createRegexp<false, false, false>.
+        CachedRegexp cached_regexp{OptimizedRegularExpression::RE_DOT_NL};
+
         static void saveMatchs(
             Pos start,
             Pos end,
-            const Regexps::Regexp & regexp,
+            const OptimizedRegularExpression & regexp,
             OptimizedRegularExpression::MatchVec & matches,
             size_t match_index,
             ColumnArray::Offsets & res_offsets,
@@ -177,13 +181,12 @@ namespace
         static void vectorConstant(
             const ColumnString::Chars & data,
             const ColumnString::Offsets & offsets,
-            const std::string & pattern,
+            const OptimizedRegularExpression & regexp,
             ssize_t index,
             ColumnArray::Offsets & res_offsets,
             ColumnString::Chars & res_strings_chars,
             ColumnString::Offsets & res_strings_offsets)
         {
-            const Regexps::Regexp regexp = Regexps::createRegexp<false, false, false>(pattern);
             unsigned capture = regexp.getNumberOfSubpatterns();
             if (index < 0 || index >= capture + 1)
                 throw Exception(
@@ -225,13 +228,12 @@ namespace
         static void vectorVector(
             const ColumnString::Chars & data,
             const ColumnString::Offsets & offsets,
-            const std::string & pattern,
+            const OptimizedRegularExpression & regexp,
             const ColumnPtr & column_index,
             ColumnArray::Offsets & res_offsets,
             ColumnString::Chars & res_strings_chars,
             ColumnString::Offsets & res_strings_offsets)
         {
-            const Regexps::Regexp regexp = Regexps::createRegexp<false, false, false>(pattern);
             unsigned capture = regexp.getNumberOfSubpatterns();
 
             OptimizedRegularExpression::MatchVec matches;
@@ -275,13 +277,12 @@ namespace
 
         static void constantVector(
             const std::string & str,
-            const std::string & pattern,
+            const OptimizedRegularExpression & regexp,
             const ColumnPtr & column_index,
             ColumnArray::Offsets & res_offsets,
             ColumnString::Chars & res_strings_chars,
             ColumnString::Offsets & res_strings_offsets)
         {
-            const Regexps::Regexp regexp = Regexps::createRegexp<false, false, false>(pattern);
             unsigned capture = regexp.getNumberOfSubpatterns();
 
             /// Copy data into padded array to be able to use memcpySmallAllowReadWriteOverflow15.
@@ -0,0 +1,40 @@
+#include "SparkRegexpCache.h"
+
+namespace local_engine
+{
+SparkRegexpCache & SparkRegexpCache::instance()
+{
+    static SparkRegexpCache cache;
+    return cache;
+}
+
+SparkRegexpCache::RegexpPtr SparkRegexpCache::get(const String & pattern, int options)
+{
+    auto key = std::to_string(options) + ":" + pattern;
+    {
+        std::lock_guard lock(mutex);
+        if (auto it = regexps.find(key); it != regexps.end())
+            return it->second;
+    }
+
+    /// Compiled without the lock, a pattern compiled twice by concurrent queries is only wasted work.
+    auto regexp = std::make_shared<const OptimizedRegularExpression>(pattern, options);
+
+    std::lock_guard lock(mutex);
+    /// Queries use few distinct patterns, dropping all of them once in a while is enough to bound the cache.
+    if (regexps.size() >= max_entries)
+        regexps.clear();
+    return regexps.try_emplace(key, std::move(regexp)).first->second;
+}
+
+SparkRegexpCache::RegexpPtr CachedRegexp::get(const String & pattern_) const
+{
+    std::lock_guard lock(mutex);
+    if (!regexp || pattern != pattern_)
+    {
+        regexp = SparkRegexpCache::instance().get(pattern_, options);
+        pattern = pattern_;
+    }
+    return regexp;
+}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <base/types.h>
+#include <Common/OptimizedRegularExpression.h>
+
+namespace local_engine
+{
+/// Compiled regexps shared by the regexp functions of all the queries of the process, so that a pattern is compiled once
+/// instead of for every block. An OptimizedRegularExpression may be matched by several threads at the same time.
+class SparkRegexpCache
+{
+public:
+    using RegexpPtr = std::shared_ptr<const OptimizedRegularExpression>;
+
+    static SparkRegexpCache & instance();
+
+    /// options are the OptimizedRegularExpression::RE_* flags to compile pattern with.
+    RegexpPtr get(const String & pattern, int options);
+
+private:
+    static constexpr size_t max_entries = 1024;
+
+    std::mutex mutex;
+    std::unordered_map<String, RegexpPtr> regexps;
+};
+
+/// The regexp of a function whose pattern is a constant, looked up in SparkRegexpCache only when the pattern changes.
+class CachedRegexp
+{
+public:
+    explicit CachedRegexp(int options_) : options(options_) { }
+
+    SparkRegexpCache::RegexpPtr get(const String & pattern_) const;
+
+private:
+    const int options;
+    mutable std::mutex mutex;
+    mutable String pattern;
+    mutable SparkRegexpCache::RegexpPtr regexp;
+};
+}
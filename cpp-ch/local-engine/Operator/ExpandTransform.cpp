@@ -37,7 +37,8 @@ ExpandTransform::Status ExpandTransform::prepare()
 
     if (has_output)
     {
-        output.push(nextChunk());
+        output.push(std::move(output_chunk));
+        has_output = false;
         return Status::PortFull;
     }
 
@@ -59,77 +60,88 @@ ExpandTransform::Status ExpandTransform::prepare()
     }
     input_chunk = input.pull();
     has_input = true;
+    next_expand_index = 0;
     return Status::Ready;
 }
 
 void ExpandTransform::work()
 {
-    assert(expanded_chunks.empty());
     const auto & original_cols = input_chunk.getColumns();
     size_t rows = input_chunk.getNumRows();
+    if (!not_null_map || rows != literal_rows)
+        buildLiteralColumns(rows);
 
-    for (size_t i = 0; i < project_set_exprs.getExpandRows(); ++i)
+    size_t i = next_expand_index++;
+    DB::Columns cols;
+    cols.reserve(project_set_exprs.getExpandCols());
+    for (size_t j = 0; j < project_set_exprs.getExpandCols(); ++j)
     {
-        DB::Columns cols;
-        for (size_t j = 0; j < project_set_exprs.getExpandCols(); ++j)
-        {
-            const auto & type = project_set_exprs.getTypes()[j];
-            const auto & kind = project_set_exprs.getKinds()[i][j];
-            const auto & field = project_set_exprs.getFields()[i][j];
+        const auto & type = project_set_exprs.getTypes()[j];
+        const auto & kind = project_set_exprs.getKinds()[i][j];
+        const auto & field = project_set_exprs.getFields()[i][j];
 
-            if (kind == EXPAND_FIELD_KIND_SELECTION)
+        if (kind == EXPAND_FIELD_KIND_SELECTION)
+        {
+            const auto & original_col = original_cols[field.get<Int32>()];
+            if (type->isNullable() == original_col->isNullable())
+            {
+                cols.push_back(original_col);
+            }
+            else if (type->isNullable() && !original_col->isNullable())
             {
-                const auto & original_col = original_cols[field.get<Int32>()];
-                if (type->isNullable() == original_col->isNullable())
-                {
-                    cols.push_back(original_col);
-                }
-                else if (type->isNullable() && !original_col->isNullable())
-                {
-                    auto null_map = DB::ColumnUInt8::create(rows, 0);
-                    auto col = DB::ColumnNullable::create(original_col, std::move(null_map));
-                    cols.push_back(std::move(col));
-                }
-                else
-                {
-                    throw DB::Exception(
-                        DB::ErrorCodes::LOGICAL_ERROR,
-                        "Miss match nullable, column {} is nullable, but type {} is not nullable",
-                        original_col->getName(),
-                        type->getName());
-                }
+                cols.push_back(DB::ColumnNullable::create(original_col, not_null_map));
             }
             else
             {
-                if (field.isNull())
-                {
-                    // Add null column
-                    auto null_map = DB::ColumnUInt8::create(rows, 1);
-                    auto nested_type = DB::removeNullable(type);
-                    auto col = DB::ColumnNullable::create(nested_type->createColumn()->cloneResized(rows), std::move(null_map));
-                    cols.push_back(std::move(col));
-                }
-                else
-                {
-                    // Add constant column: gid, gpos, etc.
-                    auto col = type->createColumnConst(rows, field);
-                    cols.push_back(col->convertToFullColumnIfConst());
-                }
+                throw DB::Exception(
+                    DB::ErrorCodes::LOGICAL_ERROR,
+                    "Miss match nullable, column {} is nullable, but type {} is not nullable",
+                    original_col->getName(),
+                    type->getName());
             }
         }
-        expanded_chunks.push_back(DB::Chunk(cols, rows));
+        else
+        {
+            cols.push_back(literal_columns[i][j]);
+        }
     }
+    output_chunk = DB::Chunk(std::move(cols), rows);
     has_output = true;
-    has_input = false;
+
+    if (next_expand_index == project_set_exprs.getExpandRows())
+    {
+        has_input = false;
+        input_chunk.clear();
+    }
 }
 
-DB::Chunk ExpandTransform::nextChunk()
+void ExpandTransform::buildLiteralColumns(size_t rows)
 {
-    assert(!expanded_chunks.empty());
-    DB::Chunk ret;
-    ret.swap(expanded_chunks.front());
-    expanded_chunks.pop_front();
-    has_output = !expanded_chunks.empty();
-    return ret;
+    literal_rows = rows;
+    not_null_map = DB::ColumnUInt8::create(rows, 0);
+    literal_columns.assign(project_set_exprs.getExpandRows(), DB::Columns(project_set_exprs.getExpandCols()));
+    for (size_t i = 0; i < project_set_exprs.getExpandRows(); ++i)
+    {
+        for (size_t j = 0; j < project_set_exprs.getExpandCols(); ++j)
+        {
+            if (project_set_exprs.getKinds()[i][j] == EXPAND_FIELD_KIND_SELECTION)
+                continue;
+
+            const auto & type = project_set_exprs.getTypes()[j];
+            const auto & field = project_set_exprs.getFields()[i][j];
+            if (field.isNull())
+            {
+                // Add null column
+                auto null_map = DB::ColumnUInt8::create(rows, 1);
+                auto nested_type = DB::removeNullable(type);
+                literal_columns[i][j] = DB::ColumnNullable::create(nested_type->createColumn()->cloneResized(rows), std::move(null_map));
+            }
+            else
+            {
+                // Add constant column: gid, gpos, etc.
+                literal_columns[i][j] = type->createColumnConst(rows, field)->convertToFullColumnIfConst();
+            }
+        }
+    }
 }
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <set>
 #include <vector>
+#include <Columns/IColumn.h>
 #include <Core/Block.h>
 #include <Parser/ExpandField.h>
 #include <Processors/Chunk.h>
@@ -31,8 +32,16 @@ private:
     bool has_input = false;
     bool has_output = false;
 
+    /// The projections of input_chunk are built one at a time, each shares the columns of input_chunk.
     DB::Chunk input_chunk;
-    std::list<DB::Chunk> expanded_chunks;
-    DB::Chunk nextChunk();
+    size_t next_expand_index = 0;
+    DB::Chunk output_chunk;
+
+    /// The columns of the literals and the null map of the nullable selections don't depend on the input, they are
+    /// built once for literal_rows rows and shared by all the output chunks of that size.
+    size_t literal_rows = 0;
+    std::vector<DB::Columns> literal_columns;
+    DB::ColumnPtr not_null_map;
+    void buildLiteralColumns(size_t rows);
 };
 }
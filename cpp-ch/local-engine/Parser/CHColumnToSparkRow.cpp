@@ -15,6 +15,7 @@
 #include <DataTypes/DataTypeTuple.h>
 #include <DataTypes/DataTypesDecimal.h>
 #include <DataTypes/ObjectUtils.h>
+#include <base/unaligned.h>
 #include <Common/Exception.h>
 
 namespace DB
@@ -67,9 +68,107 @@ ALWAYS_INLINE bool isBitSet(const char * bitmap, size_t index)
     return word & mask;
 }
 
+/// Writes the values of a fixed and contiguous column to the field of each row, T has the size of the values.
+template <typename T>
+static void writeFixedLengthValues(
+    char * buffer_address,
+    int64_t field_offset,
+    const IColumn & column,
+    const NullMap * null_map,
+    int32_t col_index,
+    int64_t num_rows,
+    const std::vector<int64_t> & offsets)
+{
+    const T * data = reinterpret_cast<const T *>(column.getDataAt(0).data);
+    if (!null_map)
+    {
+        for (size_t i = 0; i < static_cast<size_t>(num_rows); i++)
+            unalignedStore<T>(buffer_address + offsets[i] + field_offset, data[i]);
+        return;
+    }
+
+    for (size_t i = 0; i < static_cast<size_t>(num_rows); i++)
+    {
+        if ((*null_map)[i])
+            bitSet(buffer_address + offsets[i], col_index);
+        else
+            unalignedStore<T>(buffer_address + offsets[i] + field_offset, data[i]);
+    }
+}
+
+/// Returns false if the values of column aren't stored in a single array of a native width.
+static bool tryWriteFixedLengthValues(
+    char * buffer_address,
+    int64_t field_offset,
+    const IColumn & column,
+    const NullMap * null_map,
+    int32_t col_index,
+    int64_t num_rows,
+    const std::vector<int64_t> & offsets)
+{
+    if (!num_rows || !column.isFixedAndContiguous())
+        return !num_rows;
+
+    switch (column.sizeOfValueIfFixed())
+    {
+        case 1:
+            writeFixedLengthValues<UInt8>(buffer_address, field_offset, column, null_map, col_index, num_rows, offsets);
+            return true;
+        case 2:
+            writeFixedLengthValues<UInt16>(buffer_address, field_offset, column, null_map, col_index, num_rows, offsets);
+            return true;
+        case 4:
+            writeFixedLengthValues<UInt32>(buffer_address, field_offset, column, null_map, col_index, num_rows, offsets);
+            return true;
+        case 8:
+            writeFixedLengthValues<UInt64>(buffer_address, field_offset, column, null_map, col_index, num_rows, offsets);
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// Writes the strings of column to the backing data of each row, returns false if column isn't a ColumnString.
+static bool tryWriteStringValues(
+    char * buffer_address,
+    int64_t field_offset,
+    const IColumn & column,
+    const NullMap * null_map,
+    int32_t col_index,
+    int64_t num_rows,
+    const std::vector<int64_t> & offsets,
+    std::vector<int64_t> & buffer_cursor)
+{
+    const auto * string_column = checkAndGetColumn<ColumnString>(&column);
+    if (!string_column)
+        return false;
+
+    const auto & chars = string_column->getChars();
+    const auto & string_offsets = string_column->getOffsets();
+    for (size_t i = 0; i < static_cast<size_t>(num_rows); i++)
+    {
+        char * row = buffer_address + offsets[i];
+        if (null_map && (*null_map)[i])
+        {
+            bitSet(row, col_index);
+            continue;
+        }
+
+        size_t start = string_offsets[i - 1];
+        size_t size = string_offsets[i] - start - 1;
+        memcpy(row + buffer_cursor[i], &chars[start], size);
+        unalignedStore<int64_t>(row + field_offset, BackingDataLengthCalculator::getOffsetAndSize(buffer_cursor[i], size));
+        buffer_cursor[i] += roundNumberOfBytesToNearestWord(size);
+    }
+    return true;
+}
+
 static void writeFixedLengthNonNullableValue(
     char * buffer_address, int64_t field_offset, const ColumnWithTypeAndName & col, int64_t num_rows, const std::vector<int64_t> & offsets)
 {
+    if (tryWriteFixedLengthValues(buffer_address, field_offset, *col.column, nullptr, 0, num_rows, offsets))
+        return;
+
     FixedLengthDataWriter writer(col.type);
     for (size_t i = 0; i < static_cast<size_t>(num_rows); i++)
         writer.unsafeWrite(col.column->getDataAt(i), buffer_address + offsets[i] + field_offset);
@@ -86,6 +185,9 @@ static void writeFixedLengthNullableValue(
     const auto * nullable_column = checkAndGetColumn<ColumnNullable>(*col.column);
     const auto & null_map = nullable_column->getNullMapData();
     const auto & nested_column = nullable_column->getNestedColumn();
+    if (tryWriteFixedLengthValues(buffer_address, field_offset, nested_column, &null_map, col_index, num_rows, offsets))
+        return;
+
     FixedLengthDataWriter writer(col.type);
     for (size_t i = 0; i < static_cast<size_t>(num_rows); i++)
     {
@@ -107,6 +209,9 @@ static void writeVariableLengthNonNullableValue(
     const auto type_without_nullable{removeNullable(col.type)};
     const bool use_raw_data = BackingDataLengthCalculator::isDataTypeSupportRawData(type_without_nullable);
     const bool big_endian = BackingDataLengthCalculator::isBigEndianInSparkRow(type_without_nullable);
+    if (tryWriteStringValues(buffer_address, field_offset, *col.column, nullptr, 0, num_rows, offsets, buffer_cursor))
+        return;
+
     VariableLengthDataWriter writer(col.type, buffer_address, offsets, buffer_cursor);
     if (use_raw_data)
     {
@@ -121,11 +226,11 @@ static void writeVariableLengthNonNullableValue(
         }
         else
         {
-            Field field;
+            String buf;
             for (size_t i = 0; i < static_cast<size_t>(num_rows); i++)
             {
                 StringRef str_view = col.column->getDataAt(i);
-                String buf(str_view.data, str_view.size);
+                buf.assign(str_view.data, str_view.size);
                 BackingDataLengthCalculator::swapDecimalEndianBytes(buf);
                 int64_t offset_and_size = writer.writeUnalignedBytes(i, buf.data(), buf.size(), 0);
                 memcpy(buffer_address + offsets[i] + field_offset, &offset_and_size, 8);
@@ -159,9 +264,13 @@ static void writeVariableLengthNullableValue(
     const auto type_without_nullable{removeNullable(col.type)};
     const bool use_raw_data = BackingDataLengthCalculator::isDataTypeSupportRawData(type_without_nullable);
     const bool big_endian = BackingDataLengthCalculator::isBigEndianInSparkRow(type_without_nullable);
+    if (tryWriteStringValues(buffer_address, field_offset, nested_column, &null_map, col_index, num_rows, offsets, buffer_cursor))
+        return;
+
     VariableLengthDataWriter writer(col.type, buffer_address, offsets, buffer_cursor);
     if (use_raw_data)
     {
+        String buf;
         for (size_t i = 0; i < static_cast<size_t>(num_rows); i++)
         {
             if (null_map[i])
@@ -174,10 +283,8 @@ static void writeVariableLengthNullableValue(
             }
             else
             {
-                Field field;
-                nested_column.get(i, field);
                 StringRef str_view = nested_column.getDataAt(i);
-                String buf(str_view.data, str_view.size);
+                buf.assign(str_view.data, str_view.size);
                 BackingDataLengthCalculator::swapDecimalEndianBytes(buf);
                 int64_t offset_and_size = writer.writeUnalignedBytes(i, buf.data(), buf.size(), 0);
                 memcpy(buffer_address + offsets[i] + field_offset, &offset_and_size, 8);
@@ -262,19 +369,27 @@ SparkRowInfo::SparkRowInfo(
             if (BackingDataLengthCalculator::isDataTypeSupportRawData(type_without_nullable))
             {
                 auto column = col.column->convertToFullColumnIfConst();
-                const auto * nullable_column = checkAndGetColumn<ColumnNullable>(*column);
-                if (nullable_column)
+                const IColumn * nested_column = column.get();
+                const NullMap * null_map = nullptr;
+                if (const auto * nullable_column = checkAndGetColumn<ColumnNullable>(*column))
+                {
+                    nested_column = &nullable_column->getNestedColumn();
+                    null_map = &nullable_column->getNullMapData();
+                }
+
+                if (const auto * string_column = checkAndGetColumn<ColumnString>(nested_column))
                 {
-                    const auto & nested_column = nullable_column->getNestedColumn();
-                    const auto & null_map = nullable_column->getNullMapData();
+                    /// The string sizes come from the offsets, without going through the column for each row.
+                    const auto & string_offsets = string_column->getOffsets();
                     for (auto row_idx = 0; row_idx < num_rows; ++row_idx)
-                        if (!null_map[row_idx])
-                            lengths[row_idx] += roundNumberOfBytesToNearestWord(nested_column.getDataAt(row_idx).size);
+                        if (!null_map || !(*null_map)[row_idx])
+                            lengths[row_idx] += roundNumberOfBytesToNearestWord(string_offsets[row_idx] - string_offsets[row_idx - 1] - 1);
                 }
                 else
                 {
                     for (auto row_idx = 0; row_idx < num_rows; ++row_idx)
-                        lengths[row_idx] += roundNumberOfBytesToNearestWord(col.column->getDataAt(row_idx).size);
+                        if (!null_map || !(*null_map)[row_idx])
+                            lengths[row_idx] += roundNumberOfBytesToNearestWord(nested_column->getDataAt(row_idx).size);
                 }
             }
             else
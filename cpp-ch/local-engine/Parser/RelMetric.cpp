@@ -1,6 +1,7 @@
 #include <Processors/IProcessor.h>
 #include "RelMetric.h"
 #include <Processors/QueryPlan/AggregatingStep.h>
+#include <Storages/SubstraitSource/SubstraitFileSource.h>
 
 using namespace rapidjson;
 
@@ -89,6 +90,18 @@ void RelMetric::serialize(Writer<StringBuffer> & writer, bool) const
                 writer.Uint64(processor->getProcessorDataStats().input_rows);
                 writer.Key("input_bytes");
                 writer.Uint64(processor->getProcessorDataStats().input_bytes);
+                if (const auto * file_source = dynamic_cast<const SubstraitFileSource *>(processor.get()))
+                {
+                    const auto & read_stats = file_source->getReadStats();
+                    writer.Key("total_row_groups");
+                    writer.Uint64(read_stats.total_row_groups);
+                    writer.Key("skipped_row_groups");
+                    writer.Uint64(read_stats.skipped_row_groups);
+                    writer.Key("metadata_cache_hits");
+                    writer.Uint64(read_stats.metadata_cache_hits);
+                    writer.Key("metadata_cache_misses");
+                    writer.Uint64(read_stats.metadata_cache_misses);
+                }
                 writer.EndObject();
             }
             writer.EndArray();
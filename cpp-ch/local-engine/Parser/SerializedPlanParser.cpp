@@ -34,6 +34,7 @@
 #include <Interpreters/ActionsDAG.h>
 #include <Interpreters/ActionsVisitor.h>
 #include <Interpreters/CollectJoinOnKeysVisitor.h>
+#include <Interpreters/ExpressionActions.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/HashJoin.h>
 #include <Interpreters/ProcessList.h>
@@ -64,10 +65,12 @@
 #include <QueryPipeline/QueryPipelineBuilder.h>
 #include <Storages/CustomStorageMergeTree.h>
 #include <Storages/IStorage.h>
+#include <Storages/MergeTree/KeyCondition.h>
 #include <Storages/MergeTree/MergeTreeData.h>
 #include <Storages/StorageMergeTreeFactory.h>
 #include <Storages/SubstraitSource/SubstraitFileSource.h>
 #include <base/Decimal.h>
+#include <base/scope_guard.h>
 #include <base/types.h>
 #include <google/protobuf/util/json_util.h>
 #include <google/protobuf/wrappers.pb.h>
@@ -135,6 +138,9 @@ std::shared_ptr<DB::ActionsDAG> SerializedPlanParser::expressionsToActionsDAG(
     NamesWithAliases required_columns;
     std::set<String> distinct_columns;
 
+    fuseGetJsonObjects(expressions, actions_dag);
+    SCOPE_EXIT({ fused_get_json_objects.clear(); });
+
     for (const auto & expr : expressions)
     {
         if (expr.has_selection())
@@ -213,6 +219,83 @@ std::shared_ptr<DB::ActionsDAG> SerializedPlanParser::expressionsToActionsDAG(
     return actions_dag;
 }
 
+void SerializedPlanParser::collectGetJsonObjects(
+    const substrait::Expression & expr, std::map<String, std::vector<const substrait::Expression *>> & calls_by_json) const
+{
+    if (expr.has_cast())
+    {
+        collectGetJsonObjects(expr.cast().input(), calls_by_json);
+        return;
+    }
+    if (!expr.has_scalar_function())
+        return;
+
+    const auto & scalar_function = expr.scalar_function();
+    const auto & args = scalar_function.arguments();
+    const auto & function_signature = function_mapping.at(std::to_string(scalar_function.function_reference()));
+    if (startsWith(function_signature, "get_json_object:") && args.size() == 2 && args[1].value().has_literal()
+        && args[1].value().literal().has_string())
+    {
+        calls_by_json[args[0].value().SerializeAsString()].push_back(&expr);
+        return;
+    }
+    for (const auto & arg : args)
+        collectGetJsonObjects(arg.value(), calls_by_json);
+}
+
+void SerializedPlanParser::fuseGetJsonObjects(const std::vector<substrait::Expression> & expressions, ActionsDAGPtr actions_dag)
+{
+    std::map<String, std::vector<const substrait::Expression *>> calls_by_json;
+    for (const auto & expr : expressions)
+    {
+        /// These replace the actions dag, the fused nodes would be left in the old one.
+        if (expr.has_scalar_function())
+        {
+            const auto & function_signature = function_mapping.at(std::to_string(expr.scalar_function().function_reference()));
+            if (startsWith(function_signature, "explode:") || startsWith(function_signature, "posexplode:")
+                || startsWith(function_signature, "json_tuple:"))
+                return;
+        }
+        collectGetJsonObjects(expr, calls_by_json);
+    }
+
+    auto string_type = std::make_shared<DataTypeString>();
+    auto tuple_index_type = std::make_shared<DataTypeUInt32>();
+    auto tuple_element_builder = FunctionFactory::instance().get("tupleElement", context);
+    for (const auto & [_, calls] : calls_by_json)
+    {
+        std::vector<String> paths;
+        std::unordered_map<String, size_t> path_positions;
+        for (const auto * call : calls)
+        {
+            const auto & path = call->scalar_function().arguments(1).value().literal().string();
+            if (path_positions.emplace(path, paths.size()).second)
+                paths.push_back(path);
+        }
+        if (paths.size() < 2)
+            continue;
+
+        ActionsDAG::NodeRawConstPtrs args{parseExpression(actions_dag, calls.front()->scalar_function().arguments(0).value())};
+        for (const auto & path : paths)
+            args.emplace_back(
+                &actions_dag->addColumn(ColumnWithTypeAndName(string_type->createColumnConst(1, path), string_type, getUniqueName(path))));
+        const auto * multi_node = toFunctionNode(actions_dag, "get_json_object_multi", args);
+
+        for (const auto * call : calls)
+        {
+            auto key = call->SerializeAsString();
+            if (fused_get_json_objects.contains(key))
+                continue;
+            UInt32 index = static_cast<UInt32>(path_positions.at(call->scalar_function().arguments(1).value().literal().string()) + 1);
+            auto index_column = tuple_index_type->createColumnConst(1, index);
+            const auto * index_node
+                = &actions_dag->addColumn(ColumnWithTypeAndName(index_column, tuple_index_type, getUniqueName(std::to_string(index))));
+            auto result_name = "tupleElement(" + multi_node->result_name + ", " + index_node->result_name + ")";
+            fused_get_json_objects[key] = &actions_dag->addFunction(tuple_element_builder, {multi_node, index_node}, result_name);
+        }
+    }
+}
+
 std::string getDecimalFunction(const substrait::Type_Decimal & decimal, bool null_on_overflow)
 {
     std::string ch_function_name;
@@ -244,7 +327,19 @@ QueryPlanStepPtr SerializedPlanParser::parseReadRealWithLocalFile(const substrai
     assert(rel.has_local_files());
     assert(rel.has_base_schema());
     auto header = TypeParser::buildBlockFromNamedStruct(rel.base_schema());
-    auto source = std::make_shared<SubstraitFileSource>(context, header, rel.local_files());
+
+    /// The filter is still applied by the following filter step, here it only lets the source skip row groups and
+    /// read the filter columns of a row group before the others.
+    std::shared_ptr<const KeyCondition> key_condition;
+    PrewhereInfoPtr prewhere_info;
+    if (rel.has_filter() && header.columns())
+    {
+        prewhere_info = parsePreWhereInfo(rel.filter(), header);
+        auto key_expr = std::make_shared<ExpressionActions>(std::make_shared<ActionsDAG>(header.getNamesAndTypesList()));
+        key_condition = std::make_shared<const KeyCondition>(
+            prewhere_info->prewhere_actions->clone(), context, header.getNames(), key_expr, NameSet{});
+    }
+    auto source = std::make_shared<SubstraitFileSource>(context, header, rel.local_files(), key_condition, prewhere_info);
     auto source_pipe = Pipe(source);
     auto source_step = std::make_unique<ReadFromStorageStep>(std::move(source_pipe), "substrait local files", nullptr);
     source_step->setStepDescription("read local files");
@@ -1004,6 +1099,21 @@ const ActionsDAG::Node * SerializedPlanParser::parseFunctionWithDAG(
     const auto & scalar_function = rel.scalar_function();
     auto function_signature = function_mapping.at(std::to_string(scalar_function.function_reference()));
 
+    if (!fused_get_json_objects.empty() && startsWith(function_signature, "get_json_object:"))
+    {
+        if (auto it = fused_get_json_objects.find(rel.SerializeAsString()); it != fused_get_json_objects.end())
+        {
+            const auto * result_node = it->second;
+            if (!TypeParser::isTypeMatched(scalar_function.output_type(), result_node->result_type))
+                result_node = ActionsDAGUtil::convertNodeType(
+                    actions_dag, result_node, TypeParser::parseType(scalar_function.output_type())->getName(), result_node->result_name);
+            if (keep_result)
+                actions_dag->addOrReplaceInOutputs(*result_node);
+            result_name = result_node->result_name;
+            return result_node;
+        }
+    }
+
     /// If the substrait function name is registered in FunctionParserFactory, use it to parse the function, and return result directly
     auto pos = function_signature.find(':');
     auto func_name = function_signature.substr(0, pos);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+
 #include <Core/Block.h>
 #include <Core/ColumnWithTypeAndName.h>
 #include <Core/SortDescription.h>
@@ -323,6 +325,11 @@ private:
         DB::ActionsDAGPtr actions_dag = nullptr,
         bool keep_result = false,
         bool position = false);
+    /// Adds one get_json_object_multi node to actions_dag for the get_json_object calls of expressions that share their
+    /// json argument, so that each document is parsed once. The calls are then parsed into the fused_get_json_objects.
+    void fuseGetJsonObjects(const std::vector<substrait::Expression> & expressions, DB::ActionsDAGPtr actions_dag);
+    void collectGetJsonObjects(
+        const substrait::Expression & expr, std::map<String, std::vector<const substrait::Expression *>> & calls_by_json) const;
     void parseFunctionArguments(
         DB::ActionsDAGPtr & actions_dag,
         ActionsDAG::NodeRawConstPtrs & parsed_args,
@@ -353,6 +360,8 @@ private:
 
     int name_no = 0;
     std::unordered_map<std::string, std::string> function_mapping;
+    /// Serialized get_json_object calls of the projection being parsed to their node in the fused extraction.
+    std::unordered_map<std::string, const ActionsDAG::Node *> fused_get_json_objects;
     std::vector<jobject> input_iters;
     ContextPtr context;
     // for parse rel node, collect steps from a rel node
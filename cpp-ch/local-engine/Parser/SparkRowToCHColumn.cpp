@@ -1,5 +1,6 @@
 #include "SparkRowToCHColumn.h"
 #include <memory>
+#include <Columns/ColumnDecimal.h>
 #include <Columns/ColumnNullable.h>
 #include <Columns/ColumnString.h>
 #include <Columns/ColumnVector.h>
@@ -11,6 +12,7 @@
 #include <DataTypes/DataTypesDecimal.h>
 #include <DataTypes/DataTypesNumber.h>
 #include <Functions/FunctionHelpers.h>
+#include <base/unaligned.h>
 #include <Common/CHUtil.h>
 #include <Common/Exception.h>
 
@@ -32,24 +34,132 @@ jmethodID SparkRowToCHColumn::spark_row_interator_hasNext = nullptr;
 jmethodID SparkRowToCHColumn::spark_row_interator_next = nullptr;
 jmethodID SparkRowToCHColumn::spark_row_iterator_nextBatch = nullptr;
 
-ALWAYS_INLINE static void writeRowToColumns(std::vector<MutableColumnPtr> & columns, const SparkRowReader & spark_row_reader)
+ALWAYS_INLINE static void writeFieldToColumn(IColumn & column, const SparkRowReader & spark_row_reader, size_t i)
 {
-    auto num_fields = columns.size();
+    if (spark_row_reader.supportRawData(i))
+    {
+        const StringRef str_ref{spark_row_reader.getStringRef(i)};
+        if (str_ref.data == nullptr)
+            column.insertData(nullptr, str_ref.size);
+        else if (!spark_row_reader.isBigEndianInSparkRow(i))
+            column.insertData(str_ref.data, str_ref.size);
+        else
+            column.insert(spark_row_reader.getField(i)); // read decimal128
+    }
+    else
+        column.insert(spark_row_reader.getField(i));
+}
+
+/// Appends the field at field_offset of all the rows to column if it's a ColumnType. Null fields are zero in Spark rows,
+/// they are read like the others.
+template <typename ColumnType>
+static bool tryGatherFixedLengthValues(IColumn & column, int64_t field_offset, const std::vector<StringRef> & rows)
+{
+    auto * typed_column = typeid_cast<ColumnType *>(&column);
+    if (!typed_column)
+        return false;
+
+    using ValueType = typename ColumnType::ValueType;
+    auto & data = typed_column->getData();
+    size_t old_size = data.size();
+    data.resize(old_size + rows.size());
+    for (size_t row = 0; row < rows.size(); ++row)
+        data[old_size + row] = unalignedLoad<ValueType>(rows[row].data + field_offset);
+    return true;
+}
 
-    for (size_t i = 0; i < num_fields; i++)
+/// Appends the strings of field ordinal of all the rows to column if it's a ColumnString, with its chars sized ahead.
+static bool tryGatherStrings(IColumn & column, size_t ordinal, int64_t field_offset, const std::vector<StringRef> & rows)
+{
+    auto * string_column = typeid_cast<ColumnString *>(&column);
+    if (!string_column)
+        return false;
+
+    const int64_t null_word_offset = (ordinal >> 6) * 8;
+    const UInt64 null_mask = 1ULL << (ordinal & 63);
+    auto is_null = [&](const StringRef & row) { return unalignedLoad<UInt64>(row.data + null_word_offset) & null_mask; };
+
+    size_t total_size = 0;
+    for (const auto & row : rows)
+        if (!is_null(row))
+            total_size += BackingDataLengthCalculator::extractSize(unalignedLoad<int64_t>(row.data + field_offset));
+
+    auto & chars = string_column->getChars();
+    auto & offsets = string_column->getOffsets();
+    size_t chars_size = chars.size();
+    chars.resize(chars_size + total_size + rows.size());
+    offsets.reserve(offsets.size() + rows.size());
+    for (const auto & row : rows)
     {
-        if (spark_row_reader.supportRawData(i))
+        if (!is_null(row))
         {
-            const StringRef str_ref{spark_row_reader.getStringRef(i)};
-            if (str_ref.data == nullptr)
-                columns[i]->insertData(nullptr, str_ref.size);
-            else if (!spark_row_reader.isBigEndianInSparkRow(i))
-                columns[i]->insertData(str_ref.data, str_ref.size);
-            else
-                columns[i]->insert(spark_row_reader.getField(i)); // read decimal128
+            const int64_t offset_and_size = unalignedLoad<int64_t>(row.data + field_offset);
+            const int64_t size = BackingDataLengthCalculator::extractSize(offset_and_size);
+            memcpy(&chars[chars_size], row.data + BackingDataLengthCalculator::extractOffset(offset_and_size), size);
+            chars_size += size;
+        }
+        chars[chars_size++] = 0;
+        offsets.push_back(chars_size);
+    }
+    return true;
+}
+
+/// Decodes the rows one column at a time. The fixed-length numbers and the strings are gathered straight into their
+/// columns, the other types are read through a SparkRowReader row by row.
+static void writeRowsToColumns(MutableColumns & columns, const DataTypes & types, const std::vector<StringRef> & rows)
+{
+    if (rows.empty())
+        return;
+
+    SparkRowReader row_reader(types);
+    const int64_t bit_set_width_in_bytes = calculateBitSetWidthInBytes(columns.size());
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        IColumn * nested_column = columns[i].get();
+        NullMap * null_map = nullptr;
+        if (auto * nullable_column = typeid_cast<ColumnNullable *>(columns[i].get()))
+        {
+            nested_column = &nullable_column->getNestedColumn();
+            null_map = &nullable_column->getNullMapData();
+        }
+
+        const int64_t field_offset = bit_set_width_in_bytes + i * 8;
+        bool gathered = false;
+        if (row_reader.supportRawData(i) && !row_reader.isBigEndianInSparkRow(i))
+            gathered = tryGatherFixedLengthValues<ColumnUInt8>(*nested_column, field_offset, rows)
+                || tryGatherFixedLengthValues<ColumnUInt16>(*nested_column, field_offset, rows)
+                || tryGatherFixedLengthValues<ColumnUInt32>(*nested_column, field_offset, rows)
+                || tryGatherFixedLengthValues<ColumnUInt64>(*nested_column, field_offset, rows)
+                || tryGatherFixedLengthValues<ColumnInt8>(*nested_column, field_offset, rows)
+                || tryGatherFixedLengthValues<ColumnInt16>(*nested_column, field_offset, rows)
+                || tryGatherFixedLengthValues<ColumnInt32>(*nested_column, field_offset, rows)
+                || tryGatherFixedLengthValues<ColumnInt64>(*nested_column, field_offset, rows)
+                || tryGatherFixedLengthValues<ColumnFloat32>(*nested_column, field_offset, rows)
+                || tryGatherFixedLengthValues<ColumnFloat64>(*nested_column, field_offset, rows)
+                || tryGatherFixedLengthValues<ColumnDecimal<Decimal32>>(*nested_column, field_offset, rows)
+                || tryGatherFixedLengthValues<ColumnDecimal<Decimal64>>(*nested_column, field_offset, rows)
+                || tryGatherFixedLengthValues<ColumnDecimal<DateTime64>>(*nested_column, field_offset, rows)
+                || tryGatherStrings(*nested_column, i, field_offset, rows);
+
+        if (!gathered)
+        {
+            for (const auto & row : rows)
+            {
+                row_reader.pointTo(row.data, static_cast<int32_t>(row.size));
+                writeFieldToColumn(*columns[i], row_reader, i);
+            }
+            continue;
+        }
+
+        if (null_map)
+        {
+            const int64_t null_word_offset = (i >> 6) * 8;
+            const UInt64 null_mask = 1ULL << (i & 63);
+            size_t old_size = null_map->size();
+            null_map->resize(old_size + rows.size());
+            for (size_t row = 0; row < rows.size(); ++row)
+                (*null_map)[old_size + row] = (unalignedLoad<UInt64>(rows[row].data + null_word_offset) & null_mask) != 0;
         }
-        else
-            columns[i]->insert(spark_row_reader.getField(i));
     }
 }
 
@@ -64,14 +174,10 @@ std::unique_ptr<Block> SparkRowToCHColumn::convertSparkRowInfoToCHColumn(const S
         for (size_t col_i = 0; col_i < header.columns(); ++col_i)
             mutable_columns[col_i]->reserve(num_rows);
 
-        DataTypes types{header.getDataTypes()};
-        SparkRowReader row_reader(types);
+        std::vector<StringRef> rows(num_rows);
         for (int64_t i = 0; i < num_rows; i++)
-        {
-            row_reader.pointTo(spark_row_info.getBufferAddress() + spark_row_info.getOffsets()[i],
-                               static_cast<int32_t>(spark_row_info.getLengths()[i]));
-            writeRowToColumns(mutable_columns, row_reader);
-        }
+            rows[i] = StringRef(spark_row_info.getBufferAddress() + spark_row_info.getOffsets()[i], spark_row_info.getLengths()[i]);
+        writeRowsToColumns(mutable_columns, header.getDataTypes(), rows);
         block->setColumns(std::move(mutable_columns));
     }
     else
@@ -82,12 +188,10 @@ std::unique_ptr<Block> SparkRowToCHColumn::convertSparkRowInfoToCHColumn(const S
     return block;
 }
 
-void SparkRowToCHColumn::appendSparkRowToCHColumn(SparkRowToCHColumnHelper & helper, char * buffer, int32_t length)
+void SparkRowToCHColumn::appendSparkRowsToCHColumn(SparkRowToCHColumnHelper & helper, const std::vector<StringRef> & rows)
 {
-    SparkRowReader row_reader(helper.data_types);
-    row_reader.pointTo(buffer, length);
-    writeRowToColumns(helper.mutable_columns, row_reader);
-    ++helper.rows;
+    writeRowsToColumns(helper.mutable_columns, helper.data_types, rows);
+    helper.rows += rows.size();
 }
 
 Block * SparkRowToCHColumn::getBlock(SparkRowToCHColumnHelper & helper)
@@ -81,6 +81,7 @@ public:
     static Block * convertSparkRowItrToCHColumn(jobject java_iter, vector<string> & names, vector<string> & types)
     {
         SparkRowToCHColumnHelper helper(names, types);
+        std::vector<StringRef> rows;
 
         GET_JNIENV(env)
         while (safeCallBooleanMethod(env, java_iter, spark_row_interator_hasNext))
@@ -91,14 +92,17 @@ public:
 
             // len = -1 means reaching the buf's end.
             // len = 0 indicates no columns in the this row. e.g. count(1)/count(*)
+            // The rows of a batch are collected first and decoded one column at a time.
+            rows.clear();
             while (len >= 0)
             {
                 rows_buf_ptr += 4;
-                appendSparkRowToCHColumn(helper, rows_buf_ptr, len);
+                rows.emplace_back(rows_buf_ptr, len);
 
                 rows_buf_ptr += len;
                 len = *(reinterpret_cast<int *>(rows_buf_ptr));
             }
+            appendSparkRowsToCHColumn(helper, rows);
 
             // Try to release reference.
             env->DeleteLocalRef(rows_buf);
@@ -113,7 +117,7 @@ public:
     }
 
 private:
-    static void appendSparkRowToCHColumn(SparkRowToCHColumnHelper & helper, char * buffer, int32_t length);
+    static void appendSparkRowsToCHColumn(SparkRowToCHColumnHelper & helper, const std::vector<StringRef> & rows);
     static Block * getBlock(SparkRowToCHColumnHelper & helper);
 };
 
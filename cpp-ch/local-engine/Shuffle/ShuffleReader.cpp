@@ -3,6 +3,8 @@
 #include <Common/DebugUtils.h>
 #include <Common/JNIUtils.h>
 #include <Common/Stopwatch.h>
+#include <Common/logger_useful.h>
+#include <base/scope_guard.h>
 
 using namespace DB;
 
@@ -38,32 +40,151 @@ ShuffleReader::~ShuffleReader()
 jclass ShuffleReader::input_stream_class = nullptr;
 jmethodID ShuffleReader::input_stream_read = nullptr;
 
-bool ReadBufferFromJavaInputStream::nextImpl()
+ReadBufferWithReadAhead::ReadBufferWithReadAhead(size_t buffer_size_, bool read_ahead_)
+    : DB::BufferWithOwnMemory<DB::ReadBuffer>(buffer_size_), buffer_size(buffer_size_), read_ahead(read_ahead_)
 {
-    int count = readFromJava();
+    if (read_ahead)
+        read_ahead_memory.resize(buffer_size);
+}
+ReadBufferWithReadAhead::~ReadBufferWithReadAhead()
+{
+    stopReadAhead();
+}
+bool ReadBufferWithReadAhead::nextImpl()
+{
+    int count = 0;
+    if (read_ahead)
+    {
+        /// Started on the first read instead of in the constructor, the stream is not read if the reader is never used.
+        if (!read_ahead_thread)
+            read_ahead_thread = std::make_unique<ThreadFromGlobalPool>([this] { readAhead(); });
+        std::unique_lock lock(read_ahead_mutex);
+        read_ahead_cv.wait(lock, [this] { return read_ahead_ready; });
+        if (read_ahead_exception)
+            std::rethrow_exception(read_ahead_exception);
+        count = read_ahead_count;
+        if (count > 0)
+        {
+            std::swap(memory, read_ahead_memory);
+            internal_buffer = Buffer(memory.data(), memory.data() + memory.size());
+            working_buffer = internal_buffer;
+            read_ahead_ready = false;
+            read_ahead_cv.notify_all();
+        }
+    }
+    else
+    {
+        count = countedReadChunk(working_buffer.begin());
+    }
+
     if (count > 0)
     {
         working_buffer.resize(count);
     }
     return count > 0;
 }
-int ReadBufferFromJavaInputStream::readFromJava()
+int ReadBufferWithReadAhead::countedReadChunk(char * to)
 {
-    GET_JNIENV(env)
-    jint count
-        = safeCallIntMethod(env, java_in, ShuffleReader::input_stream_read, reinterpret_cast<jlong>(working_buffer.begin()), buffer_size);
-    CLEAN_JNIENV
+    Stopwatch watch;
+    int count = readChunk(to);
+    read_nanoseconds += watch.elapsedNanoseconds();
+    ++read_calls;
+    if (count > 0)
+        read_bytes += count;
     return count;
 }
-ReadBufferFromJavaInputStream::ReadBufferFromJavaInputStream(jobject input_stream, size_t customize_buffer_size)
-    : java_in(input_stream), buffer_size(customize_buffer_size)
+void ReadBufferWithReadAhead::readAhead()
+{
+    bool attached = false;
+    SCOPE_EXIT({
+        if (attached)
+            detachReadAheadThread();
+    });
+    while (true)
+    {
+        {
+            std::unique_lock lock(read_ahead_mutex);
+            read_ahead_cv.wait(lock, [this] { return !read_ahead_ready || read_ahead_stopped; });
+            if (read_ahead_stopped)
+                return;
+        }
+
+        int count = 0;
+        std::exception_ptr exception;
+        try
+        {
+            if (!attached)
+            {
+                attachReadAheadThread();
+                attached = true;
+            }
+            count = countedReadChunk(read_ahead_memory.data());
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+
+        std::lock_guard lock(read_ahead_mutex);
+        read_ahead_count = count;
+        read_ahead_exception = exception;
+        read_ahead_ready = true;
+        read_ahead_cv.notify_all();
+        if (count <= 0 || exception)
+            return;
+    }
+}
+void ReadBufferWithReadAhead::stopReadAhead()
+{
+    if (!read_ahead_thread)
+        return;
+    {
+        std::lock_guard lock(read_ahead_mutex);
+        read_ahead_stopped = true;
+        read_ahead_cv.notify_all();
+    }
+    read_ahead_thread->join();
+    read_ahead_thread.reset();
+}
+
+ReadBufferFromJavaInputStream::ReadBufferFromJavaInputStream(
+    jobject input_stream, size_t customize_buffer_size, size_t read_ahead_buffer_size)
+    : ReadBufferWithReadAhead(std::max(customize_buffer_size, read_ahead_buffer_size), read_ahead_buffer_size > 0), java_in(input_stream)
 {
 }
 ReadBufferFromJavaInputStream::~ReadBufferFromJavaInputStream()
 {
+    stopReadAhead();
+    LOG_DEBUG(
+        &Poco::Logger::get("ReadBufferFromJavaInputStream"),
+        "Read {} bytes from java in {} calls, {} bytes per call, {} ms{}",
+        getReadBytes(),
+        getReadCalls(),
+        getReadCalls() ? getReadBytes() / getReadCalls() : 0,
+        getReadNanoseconds() / 1000000,
+        read_ahead ? ", read ahead" : "");
+
     GET_JNIENV(env)
     env->DeleteGlobalRef(java_in);
     CLEAN_JNIENV
 }
+int ReadBufferFromJavaInputStream::readChunk(char * to)
+{
+    /// On the helper thread the env is the one attachReadAheadThread attached, it is not detached after the call.
+    GET_JNIENV(env)
+    jint count = safeCallIntMethod(env, java_in, ShuffleReader::input_stream_read, reinterpret_cast<jlong>(to), buffer_size);
+    CLEAN_JNIENV
+    return count;
+}
+void ReadBufferFromJavaInputStream::attachReadAheadThread()
+{
+    /// The helper thread stays attached to the JVM until the stream ends, instead of attaching once per call.
+    JNIUtils::getENV(&read_ahead_thread_attached);
+}
+void ReadBufferFromJavaInputStream::detachReadAheadThread()
+{
+    if (read_ahead_thread_attached)
+        JNIUtils::detachCurrentThread();
+}
 
 }
@@ -1,8 +1,12 @@
 #pragma once
+#include <condition_variable>
+#include <mutex>
 #include <jni.h>
 #include <Compression/CompressedReadBuffer.h>
 #include <Formats/NativeReader.h>
+#include <IO/BufferWithOwnMemory.h>
 #include <IO/ReadBuffer.h>
+#include <Common/ThreadPool.h>
 #include <Common/BlockIterator.h>
 
 
@@ -26,17 +30,66 @@ private:
 };
 
 
-class ReadBufferFromJavaInputStream : public DB::BufferWithOwnMemory<DB::ReadBuffer>
+/// Reads a stream in chunks of buffer_size bytes. With read_ahead a helper thread keeps a second buffer filled from the
+/// stream while the current one is consumed, so fetching overlaps with decompression and decoding.
+class ReadBufferWithReadAhead : public DB::BufferWithOwnMemory<DB::ReadBuffer>
 {
 public:
-    explicit ReadBufferFromJavaInputStream(jobject input_stream, size_t customize_buffer_size);
+    ReadBufferWithReadAhead(size_t buffer_size_, bool read_ahead_);
+    ~ReadBufferWithReadAhead() override;
+
+    /// The calls to readChunk, the bytes they returned and the time spent in them.
+    size_t getReadCalls() const { return read_calls; }
+    size_t getReadBytes() const { return read_bytes; }
+    UInt64 getReadNanoseconds() const { return read_nanoseconds; }
+
+protected:
+    /// Reads at most buffer_size bytes into to, returns their count, 0 or less at the end of the stream.
+    virtual int readChunk(char * to) = 0;
+    /// Called on the helper thread before its first read and after its last one.
+    virtual void attachReadAheadThread() { }
+    virtual void detachReadAheadThread() { }
+    /// Joins the helper thread. Derived classes call it in their destructor, readChunk must not run once they are gone.
+    void stopReadAhead();
+
+    const size_t buffer_size;
+    const bool read_ahead;
+
+private:
+    bool nextImpl() override;
+    int countedReadChunk(char * to);
+    void readAhead();
+
+    /// Filled by the helper thread, swapped with memory once the current buffer is consumed.
+    DB::Memory<> read_ahead_memory;
+    int read_ahead_count = 0;
+    bool read_ahead_ready = false;
+    bool read_ahead_stopped = false;
+    std::exception_ptr read_ahead_exception;
+    std::mutex read_ahead_mutex;
+    std::condition_variable read_ahead_cv;
+    std::unique_ptr<ThreadFromGlobalPool> read_ahead_thread;
+
+    std::atomic<size_t> read_calls = 0;
+    std::atomic<size_t> read_bytes = 0;
+    std::atomic<UInt64> read_nanoseconds = 0;
+};
+
+/// Reads the bytes of a Java InputStream, ahead on a helper thread with read_ahead_buffer_size > 0.
+class ReadBufferFromJavaInputStream : public ReadBufferWithReadAhead
+{
+public:
+    explicit ReadBufferFromJavaInputStream(jobject input_stream, size_t customize_buffer_size, size_t read_ahead_buffer_size = 0);
     ~ReadBufferFromJavaInputStream() override;
 
 private:
     jobject java_in;
-    size_t buffer_size;
-    int readFromJava();
-    bool nextImpl() override;
+    /// Whether the helper thread was attached to the JVM by attachReadAheadThread.
+    int read_ahead_thread_attached = 0;
+
+    int readChunk(char * to) override;
+    void attachReadAheadThread() override;
+    void detachReadAheadThread() override;
 };
 
 }
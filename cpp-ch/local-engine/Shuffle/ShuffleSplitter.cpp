@@ -4,19 +4,62 @@
 #include <memory>
 #include <string>
 #include <fcntl.h>
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#include <unistd.h>
+#endif
 #include <Compression/CompressedWriteBuffer.h>
 #include <Compression/CompressionFactory.h>
 #include <Functions/FunctionFactory.h>
 #include <IO/BrotliWriteBuffer.h>
 #include <IO/ReadBufferFromFile.h>
 #include <IO/WriteHelpers.h>
+#include <IO/copyData.h>
 #include <Parser/SerializedPlanParser.h>
 #include <boost/algorithm/string/case_conv.hpp>
 #include <Poco/StringTokenizer.h>
 #include <Common/DebugUtils.h>
+#include <Common/logger_useful.h>
 
 namespace local_engine
 {
+#if defined(__linux__)
+namespace
+{
+/// Copies up to length bytes at offset of in_fd to the current position of out_fd without passing them through
+/// user space. Returns the number of bytes copied, which is less than length if the kernel can't copy between these
+/// files or fails, the caller copies the rest through its buffers and reports the error if there is one.
+size_t kernelCopy(int in_fd, size_t offset, int out_fd, size_t length)
+{
+    size_t copied = 0;
+    bool use_copy_file_range = true;
+    while (copied < length)
+    {
+        ssize_t n;
+        if (use_copy_file_range)
+        {
+            loff_t in_offset = offset + copied;
+            n = copy_file_range(in_fd, &in_offset, out_fd, nullptr, length - copied, 0);
+        }
+        else
+        {
+            off_t in_offset = offset + copied;
+            n = sendfile(out_fd, in_fd, &in_offset, length - copied);
+        }
+        if (n > 0)
+            copied += n;
+        else if (n < 0 && errno == EINTR)
+            continue;
+        else if (n < 0 && use_copy_file_range && (errno == ENOSYS || errno == EXDEV || errno == EOPNOTSUPP || errno == EINVAL))
+            use_copy_file_range = false;
+        else
+            break;
+    }
+    return copied;
+}
+}
+#endif
+
 void ShuffleSplitter::split(DB::Block & block)
 {
     if (block.rows() == 0)
@@ -31,19 +74,9 @@ void ShuffleSplitter::split(DB::Block & block)
 }
 SplitResult ShuffleSplitter::stop()
 {
-    // spill all buffers
     Stopwatch watch;
     watch.start();
-    for (size_t i = 0; i < options.partition_nums; i++)
-    {
-        spillPartition(i);
-        partition_outputs[i]->flush();
-        partition_write_buffers[i].reset();
-    }
-    partition_outputs.clear();
-    partition_cached_write_buffers.clear();
-    partition_write_buffers.clear();
-    mergePartitionFiles();
+    mergeSpills();
     split_result.total_write_time += watch.elapsedNanoseconds();
     stopped = true;
     return split_result;
@@ -89,19 +122,74 @@ void ShuffleSplitter::splitBlockByPartition(DB::Block & block)
 
     for (size_t i = 0; i < options.partition_nums; ++i)
     {
+        if (partition_info.partition_start_points[i + 1] == partition_info.partition_start_points[i])
+            continue;
         ColumnsBuffer & buffer = partition_buffer[i];
         if (buffer.size() >= options.split_size)
-        {
             spillPartition(i);
-        }
+        else
+            updateBufferedBytes(i);
+    }
+    checkMemoryBudget();
+}
+
+void ShuffleSplitter::updateBufferedBytes(size_t partition_id)
+{
+    auto bytes = partition_buffer[partition_id].bytes();
+    buffered_bytes = buffered_bytes - partition_buffered_bytes[partition_id] + bytes;
+    partition_buffered_bytes[partition_id] = bytes;
+}
+
+void ShuffleSplitter::checkMemoryBudget()
+{
+    if (options.spill_threshold > 0 && buffered_bytes > options.spill_threshold)
+    {
+        evictPartitions(options.spill_threshold / 2);
+        return;
+    }
+    if (!options.listener)
+        return;
+
+    /// The memory tracker reserves the buffers from Spark as they grow. Reservations Spark couldn't grant mean the task
+    /// is over its share of execution memory, the buffers are spilled rather than asking for more.
+    auto unmet = options.listener->takeUnmetReservations();
+    if (unmet <= 0)
+        return;
+    LOG_DEBUG(
+        &Poco::Logger::get("ShuffleSplitter"),
+        "Spilling under memory pressure, buffered {} bytes, {} bytes not granted",
+        buffered_bytes,
+        unmet);
+    evictPartitions(buffered_bytes / 2);
+}
+
+void ShuffleSplitter::evictPartitions(size_t target_bytes)
+{
+    std::vector<size_t> partition_ids;
+    for (size_t i = 0; i < options.partition_nums; ++i)
+    {
+        if (partition_buffered_bytes[i] > 0)
+            partition_ids.push_back(i);
+    }
+    std::sort(
+        partition_ids.begin(),
+        partition_ids.end(),
+        [&](size_t a, size_t b) { return partition_buffered_bytes[a] > partition_buffered_bytes[b]; });
+    for (auto partition_id : partition_ids)
+    {
+        if (buffered_bytes <= target_bytes)
+            break;
+        spillPartition(partition_id);
     }
 }
 void ShuffleSplitter::init()
 {
+    /// Only shortfalls from here on are caused by this writer's buffers.
+    if (options.listener)
+        options.listener->takeUnmetReservations();
     partition_buffer.reserve(options.partition_nums);
-    partition_outputs.reserve(options.partition_nums);
-    partition_write_buffers.reserve(options.partition_nums);
-    partition_cached_write_buffers.reserve(options.partition_nums);
+    partition_buffered_bytes.resize(options.partition_nums, 0);
+    partition_spills.resize(options.partition_nums);
     split_result.partition_length.reserve(options.partition_nums);
     split_result.raw_partition_length.reserve(options.partition_nums);
     for (size_t i = 0; i < options.partition_nums; ++i)
@@ -109,9 +197,6 @@ void ShuffleSplitter::init()
         partition_buffer.emplace_back(ColumnsBuffer());
         split_result.partition_length.emplace_back(0);
         split_result.raw_partition_length.emplace_back(0);
-        partition_outputs.emplace_back(nullptr);
-        partition_write_buffers.emplace_back(nullptr);
-        partition_cached_write_buffers.emplace_back(nullptr);
     }
 }
 
@@ -119,42 +204,86 @@ void ShuffleSplitter::spillPartition(size_t partition_id)
 {
     Stopwatch watch;
     watch.start();
-    if (!partition_outputs[partition_id])
-    {
-        partition_write_buffers[partition_id] = getPartitionWriteBuffer(partition_id);
-        partition_outputs[partition_id]
-            = std::make_unique<DB::NativeWriter>(*partition_write_buffers[partition_id], 0, partition_buffer[partition_id].getHeader());
-    }
     DB::Block result = partition_buffer[partition_id].releaseColumns();
-    if (result.rows() > 0)
+    buffered_bytes -= partition_buffered_bytes[partition_id];
+    partition_buffered_bytes[partition_id] = 0;
+    if (result.rows() == 0)
+        return;
+
+    if (!spill_write_buffer)
     {
-        partition_outputs[partition_id]->write(result);
+        spill_file = getSpillFile();
+        spill_write_buffer = std::make_unique<DB::WriteBufferFromFile>(spill_file, options.io_buffer_size, O_CREAT | O_WRONLY | O_TRUNC);
     }
+    auto offset = spill_write_buffer->count();
+    writeBlock(*spill_write_buffer, result);
+    partition_spills[partition_id].push_back({offset, spill_write_buffer->count() - offset});
     split_result.total_spill_time += watch.elapsedNanoseconds();
     split_result.total_bytes_spilled += result.bytes();
 }
 
-void ShuffleSplitter::mergePartitionFiles()
+void ShuffleSplitter::writeBlock(DB::WriteBuffer & out, const DB::Block & block)
 {
+    if (!options.compress_method.empty()
+        && std::find(compress_methods.begin(), compress_methods.end(), options.compress_method) != compress_methods.end())
+    {
+        auto codec = DB::CompressionCodecFactory::instance().get(boost::to_upper_copy(options.compress_method), {});
+        DB::CompressedWriteBuffer compressed_out(out, codec);
+        DB::NativeWriter writer(compressed_out, 0, block.cloneEmpty());
+        writer.write(block);
+        compressed_out.finalize();
+    }
+    else
+    {
+        DB::NativeWriter writer(out, 0, block.cloneEmpty());
+        writer.write(block);
+    }
+}
+
+void ShuffleSplitter::mergeSpills()
+{
+    std::unique_ptr<DB::ReadBufferFromFile> spill_reader;
+    if (spill_write_buffer)
+    {
+        spill_write_buffer->finalize();
+        spill_write_buffer.reset();
+        spill_reader = std::make_unique<DB::ReadBufferFromFile>(spill_file, options.io_buffer_size);
+    }
+
     DB::WriteBufferFromFile data_write_buffer = DB::WriteBufferFromFile(options.data_file);
-    std::string buffer;
-    size_t buffer_size = options.io_buffer_size;
-    buffer.reserve(buffer_size);
+    /// Bytes appended to the data file by the kernel, which data_write_buffer.count() doesn't see.
+    size_t kernel_copied = 0;
     for (size_t i = 0; i < options.partition_nums; ++i)
     {
-        auto file = getPartitionTempFile(i);
-        DB::ReadBufferFromFile reader = DB::ReadBufferFromFile(file, options.io_buffer_size);
-        while (reader.next())
+        auto partition_start = data_write_buffer.count() + kernel_copied;
+        for (const auto & range : partition_spills[i])
         {
-            auto bytes = reader.readBig(buffer.data(), buffer_size);
-            data_write_buffer.write(buffer.data(), bytes);
-            split_result.partition_length[i] += bytes;
-            split_result.total_bytes_written += bytes;
+            size_t copied = 0;
+#if defined(__linux__)
+            data_write_buffer.next();
+            copied = kernelCopy(spill_reader->getFD(), range.offset, data_write_buffer.getFD(), range.length);
+            kernel_copied += copied;
+#endif
+            if (copied < range.length)
+            {
+                spill_reader->seek(range.offset + copied, SEEK_SET);
+                DB::copyData(*spill_reader, data_write_buffer, range.length - copied);
+            }
         }
-        reader.close();
-        std::filesystem::remove(file);
+        DB::Block result = partition_buffer[i].releaseColumns();
+        if (result.rows() > 0)
+            writeBlock(data_write_buffer, result);
+        split_result.partition_length[i] = data_write_buffer.count() + kernel_copied - partition_start;
     }
+    split_result.total_bytes_written += data_write_buffer.count() + kernel_copied;
     data_write_buffer.close();
+    buffered_bytes = 0;
+
+    if (spill_reader)
+    {
+        spill_reader->close();
+        std::filesystem::remove(spill_file);
+    }
 }
 
 ShuffleSplitter::ShuffleSplitter(SplitOptions && options_) : options(options_)
@@ -187,9 +316,9 @@ ShuffleSplitter::Ptr ShuffleSplitter::create(const std::string & short_name, Spl
     }
 }
 
-std::string ShuffleSplitter::getPartitionTempFile(size_t partition_id)
+std::string ShuffleSplitter::getSpillFile()
 {
-    auto file_name = std::to_string(options.shuffle_id) + "_" + std::to_string(options.map_id) + "_" + std::to_string(partition_id);
+    auto file_name = std::to_string(options.shuffle_id) + "_" + std::to_string(options.map_id) + ".spill";
     std::hash<std::string> hasher;
     auto hash = hasher(file_name);
     auto dir_id = hash % options.local_dirs_list.size();
@@ -201,24 +330,6 @@ std::string ShuffleSplitter::getPartitionTempFile(size_t partition_id)
     return std::filesystem::path(dir) / file_name;
 }
 
-std::unique_ptr<DB::WriteBuffer> ShuffleSplitter::getPartitionWriteBuffer(size_t partition_id)
-{
-    auto file = getPartitionTempFile(partition_id);
-    if (partition_cached_write_buffers[partition_id] == nullptr)
-        partition_cached_write_buffers[partition_id]
-            = std::make_unique<DB::WriteBufferFromFile>(file, options.io_buffer_size, O_CREAT | O_WRONLY | O_APPEND);
-    if (!options.compress_method.empty()
-        && std::find(compress_methods.begin(), compress_methods.end(), options.compress_method) != compress_methods.end())
-    {
-        auto codec = DB::CompressionCodecFactory::instance().get(boost::to_upper_copy(options.compress_method), {});
-        return std::make_unique<DB::CompressedWriteBuffer>(*partition_cached_write_buffers[partition_id], codec);
-    }
-    else
-    {
-        return std::move(partition_cached_write_buffers[partition_id]);
-    }
-}
-
 const std::vector<std::string> ShuffleSplitter::compress_methods = {"", "ZSTD", "LZ4"};
 
 void ShuffleSplitter::writeIndexFile()
@@ -293,6 +404,14 @@ size_t ColumnsBuffer::size() const
     return accumulated_columns.at(0)->size();
 }
 
+size_t ColumnsBuffer::bytes() const
+{
+    size_t res = 0;
+    for (const auto & column : accumulated_columns)
+        res += column->allocatedBytes();
+    return res;
+}
+
 DB::Block ColumnsBuffer::releaseColumns()
 {
     DB::Columns res(std::make_move_iterator(accumulated_columns.begin()), std::make_move_iterator(accumulated_columns.end()));
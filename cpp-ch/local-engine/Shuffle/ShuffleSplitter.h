@@ -5,6 +5,7 @@
 #include <Functions/IFunction.h>
 #include <IO/WriteBufferFromFile.h>
 #include <Shuffle/SelectorBuilder.h>
+#include <jni/ReservationListenerWrapper.h>
 #include <Common/PODArray.h>
 #include <Common/PODArray_fwd.h>
 
@@ -26,6 +27,10 @@ struct SplitOptions
     // std::vector<std::string> exprs;
     std::string compress_method = "zstd";
     int compress_level;
+    /// Buffered bytes above which the largest partitions are spilled, 0 for no fixed limit.
+    size_t spill_threshold = 0;
+    /// Listener the memory tracker reserves the buffers through, partitions are spilled when Spark doesn't grant them.
+    ReservationListenerWrapperPtr listener;
 };
 
 class ColumnsBuffer
@@ -35,6 +40,7 @@ public:
     void add(DB::Block & columns, int start, int end);
     void appendSelective(size_t column_idx, const DB::Block & source, const DB::IColumn::Selector & selector, size_t from, size_t length);
     size_t size() const;
+    size_t bytes() const;
     DB::Block releaseColumns();
     DB::Block getHeader();
 
@@ -76,18 +82,30 @@ public:
 private:
     void init();
     void splitBlockByPartition(DB::Block & block);
+    void updateBufferedBytes(size_t partition_id);
+    void checkMemoryBudget();
+    void evictPartitions(size_t target_bytes);
     void spillPartition(size_t partition_id);
-    std::string getPartitionTempFile(size_t partition_id);
-    void mergePartitionFiles();
-    std::unique_ptr<DB::WriteBuffer> getPartitionWriteBuffer(size_t partition_id);
+    void writeBlock(DB::WriteBuffer & out, const DB::Block & block);
+    std::string getSpillFile();
+    void mergeSpills();
 
 protected:
     bool stopped = false;
     PartitionInfo partition_info;
     std::vector<ColumnsBuffer> partition_buffer;
-    std::vector<std::unique_ptr<DB::NativeWriter>> partition_outputs;
-    std::vector<std::unique_ptr<DB::WriteBuffer>> partition_write_buffers;
-    std::vector<std::unique_ptr<DB::WriteBuffer>> partition_cached_write_buffers;
+    std::vector<size_t> partition_buffered_bytes;
+    size_t buffered_bytes = 0;
+
+    /// All spills go to one file, each partition keeps the ranges it was written to, in order.
+    struct SpillRange
+    {
+        size_t offset;
+        size_t length;
+    };
+    std::string spill_file;
+    std::unique_ptr<DB::WriteBufferFromFile> spill_write_buffer;
+    std::vector<std::vector<SpillRange>> partition_spills;
     std::vector<size_t> output_columns_indicies;
     DB::Block output_header;
     SplitOptions options;
@@ -5,7 +5,10 @@
 #include <Common/Stopwatch.h>
 #include <arrow/table.h>
 #include <boost/range/irange.hpp>
+#include <Columns/ColumnsCommon.h>
+#include <Columns/FilterDescription.h>
 #include <DataTypes/NestedUtils.h>
+#include <Storages/SubstraitSource/FormatFile.h>
 
 #include "ch_parquet/OptimizedArrowColumnToCHColumn.h"
 // clang-format on
@@ -14,9 +17,27 @@ using namespace DB;
 namespace local_engine
 {
 ArrowParquetBlockInputFormat::ArrowParquetBlockInputFormat(
-    DB::ReadBuffer & in_, const DB::Block & header, const DB::FormatSettings & formatSettings, const std::vector<int> & row_group_indices_)
-    : OptimizedParquetBlockInputFormat(in_, header, formatSettings), row_group_indices(row_group_indices_)
+    DB::ReadBuffer & in_,
+    const DB::Block & header,
+    const DB::FormatSettings & formatSettings,
+    const std::vector<int> & row_group_indices_,
+    std::shared_ptr<parquet::FileMetaData> metadata_,
+    std::optional<ParquetPrewhere> prewhere_)
+    : OptimizedParquetBlockInputFormat(in_, header, formatSettings, std::move(metadata_))
+    , row_group_indices(row_group_indices_)
+    , prewhere(std::move(prewhere_))
 {
+    if (prewhere)
+    {
+        for (const auto & name : prewhere->actions->getRequiredColumns())
+            prewhere_header.insert(header.getByName(name));
+        /// A filter without columns can't tell the row groups apart.
+        if (!prewhere_header.columns())
+            prewhere.reset();
+        for (const auto & column : header)
+            if (!prewhere_header.has(column.name))
+                other_header.insert(column);
+    }
 }
 
 static size_t countIndicesForType(std::shared_ptr<arrow::DataType> type)
@@ -44,6 +65,9 @@ static size_t countIndicesForType(std::shared_ptr<arrow::DataType> type)
 
 DB::Chunk ArrowParquetBlockInputFormat::generate()
 {
+    if (prewhere)
+        return generateWithPrewhere();
+
     DB::Chunk res;
     block_missing_values.clear();
 
@@ -100,6 +124,141 @@ DB::Chunk ArrowParquetBlockInputFormat::generate()
     return res;
 }
 
+DB::Chunk ArrowParquetBlockInputFormat::generateWithPrewhere()
+{
+    block_missing_values.clear();
+
+    if (!file_reader)
+    {
+        prepareReader();
+        if (is_stopped)
+            return {};
+        file_reader->set_batch_size(8192);
+        if (row_group_indices.empty())
+        {
+            auto row_group_range = boost::irange(0, file_reader->num_row_groups());
+            row_group_indices = std::vector(row_group_range.begin(), row_group_range.end());
+        }
+        preparePrewhere();
+    }
+
+    while (!is_stopped)
+    {
+        if (!current_record_batch_reader)
+        {
+            if (next_row_group >= row_group_indices.size())
+                return {};
+            int row_group = row_group_indices[next_row_group++];
+            if (!evaluatePrewhere(row_group))
+                continue;
+            row_group_offset = 0;
+
+            /// Nothing else to read from the file, the columns it lacks are filled with defaults.
+            if (other_column_indices.empty())
+            {
+                size_t rows = row_group_filter.size();
+                DB::Columns other_columns;
+                for (const auto & column : other_header)
+                    other_columns.push_back(column.type->createColumnConstWithDefaultValue(rows)->convertToFullColumnIfConst());
+                return assembleChunk(std::move(other_columns), rows);
+            }
+
+            auto read_status
+                = file_reader->GetRecordBatchReader(std::vector<int>{row_group}, other_column_indices, &current_record_batch_reader);
+            if (!read_status.ok())
+                throw std::runtime_error{"Error while reading Parquet data: " + read_status.ToString()};
+        }
+
+        auto batch = current_record_batch_reader->Next();
+        if (!*batch)
+        {
+            current_record_batch_reader.reset();
+            continue;
+        }
+        auto tmp_table = arrow::Table::FromRecordBatches({*batch});
+        if (format_settings.use_lowercase_column_name)
+            tmp_table = (*tmp_table)->RenameColumns(other_field_names);
+        DB::Chunk other;
+        other_column_to_ch_column->arrowTableToCHChunk(other, *tmp_table);
+
+        /// The batches of a row group come in order, so its prewhere columns and filter are consumed from the front.
+        auto res = assembleChunk(other.detachColumns(), (*batch)->num_rows());
+        if (res.getNumRows())
+            return res;
+    }
+    return {};
+}
+
+DB::Chunk ArrowParquetBlockInputFormat::assembleChunk(DB::Columns other_columns, size_t rows)
+{
+    const auto & header = getPort().getHeader();
+    DB::Columns columns;
+    columns.reserve(header.columns());
+    size_t other_position = 0;
+    for (const auto & column : header)
+    {
+        if (prewhere_header.has(column.name))
+            columns.push_back(row_group_columns[prewhere_header.getPositionByName(column.name)]->cut(row_group_offset, rows));
+        else
+            columns.push_back(std::move(other_columns[other_position++]));
+    }
+
+    DB::IColumn::Filter filter(row_group_filter.begin() + row_group_offset, row_group_filter.begin() + row_group_offset + rows);
+    row_group_offset += rows;
+    size_t passed_rows = DB::countBytesInFilter(filter);
+    if (passed_rows < rows)
+        for (auto & column : columns)
+            column = column->filter(filter, passed_rows);
+
+    if (format_settings.defaults_for_omitted_fields)
+        for (size_t row_idx = 0; row_idx < passed_rows; ++row_idx)
+            for (const auto & column_idx : missing_columns)
+                block_missing_values.setBit(column_idx, row_idx);
+    return DB::Chunk(std::move(columns), passed_rows);
+}
+
+void ArrowParquetBlockInputFormat::preparePrewhere()
+{
+    prewhere_column_to_ch_column = std::make_unique<OptimizedArrowColumnToCHColumn>(
+        prewhere_header, "Parquet", format_settings.parquet.import_nested, format_settings.parquet.allow_missing_columns);
+    other_column_to_ch_column = std::make_unique<OptimizedArrowColumnToCHColumn>(
+        other_header, "Parquet", format_settings.parquet.import_nested, format_settings.parquet.allow_missing_columns);
+    for (size_t i = 0; i < column_indices.size(); ++i)
+    {
+        bool is_prewhere_column = prewhere_header.has(column_names[i]);
+        auto & indices = is_prewhere_column ? prewhere_column_indices : other_column_indices;
+        auto & field_names = is_prewhere_column ? prewhere_field_names : other_field_names;
+        indices.push_back(column_indices[i]);
+        if (field_names.empty() || field_names.back() != column_names[i])
+            field_names.push_back(column_names[i]);
+    }
+}
+
+size_t ArrowParquetBlockInputFormat::evaluatePrewhere(int row_group)
+{
+    std::shared_ptr<arrow::Table> table;
+    auto read_status = file_reader->ReadRowGroup(row_group, prewhere_column_indices, &table);
+    if (!read_status.ok())
+        throw std::runtime_error{"Error while reading Parquet data: " + read_status.ToString()};
+    if (format_settings.use_lowercase_column_name)
+        table = *table->RenameColumns(prewhere_field_names);
+
+    DB::Chunk chunk;
+    prewhere_column_to_ch_column->arrowTableToCHChunk(chunk, table);
+    size_t rows = chunk.getNumRows();
+    row_group_columns = chunk.detachColumns();
+    auto block = prewhere_header.cloneWithColumns(row_group_columns);
+    prewhere->actions->execute(block, rows);
+
+    auto filter_column = block.getByName(prewhere->column_name).column->convertToFullColumnIfConst();
+    DB::FilterDescription filter_description(*filter_column);
+    row_group_filter.assign(filter_description.data->begin(), filter_description.data->end());
+    size_t passed_rows = DB::countBytesInFilter(row_group_filter);
+    if (!passed_rows && prewhere->read_stats)
+        ++prewhere->read_stats->skipped_row_groups;
+    return passed_rows;
+}
+
 }
 
 #endif
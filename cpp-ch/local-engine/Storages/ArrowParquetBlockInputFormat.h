@@ -5,7 +5,10 @@
 
 #if USE_PARQUET && USE_LOCAL_FORMATS
 // clang-format off
+#include <optional>
+#include <Columns/IColumn.h>
 #include <Common/ChunkBuffer.h>
+#include <Interpreters/ExpressionActions.h>
 #include "ch_parquet/OptimizedArrowColumnToCHColumn.h"
 #include "ch_parquet/OptimizedParquetBlockInputFormat.h"
 #include "ch_parquet/arrow/reader.h"
@@ -18,6 +21,17 @@ class Table;
 
 namespace local_engine
 {
+struct FileReadStats;
+
+/// A filter over some columns of the file, evaluated on them alone before the other columns are read.
+struct ParquetPrewhere
+{
+    DB::ExpressionActionsPtr actions;
+    String column_name;
+    /// Counts the row groups no row of which passes as skipped.
+    std::shared_ptr<FileReadStats> read_stats;
+};
+
 class ArrowParquetBlockInputFormat : public DB::OptimizedParquetBlockInputFormat
 {
 public:
@@ -25,15 +39,43 @@ public:
         DB::ReadBuffer & in,
         const DB::Block & header,
         const DB::FormatSettings & formatSettings,
-        const std::vector<int> & row_group_indices_ = {});
+        const std::vector<int> & row_group_indices_ = {},
+        std::shared_ptr<parquet::FileMetaData> metadata_ = nullptr,
+        std::optional<ParquetPrewhere> prewhere_ = {});
 
 private:
     DB::Chunk generate() override;
 
+    /// With a prewhere, each row group is read on its own: the prewhere columns first, the others only if some of its
+    /// rows pass. The chunks are the decoded prewhere columns along with the others, filtered by the rows that passed.
+    DB::Chunk generateWithPrewhere();
+    /// Decodes the prewhere columns of a row group into row_group_columns and evaluates the prewhere on them into
+    /// row_group_filter, returns the number of passing rows.
+    size_t evaluatePrewhere(int row_group);
+    void preparePrewhere();
+    /// Puts rows rows of the prewhere columns from row_group_offset on and other_columns in the order of the header, and
+    /// filters them.
+    DB::Chunk assembleChunk(DB::Columns other_columns, size_t rows);
+
     int64_t convert_time = 0;
     int64_t non_convert_time = 0;
     std::shared_ptr<arrow::RecordBatchReader> current_record_batch_reader;
     std::vector<int> row_group_indices;
+
+    std::optional<ParquetPrewhere> prewhere;
+    DB::Block prewhere_header;
+    std::vector<int> prewhere_column_indices;
+    std::vector<String> prewhere_field_names;
+    std::unique_ptr<DB::OptimizedArrowColumnToCHColumn> prewhere_column_to_ch_column;
+    /// The columns of the header the prewhere doesn't need, read only from the row groups some rows of which pass.
+    DB::Block other_header;
+    std::vector<int> other_column_indices;
+    std::vector<String> other_field_names;
+    std::unique_ptr<DB::OptimizedArrowColumnToCHColumn> other_column_to_ch_column;
+    size_t next_row_group = 0;
+    DB::Columns row_group_columns;
+    DB::IColumn::Filter row_group_filter;
+    size_t row_group_offset = 0;
 };
 
 }
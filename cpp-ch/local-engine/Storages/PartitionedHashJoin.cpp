@@ -0,0 +1,136 @@
+#include "PartitionedHashJoin.h"
+
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnSparse.h>
+#include <Common/Exception.h>
+#include <Common/WeakHash.h>
+#include <DataTypes/DataTypeLowCardinality.h>
+#include <Interpreters/TableJoin.h>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+    extern const int LOGICAL_ERROR;
+    extern const int NOT_IMPLEMENTED;
+}
+}
+
+using namespace DB;
+
+namespace local_engine
+{
+
+Blocks scatterByKeys(const Block & block, const Names & key_names, size_t partitions)
+{
+    size_t rows = block.rows();
+    WeakHash32 hash(rows);
+    for (const auto & key_name : key_names)
+    {
+        auto column = recursiveRemoveLowCardinality(recursiveRemoveSparse(block.getByName(key_name).column->convertToFullColumnIfConst()));
+        if (const auto * nullable = checkAndGetColumn<ColumnNullable>(*column))
+            column = nullable->getNestedColumnPtr();
+        column->updateWeakHash32(hash);
+    }
+
+    /// HashJoin hashes the keys with the same CRC32 family, whose low bits would then be equal for every key of a
+    /// partition. Take the partition from the high bits instead.
+    IColumn::Selector selector(rows);
+    const auto & hash_data = hash.getData();
+    for (size_t i = 0; i < rows; ++i)
+        selector[i] = (static_cast<UInt64>(hash_data[i]) * partitions) >> 32;
+
+    Blocks result(partitions);
+    for (auto & partition : result)
+        partition = block.cloneEmpty();
+    for (size_t col = 0; col < block.columns(); ++col)
+    {
+        auto scattered = block.getByPosition(col).column->scatter(partitions, selector);
+        for (size_t i = 0; i < partitions; ++i)
+            result[i].getByPosition(col).column = std::move(scattered[i]);
+    }
+    return result;
+}
+
+PartitionedHashJoin::PartitionedHashJoin(std::shared_ptr<TableJoin> table_join_, std::vector<HashJoinPtr> partitions_)
+    : table_join(std::move(table_join_)), partitions(std::move(partitions_))
+{
+    if (partitions.empty())
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "PartitionedHashJoin needs at least one partition");
+    if (table_join->getClauses().size() != 1)
+        throw Exception(ErrorCodes::NOT_IMPLEMENTED, "PartitionedHashJoin supports a single join clause only");
+    if (isRightOrFull(table_join->kind()))
+        throw Exception(ErrorCodes::NOT_IMPLEMENTED, "PartitionedHashJoin doesn't support {} join", toString(table_join->kind()));
+}
+
+bool PartitionedHashJoin::addBlockToJoin(const Block &, bool)
+{
+    throw Exception(ErrorCodes::LOGICAL_ERROR, "PartitionedHashJoin is built before it is used");
+}
+
+void PartitionedHashJoin::checkTypesOfKeys(const Block & block) const
+{
+    partitions.front()->checkTypesOfKeys(block);
+}
+
+void PartitionedHashJoin::joinBlock(Block & block, std::shared_ptr<ExtraBlock> & not_processed)
+{
+    if (!block.rows())
+    {
+        partitions.front()->joinBlock(block, not_processed);
+        return;
+    }
+
+    auto dispatched = scatterByKeys(block, table_join->getOnlyClause().key_names_left, partitions.size());
+    Blocks results;
+    for (size_t i = 0; i < partitions.size(); ++i)
+    {
+        if (!dispatched[i].rows())
+            continue;
+        /// Rows that don't fit into one output block are joined right away, there is no way to resume a partition.
+        std::shared_ptr<ExtraBlock> remaining;
+        partitions[i]->joinBlock(dispatched[i], remaining);
+        results.emplace_back(std::move(dispatched[i]));
+        while (remaining && !remaining->empty())
+        {
+            Block next = std::move(remaining->block);
+            remaining.reset();
+            partitions[i]->joinBlock(next, remaining);
+            results.emplace_back(std::move(next));
+        }
+    }
+    block = concatenateBlocks(results);
+}
+
+size_t PartitionedHashJoin::getTotalRowCount() const
+{
+    size_t res = 0;
+    for (const auto & partition : partitions)
+        res += partition->getTotalRowCount();
+    return res;
+}
+
+size_t PartitionedHashJoin::getTotalByteCount() const
+{
+    size_t res = 0;
+    for (const auto & partition : partitions)
+        res += partition->getTotalByteCount();
+    return res;
+}
+
+bool PartitionedHashJoin::alwaysReturnsEmptySet() const
+{
+    for (const auto & partition : partitions)
+    {
+        if (!partition->alwaysReturnsEmptySet())
+            return false;
+    }
+    return true;
+}
+
+IBlocksStreamPtr PartitionedHashJoin::getNonJoinedBlocks(const Block &, const Block &, UInt64) const
+{
+    /// Only RIGHT and FULL joins emit non-joined rows, they are rejected in the constructor.
+    return nullptr;
+}
+}
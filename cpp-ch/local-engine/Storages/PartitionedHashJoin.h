@@ -0,0 +1,36 @@
+#pragma once
+#include <Interpreters/HashJoin.h>
+#include <Interpreters/IJoin.h>
+
+namespace local_engine
+{
+
+/// Splits the rows of block into partitions by the hash of the key columns. Nullable and LowCardinality keys hash
+/// like their nested values, so the build and the probe side agree whenever HashJoin accepts their key types.
+DB::Blocks scatterByKeys(const DB::Block & block, const DB::Names & key_names, size_t partitions);
+
+/// A hash join whose right side is split into HashJoins by the hash of the join keys, so that they can be built by
+/// several threads. Probing dispatches each left block the same way and concatenates the results.
+class PartitionedHashJoin : public DB::IJoin
+{
+public:
+    PartitionedHashJoin(std::shared_ptr<DB::TableJoin> table_join_, std::vector<DB::HashJoinPtr> partitions_);
+
+    std::string getName() const override { return "PartitionedHashJoin"; }
+    const DB::TableJoin & getTableJoin() const override { return *table_join; }
+    bool addBlockToJoin(const DB::Block & block, bool check_limits) override;
+    void checkTypesOfKeys(const DB::Block & block) const override;
+    void joinBlock(DB::Block & block, std::shared_ptr<DB::ExtraBlock> & not_processed) override;
+    size_t getTotalRowCount() const override;
+    size_t getTotalByteCount() const override;
+    bool alwaysReturnsEmptySet() const override;
+    bool isFilled() const override { return true; }
+    bool supportTotals() const override { return false; }
+    DB::IBlocksStreamPtr
+    getNonJoinedBlocks(const DB::Block & left_sample_block, const DB::Block & result_sample_block, UInt64 max_block_size) const override;
+
+private:
+    std::shared_ptr<DB::TableJoin> table_join;
+    std::vector<DB::HashJoinPtr> partitions;
+};
+}
@@ -1,11 +1,18 @@
 #include "StorageJoinFromReadBuffer.h"
 
+#include <condition_variable>
 #include <Formats/NativeReader.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/HashJoin.h>
 #include <Interpreters/TableJoin.h>
 #include <QueryPipeline/ProfileInfo.h>
+#include <Storages/PartitionedHashJoin.h>
+#include <base/scope_guard.h>
+#include <Common/ConcurrentBoundedQueue.h>
 #include <Common/Exception.h>
+#include <Common/Stopwatch.h>
+#include <Common/ThreadPool.h>
+#include <Common/logger_useful.h>
 
 namespace DB
 {
@@ -33,17 +40,134 @@ void StorageJoinFromReadBuffer::restore()
     }
     ContextPtr ctx = nullptr;
     NativeReader block_stream(*in, 0);
+    Stopwatch watch;
 
-    ProfileInfo info;
+    if (joins.size() > 1)
     {
+        restoreInParallel(block_stream);
+    }
+    else
+    {
+        ProfileInfo info;
         while (Block block = block_stream.read())
         {
             auto final_block = sample_block.cloneWithColumns(block.mutateColumns());
             info.update(final_block);
-            join->addBlockToJoin(final_block, true);
+            joins.front()->addBlockToJoin(final_block, true);
         }
     }
     in.reset();
+
+    size_t rows = 0;
+    for (const auto & join : joins)
+        rows += join->getTotalRowCount();
+    LOG_INFO(
+        &Poco::Logger::get("StorageJoinFromReadBuffer"),
+        "Built hash table {} of {} rows with {} threads in {} ms",
+        storage_metadata_.comment,
+        rows,
+        joins.size(),
+        watch.elapsedMilliseconds());
+}
+
+void StorageJoinFromReadBuffer::restoreInParallel(NativeReader & block_stream)
+{
+    /// The calling thread reads the blocks, the build threads split them by key hash and insert the parts into the
+    /// partition joins. A partition is filled by one thread at a time, a thread whose partitions are all busy waits
+    /// until one is released.
+    ConcurrentBoundedQueue<Block> queue(build_threads * 2);
+    std::mutex partitions_mutex;
+    std::condition_variable partition_released;
+    std::vector<bool> partition_busy(joins.size(), false);
+    std::vector<size_t> thread_rows(build_threads, 0);
+    std::mutex exception_mutex;
+    std::exception_ptr first_exception;
+
+    auto build = [&](size_t thread_id)
+    {
+        try
+        {
+            Block block;
+            while (queue.pop(block))
+            {
+                thread_rows[thread_id] += block.rows();
+                auto parts = scatterByKeys(block, key_names, joins.size());
+                std::vector<size_t> pending;
+                for (size_t i = 0; i < parts.size(); ++i)
+                {
+                    if (parts[i].rows())
+                        pending.push_back(i);
+                }
+                while (!pending.empty())
+                {
+                    size_t partition;
+                    {
+                        std::unique_lock lock(partitions_mutex);
+                        auto it = pending.end();
+                        partition_released.wait(
+                            lock,
+                            [&]
+                            {
+                                it = std::find_if(pending.begin(), pending.end(), [&](size_t i) { return !partition_busy[i]; });
+                                return it != pending.end();
+                            });
+                        partition = *it;
+                        pending.erase(it);
+                        partition_busy[partition] = true;
+                    }
+                    SCOPE_EXIT({
+                        {
+                            std::lock_guard lock(partitions_mutex);
+                            partition_busy[partition] = false;
+                        }
+                        partition_released.notify_all();
+                    });
+                    joins[partition]->addBlockToJoin(parts[partition], true);
+                }
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard lock(exception_mutex);
+            if (!first_exception)
+                first_exception = std::current_exception();
+            queue.clearAndFinish();
+        }
+    };
+
+    std::vector<ThreadFromGlobalPool> threads;
+    threads.reserve(build_threads);
+    try
+    {
+        for (size_t i = 0; i < build_threads; ++i)
+            threads.emplace_back(build, i);
+        while (Block block = block_stream.read())
+        {
+            if (!queue.push(sample_block.cloneWithColumns(block.mutateColumns())))
+                break;
+        }
+        queue.finish();
+    }
+    catch (...)
+    {
+        queue.clearAndFinish();
+        for (auto & thread : threads)
+            thread.join();
+        throw;
+    }
+    for (auto & thread : threads)
+        thread.join();
+    if (first_exception)
+        std::rethrow_exception(first_exception);
+
+    String rows_per_thread;
+    for (auto rows : thread_rows)
+        rows_per_thread += (rows_per_thread.empty() ? "" : ", ") + std::to_string(rows);
+    LOG_DEBUG(
+        &Poco::Logger::get("StorageJoinFromReadBuffer"),
+        "Rows read by each build thread of {}: {}",
+        storage_metadata_.comment,
+        rows_per_thread);
 }
 
 StorageJoinFromReadBuffer::StorageJoinFromReadBuffer(
@@ -56,13 +180,15 @@ StorageJoinFromReadBuffer::StorageJoinFromReadBuffer(
     const ColumnsDescription & columns_,
     const ConstraintsDescription & constraints_,
     const String & comment,
-    const bool overwrite_)
+    const bool overwrite_,
+    size_t build_threads_)
     : key_names(key_names_)
     , use_nulls(use_nulls_)
     , limits(limits_)
     , kind(kind_)
     , strictness(strictness_)
     , overwrite(overwrite_)
+    , build_threads(std::max<size_t>(build_threads_, 1))
     , in(std::move(in_))
 {
     storage_metadata_.setColumns(columns_);
@@ -75,11 +201,12 @@ StorageJoinFromReadBuffer::StorageJoinFromReadBuffer(
             throw Exception(ErrorCodes::NO_SUCH_COLUMN_IN_TABLE, "Key column ({}) does not exist in table declaration.", key);
 
     table_join = std::make_shared<TableJoin>(limits, use_nulls, kind, strictness, key_names);
-    join = std::make_shared<HashJoin>(table_join, getRightSampleBlock(), overwrite);
+    for (size_t i = 0; i < build_threads; ++i)
+        joins.emplace_back(std::make_shared<HashJoin>(table_join, getRightSampleBlock(), overwrite));
     restore();
 }
 
-DB::HashJoinPtr StorageJoinFromReadBuffer::getJoinLocked(std::shared_ptr<DB::TableJoin> analyzed_join, DB::ContextPtr /*context*/) const
+DB::JoinPtr StorageJoinFromReadBuffer::getJoinLocked(std::shared_ptr<DB::TableJoin> analyzed_join, DB::ContextPtr /*context*/) const
 {
     if (!analyzed_join->sameStrictnessAndKind(strictness, kind))
         throw Exception(ErrorCodes::INCOMPATIBLE_TYPE_OF_JOIN, "Table {} has incompatible type of JOIN.", storage_metadata_.comment);
@@ -98,9 +225,15 @@ DB::HashJoinPtr StorageJoinFromReadBuffer::getJoinLocked(std::shared_ptr<DB::Tab
     /// Qualifies will be added by join implementation (HashJoin)
     analyzed_join->setRightKeys(key_names);
 
-    HashJoinPtr join_clone = std::make_shared<HashJoin>(analyzed_join, getRightSampleBlock());
-    join_clone->reuseJoinedData(*join);
-
-    return join_clone;
+    std::vector<HashJoinPtr> join_clones;
+    for (const auto & join : joins)
+    {
+        HashJoinPtr join_clone = std::make_shared<HashJoin>(analyzed_join, getRightSampleBlock());
+        join_clone->reuseJoinedData(*join);
+        join_clones.emplace_back(std::move(join_clone));
+    }
+    if (join_clones.size() == 1)
+        return join_clones.front();
+    return std::make_shared<PartitionedHashJoin>(analyzed_join, std::move(join_clones));
 }
 }
@@ -1,9 +1,11 @@
 #pragma once
+#include <Interpreters/IJoin.h>
 #include <Interpreters/JoinUtils.h>
 #include <Storages/StorageInMemoryMetadata.h>
 
 namespace DB
 {
+class NativeReader;
 class TableJoin;
 class HashJoin;
 using HashJoinPtr = std::shared_ptr<HashJoin>;
@@ -25,9 +27,11 @@ public:
         const DB::ColumnsDescription & columns_,
         const DB::ConstraintsDescription & constraints_,
         const String & comment,
-        bool overwrite_);
+        bool overwrite_,
+        size_t build_threads_ = 1);
 
-    DB::HashJoinPtr getJoinLocked(std::shared_ptr<DB::TableJoin> analyzed_join, DB::ContextPtr context) const;
+    /// A PartitionedHashJoin if the table was built by several threads, a HashJoin otherwise.
+    DB::JoinPtr getJoinLocked(std::shared_ptr<DB::TableJoin> analyzed_join, DB::ContextPtr context) const;
     DB::Block getRightSampleBlock() const
     {
         DB::Block block = storage_metadata_.getSampleBlock();
@@ -43,6 +47,7 @@ public:
 
 protected:
     void restore();
+    void restoreInParallel(DB::NativeReader & block_stream);
 
 private:
     DB::StorageInMemoryMetadata storage_metadata_;
@@ -53,9 +58,11 @@ private:
     DB::JoinKind kind; /// LEFT | INNER ...
     DB::JoinStrictness strictness; /// ANY | ALL
     bool overwrite;
+    size_t build_threads;
 
     std::shared_ptr<DB::TableJoin> table_join;
-    DB::HashJoinPtr join;
+    /// One HashJoin, or one per build thread holding the rows whose keys hash to it, see scatterByKeys.
+    std::vector<DB::HashJoinPtr> joins;
 
     std::unique_ptr<DB::ReadBuffer> in;
 };
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <base/types.h>
+
+namespace local_engine
+{
+/// LRU cache of parsed file footers, shared by all the tasks of the process, so that the splits of a file and repeated
+/// scans of it don't read and parse its footer again. Keys carry the size and modification time of the file, a
+/// rewritten file gets a new key and its stale entry ages out.
+template <typename Metadata>
+class FileMetaCache
+{
+public:
+    using MetadataPtr = std::shared_ptr<Metadata>;
+
+    /// max_bytes_ bounds the sum of the weights of the entries, 0 disables the cache.
+    explicit FileMetaCache(size_t max_bytes_) : max_bytes(max_bytes_) { }
+
+    /// Returns the metadata cached for key, or the one returned by load(), whose size is weight(metadata).
+    template <typename Load, typename Weight>
+    MetadataPtr getOrLoad(const String & key, Load && load, Weight && weight, bool & hit)
+    {
+        {
+            std::lock_guard lock(mutex);
+            if (auto it = entries.find(key); it != entries.end())
+            {
+                lru.splice(lru.end(), lru, it->second.position);
+                hit = true;
+                return it->second.metadata;
+            }
+        }
+
+        /// Concurrent misses of one file may load it more than once, but a slow load doesn't block other files.
+        hit = false;
+        MetadataPtr metadata = load();
+        size_t bytes = weight(*metadata);
+        if (bytes > max_bytes)
+            return metadata;
+
+        std::lock_guard lock(mutex);
+        auto [it, inserted] = entries.try_emplace(key);
+        if (!inserted)
+            return it->second.metadata;
+        it->second = Entry{metadata, bytes, lru.insert(lru.end(), key)};
+        current_bytes += bytes;
+        while (current_bytes > max_bytes)
+        {
+            auto evicted = entries.find(lru.front());
+            current_bytes -= evicted->second.bytes;
+            entries.erase(evicted);
+            lru.pop_front();
+        }
+        return metadata;
+    }
+
+private:
+    struct Entry
+    {
+        MetadataPtr metadata;
+        size_t bytes = 0;
+        std::list<String>::iterator position;
+    };
+
+    const size_t max_bytes;
+    std::mutex mutex;
+    std::list<String> lru;
+    std::unordered_map<String, Entry> entries;
+    size_t current_bytes = 0;
+};
+}
@@ -31,7 +31,7 @@ namespace local_engine
 {
 FormatFile::FormatFile(
     DB::ContextPtr context_, const substrait::ReadRel::LocalFiles::FileOrFiles & file_info_, ReadBufferBuilderPtr read_buffer_builder_)
-    : context(context_), file_info(file_info_), read_buffer_builder(read_buffer_builder_)
+    : context(context_), file_info(file_info_), read_buffer_builder(read_buffer_builder_), read_stats(std::make_shared<FileReadStats>())
 {
     PartitionValues part_vals = StringUtils::parsePartitionTablePath(file_info.uri_file());
     for (const auto & part : part_vals)
@@ -41,6 +41,30 @@ FormatFile::FormatFile(
     }
 }
 
+const std::optional<String> & FormatFile::getMetaCacheKey()
+{
+    std::call_once(
+        meta_cache_key_flag,
+        [&]
+        {
+            /// Without the size and modification time the footer is read from the file and not cached.
+            try
+            {
+                if (auto stat = read_buffer_builder->getFileStat(file_info))
+                    meta_cache_key = fmt::format("{}:{}:{}", file_info.uri_file(), stat->size, stat->modification_time);
+            }
+            catch (...)
+            {
+                LOG_WARNING(
+                    &Poco::Logger::get("FormatFile"),
+                    "Failed to stat {}, its footer isn't cached: {}",
+                    file_info.uri_file(),
+                    DB::getCurrentExceptionMessage(false));
+            }
+        });
+    return meta_cache_key;
+}
+
 FormatFilePtr FormatFileUtil::createFile(
     DB::ContextPtr context, ReadBufferBuilderPtr read_buffer_builder, const substrait::ReadRel::LocalFiles::FileOrFiles & file)
 {
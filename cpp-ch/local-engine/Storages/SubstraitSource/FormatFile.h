@@ -1,18 +1,49 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <vector>
 
 #include <Core/Block.h>
 #include <IO/ReadBuffer.h>
 #include <Interpreters/Context.h>
+#include <Interpreters/ExpressionActions.h>
 #include <Processors/Formats/IInputFormat.h>
 #include <Storages/SubstraitSource/ReadBufferBuilder.h>
 #include <substrait/plan.pb.h>
 
+namespace DB
+{
+class KeyCondition;
+}
+
 namespace local_engine
 {
+/// Filter of a scan, checked by the files against their statistics.
+struct FileFilter
+{
+    std::shared_ptr<const DB::KeyCondition> key_condition;
+    /// Columns of key_condition, in the order of its keys.
+    DB::Block key_header;
+    /// The filter as an expression over the columns of the scan, evaluated by the formats that can read the columns it
+    /// needs ahead of the others. Its result is prewhere_column_name. Built once by the source and shared by its files.
+    DB::ExpressionActionsPtr prewhere_actions;
+    String prewhere_column_name;
+};
+using FileFilterPtr = std::shared_ptr<FileFilter>;
+
+/// Counters of the files of one source, reported in RelMetric.
+struct FileReadStats
+{
+    std::atomic<size_t> total_row_groups = 0;
+    std::atomic<size_t> skipped_row_groups = 0;
+    std::atomic<size_t> metadata_cache_hits = 0;
+    std::atomic<size_t> metadata_cache_misses = 0;
+};
+using FileReadStatsPtr = std::shared_ptr<FileReadStats>;
+
 class FormatFile
 {
 public:
@@ -48,12 +79,26 @@ public:
     virtual size_t getStartOffset() const { return file_info.start(); }
     virtual size_t getLength() const { return file_info.length(); }
 
+    /// Formats with statistics may skip the parts of the file where no row can match the filter.
+    void setFilter(FileFilterPtr filter_) { filter = std::move(filter_); }
+
+    void setReadStats(FileReadStatsPtr read_stats_) { read_stats = std::move(read_stats_); }
+
 protected:
+    /// Key of the file in the footer caches, nullopt if its size and modification time are unknown.
+    const std::optional<String> & getMetaCacheKey();
+
     DB::ContextPtr context;
     substrait::ReadRel::LocalFiles::FileOrFiles file_info;
     ReadBufferBuilderPtr read_buffer_builder;
     std::vector<String> partition_keys;
     std::map<String, String> partition_values;
+    FileFilterPtr filter;
+    FileReadStatsPtr read_stats;
+
+private:
+    std::once_flag meta_cache_key_flag;
+    std::optional<String> meta_cache_key;
 };
 using FormatFilePtr = std::shared_ptr<FormatFile>;
 using FormatFiles = std::vector<FormatFilePtr>;
@@ -5,6 +5,7 @@
 #include <Formats/FormatFactory.h>
 #include <IO/SeekableReadBuffer.h>
 #include <Processors/Formats/Impl/ArrowBufferedStreams.h>
+#include <Storages/SubstraitSource/FileMetaCache.h>
 #include <Storages/SubstraitSource/OrcUtil.h>
 
 #if USE_LOCAL_FORMATS
@@ -224,40 +225,76 @@ std::optional<size_t> OrcFormatFile::getTotalRows()
 
 std::vector<StripeInformation> OrcFormatFile::collectRequiredStripes(UInt64 & total_stripes)
 {
-    auto in = read_buffer_builder->build(file_info);
-    return collectRequiredStripes(in.get(), total_stripes);
+    return collectRequiredStripes(nullptr, total_stripes);
 }
 
-std::vector<StripeInformation> OrcFormatFile::collectRequiredStripes(DB::ReadBuffer * read_buffer, UInt64 & total_stripes)
+static FileMetaCache<std::vector<StripeInformation>> & getMetaCache(const DB::ContextPtr & context)
 {
-    DB::FormatSettings format_settings{
-        .seekable_read = true,
-    };
-    std::atomic<int> is_stopped{0};
-    auto arrow_file = DB::asArrowFile(*read_buffer, format_settings, is_stopped, "ORC", ORC_MAGIC_BYTES);
-    auto orc_reader = OrcUtil::createOrcReader(arrow_file);
-    total_stripes = orc_reader->getNumberOfStripes();
+    static FileMetaCache<std::vector<StripeInformation>> cache(context->getConfigRef().getUInt64("file_meta_cache.max_size", 256UL << 20));
+    return cache;
+}
 
-    size_t total_num_rows = 0;
-    std::vector<StripeInformation> stripes;
-    stripes.reserve(total_stripes);
-    for (size_t i = 0; i < total_stripes; ++i)
+std::shared_ptr<std::vector<StripeInformation>> OrcFormatFile::readStripes(DB::ReadBuffer * read_buffer)
+{
+    auto load = [&]
     {
-        auto stripe_metadata = orc_reader->getStripe(i);
-
-        auto offset = stripe_metadata->getOffset();
-        if (file_info.start() <= offset && offset < file_info.start() + file_info.length())
+        std::unique_ptr<DB::ReadBuffer> in;
+        if (!read_buffer)
         {
+            in = read_buffer_builder->build(file_info);
+            read_buffer = in.get();
+        }
+        DB::FormatSettings format_settings{
+            .seekable_read = true,
+        };
+        std::atomic<int> is_stopped{0};
+        auto arrow_file = DB::asArrowFile(*read_buffer, format_settings, is_stopped, "ORC", ORC_MAGIC_BYTES);
+        auto orc_reader = OrcUtil::createOrcReader(arrow_file);
+        size_t total_stripes = orc_reader->getNumberOfStripes();
+
+        size_t total_num_rows = 0;
+        auto stripes = std::make_shared<std::vector<StripeInformation>>();
+        stripes->reserve(total_stripes);
+        for (size_t i = 0; i < total_stripes; ++i)
+        {
+            auto stripe_metadata = orc_reader->getStripe(i);
+
             StripeInformation stripe_info;
             stripe_info.index = i;
-            stripe_info.offset = stripe_metadata->getLength();
+            stripe_info.offset = stripe_metadata->getOffset();
             stripe_info.length = stripe_metadata->getLength();
             stripe_info.num_rows = stripe_metadata->getNumberOfRows();
             stripe_info.start_row = total_num_rows;
-            stripes.emplace_back(stripe_info);
+            stripes->emplace_back(stripe_info);
+
+            total_num_rows += stripe_metadata->getNumberOfRows();
         }
+        return stripes;
+    };
 
-        total_num_rows += stripe_metadata->getNumberOfRows();
+    const auto & key = getMetaCacheKey();
+    if (!key)
+    {
+        ++read_stats->metadata_cache_misses;
+        return load();
+    }
+    bool hit = false;
+    auto stripes = getMetaCache(context).getOrLoad(
+        *key, load, [](const std::vector<StripeInformation> & all) { return all.size() * sizeof(StripeInformation); }, hit);
+    ++(hit ? read_stats->metadata_cache_hits : read_stats->metadata_cache_misses);
+    return stripes;
+}
+
+std::vector<StripeInformation> OrcFormatFile::collectRequiredStripes(DB::ReadBuffer * read_buffer, UInt64 & total_stripes)
+{
+    auto all_stripes = readStripes(read_buffer);
+    total_stripes = all_stripes->size();
+
+    std::vector<StripeInformation> stripes;
+    for (const auto & stripe_info : *all_stripes)
+    {
+        if (file_info.start() <= stripe_info.offset && stripe_info.offset < file_info.start() + file_info.length())
+            stripes.emplace_back(stripe_info);
     }
     return stripes;
 }
@@ -101,6 +101,9 @@ private:
 
     std::vector<StripeInformation> collectRequiredStripes(UInt64 & total_stripes);
     std::vector<StripeInformation> collectRequiredStripes(DB::ReadBuffer * read_buffer, UInt64 & total_strpes);
+
+    /// All the stripes of the file from the process-wide cache, or read from read_buffer, or from a new one if it's nullptr.
+    std::shared_ptr<std::vector<StripeInformation>> readStripes(DB::ReadBuffer * read_buffer);
 };
 }
 
@@ -6,12 +6,16 @@
 #include <string>
 #include <utility>
 
-#include <parquet/arrow/reader.h>
+#include <parquet/file_reader.h>
+#include <parquet/statistics.h>
 #include <Common/Config.h>
+#include <DataTypes/DataTypeNullable.h>
 #include <Formats/FormatFactory.h>
 #include <Formats/FormatSettings.h>
 #include <IO/SeekableReadBuffer.h>
 #include <Storages/ArrowParquetBlockInputFormat.h>
+#include <Storages/MergeTree/KeyCondition.h>
+#include <Storages/SubstraitSource/FileMetaCache.h>
 #include <Processors/Formats/Impl/ArrowBufferedStreams.h>
 #include <Processors/Formats/Impl/ParquetBlockInputFormat.h>
 #include <Processors/Formats/Impl/ArrowColumnToCHColumn.h>
@@ -33,6 +37,35 @@ ParquetFormatFile::ParquetFormatFile(
 {
 }
 
+// clang-format off
+#if USE_LOCAL_FORMATS
+// clang-format on
+/// The filter can be evaluated ahead of the other columns only if all the columns it needs are read from the file.
+/// It is off by default, the filter step following the scan evaluates the filter again on the rows that pass, which
+/// only pays off for selective filters. A non-deterministic filter, like rand() or a row position, would give a row
+/// another result there than in the prewhere, it's left to the filter step.
+static std::optional<ParquetPrewhere>
+getPrewhere(const DB::ContextPtr & context, const FileFilterPtr & filter, const DB::Block & header, const FileReadStatsPtr & read_stats)
+{
+    if (!filter || !filter->prewhere_actions || !context->getConfigRef().getBool("parquet.prewhere.enabled", false))
+        return {};
+    for (const auto & node : filter->prewhere_actions->getActionsDAG().getNodes())
+    {
+        if (node.type == DB::ActionsDAG::ActionType::FUNCTION && node.function_base && !node.function_base->isDeterministic())
+            return {};
+    }
+    for (const auto & input : filter->prewhere_actions->getRequiredColumnsWithTypes())
+    {
+        const auto * column = header.findByName(input.name);
+        if (!column || !column->type->equals(*input.type))
+            return {};
+    }
+    return ParquetPrewhere{filter->prewhere_actions, filter->prewhere_column_name, read_stats};
+}
+// clang-format off
+#endif
+// clang-format on
+
 FormatFile::InputFormatPtr ParquetFormatFile::createInputFormat(const DB::Block & header)
 {
     auto res = std::make_shared<FormatFile::InputFormat>();
@@ -40,15 +73,17 @@ FormatFile::InputFormatPtr ParquetFormatFile::createInputFormat(const DB::Block
 
     std::vector<RowGroupInfomation> required_row_groups;
     [[maybe_unused]] int total_row_groups = 0;
-    if (auto * seekable_in = dynamic_cast<DB::SeekableReadBuffer *>(res->read_buffer.get()))
-    {
-        // reuse the read_buffer to avoid opening the file twice.
-        // especially，the cost of opening a hdfs file is large.
-        required_row_groups = collectRequiredRowGroups(seekable_in, total_row_groups);
+    int split_row_groups = 0;
+    // reuse the read_buffer to avoid opening the file twice.
+    // especially，the cost of opening a hdfs file is large.
+    auto * seekable_in = dynamic_cast<DB::SeekableReadBuffer *>(res->read_buffer.get());
+    auto file_meta = readFileMetaData(seekable_in);
+    if (seekable_in)
         seekable_in->seek(0, SEEK_SET);
-    }
-    else
-        required_row_groups = collectRequiredRowGroups(total_row_groups);
+    required_row_groups = collectRequiredRowGroups(*file_meta, total_row_groups, split_row_groups);
+
+    read_stats->total_row_groups += split_row_groups;
+    read_stats->skipped_row_groups += split_row_groups - required_row_groups.size();
 
     auto format_settings = DB::getFormatSettings(context);
 // clang-format off
@@ -61,8 +96,8 @@ FormatFile::InputFormatPtr ParquetFormatFile::createInputFormat(const DB::Block
     for (const auto & row_group : required_row_groups)
         row_group_indices.emplace_back(row_group.index);
 
-    auto input_format
-        = std::make_shared<local_engine::ArrowParquetBlockInputFormat>(*(res->read_buffer), header, format_settings, row_group_indices);
+    auto input_format = std::make_shared<local_engine::ArrowParquetBlockInputFormat>(
+        *(res->read_buffer), header, format_settings, row_group_indices, file_meta, getPrewhere(context, filter, header, read_stats));
 // clang-format off
 #else
     // clang-format on
@@ -98,8 +133,9 @@ std::optional<size_t> ParquetFormatFile::getTotalRows()
             return total_rows;
     }
 
-    int _;
-    auto rowgroups = collectRequiredRowGroups(_);
+    int total_row_groups = 0;
+    int split_row_groups = 0;
+    auto rowgroups = collectRequiredRowGroups(total_row_groups, split_row_groups);
     size_t rows = 0;
     for (const auto & rowgroup : rowgroups)
         rows += rowgroup.num_rows;
@@ -111,32 +147,75 @@ std::optional<size_t> ParquetFormatFile::getTotalRows()
     }
 }
 
-std::vector<RowGroupInfomation> ParquetFormatFile::collectRequiredRowGroups(int & total_row_groups)
+std::vector<RowGroupInfomation> ParquetFormatFile::collectRequiredRowGroups(int & total_row_groups, int & split_row_groups)
+{
+    return collectRequiredRowGroups(*readFileMetaData(nullptr), total_row_groups, split_row_groups);
+}
+
+static FileMetaCache<parquet::FileMetaData> & getMetaCache(const DB::ContextPtr & context)
 {
-    auto in = read_buffer_builder->build(file_info);
-    return collectRequiredRowGroups(in.get(), total_row_groups);
+    static FileMetaCache<parquet::FileMetaData> cache(context->getConfigRef().getUInt64("file_meta_cache.max_size", 256UL << 20));
+    return cache;
 }
 
-std::vector<RowGroupInfomation> ParquetFormatFile::collectRequiredRowGroups(DB::ReadBuffer * read_buffer, int & total_row_groups)
+/// The parsed footer takes several times the size of the serialized one, mostly the thrift structures of the column
+/// chunks and the schema nodes, whose variable length parts are already counted by the serialized size.
+static size_t estimateMemoryUsage(const parquet::FileMetaData & meta)
 {
-    DB::FormatSettings format_settings{
-        .seekable_read = true,
+    static constexpr size_t column_chunk_bytes = 512;
+    static constexpr size_t schema_node_bytes = 256;
+    size_t num_columns = meta.num_columns();
+    return meta.size() + meta.num_row_groups() * num_columns * column_chunk_bytes + num_columns * schema_node_bytes;
+}
+
+std::shared_ptr<parquet::FileMetaData> ParquetFormatFile::readFileMetaData(DB::ReadBuffer * read_buffer)
+{
+    auto load = [&]
+    {
+        std::unique_ptr<DB::ReadBuffer> in;
+        if (!read_buffer)
+        {
+            in = read_buffer_builder->build(file_info);
+            read_buffer = in.get();
+        }
+        DB::FormatSettings format_settings{
+            .seekable_read = true,
+        };
+        std::atomic<int> is_stopped{0};
+        try
+        {
+            return parquet::ReadMetaData(asArrowFile(*read_buffer, format_settings, is_stopped, "Parquet", PARQUET_MAGIC_BYTES));
+        }
+        catch (const parquet::ParquetException & e)
+        {
+            throw DB::Exception(DB::ErrorCodes::BAD_ARGUMENTS, "Open file({}) failed. {}", file_info.uri_file(), e.what());
+        }
     };
-    std::atomic<int> is_stopped{0};
-    std::unique_ptr<parquet::arrow::FileReader> reader;
-    auto status = parquet::arrow::OpenFile(
-        asArrowFile(*read_buffer, format_settings, is_stopped, "Parquet", PARQUET_MAGIC_BYTES), arrow::default_memory_pool(), &reader);
-    if (!status.ok())
-        throw DB::Exception(DB::ErrorCodes::BAD_ARGUMENTS, "Open file({}) failed. {}", file_info.uri_file(), status.ToString());
 
-    auto file_meta = reader->parquet_reader()->metadata();
-    total_row_groups = file_meta->num_row_groups();
+    const auto & key = getMetaCacheKey();
+    if (!key)
+    {
+        ++read_stats->metadata_cache_misses;
+        return load();
+    }
+    bool hit = false;
+    auto file_meta = getMetaCache(context).getOrLoad(
+        *key, load, estimateMemoryUsage, hit);
+    ++(hit ? read_stats->metadata_cache_hits : read_stats->metadata_cache_misses);
+    return file_meta;
+}
 
+std::vector<RowGroupInfomation>
+ParquetFormatFile::collectRequiredRowGroups(const parquet::FileMetaData & file_meta, int & total_row_groups, int & split_row_groups)
+{
+    total_row_groups = file_meta.num_row_groups();
+
+    split_row_groups = 0;
     std::vector<RowGroupInfomation> row_group_metadatas;
     row_group_metadatas.reserve(total_row_groups);
     for (int i = 0; i < total_row_groups; ++i)
     {
-        auto row_group_meta = file_meta->RowGroup(i);
+        auto row_group_meta = file_meta.RowGroup(i);
 
         auto offset = static_cast<UInt64>(row_group_meta->file_offset());
         if (!offset)
@@ -145,6 +224,10 @@ std::vector<RowGroupInfomation> ParquetFormatFile::collectRequiredRowGroups(DB::
         /// Current row group has intersection with the required range.
         if (file_info.start() <= offset && offset < file_info.start() + file_info.length())
         {
+            ++split_row_groups;
+            if (filter && !mayMatchFilter(*row_group_meta))
+                continue;
+
             RowGroupInfomation info;
             info.index = i;
             info.num_rows = row_group_meta->num_rows();
@@ -156,5 +239,72 @@ std::vector<RowGroupInfomation> ParquetFormatFile::collectRequiredRowGroups(DB::
     }
     return row_group_metadatas;
 }
+
+/// The range of the values of a column chunk, as fields comparable with the values of type. Only the types whose order
+/// is the same in parquet and in ClickHouse are supported, floats are left out because of NaN.
+static std::optional<DB::Range> statisticsToRange(const parquet::ColumnChunkMetaData & column_chunk, const DB::DataTypePtr & type)
+{
+    if (!column_chunk.is_stats_set())
+        return {};
+    auto stats = column_chunk.statistics();
+    if (!stats || !stats->HasMinMax())
+        return {};
+
+    DB::WhichDataType which(DB::removeNullable(type));
+    auto sort_order = stats->descr()->sort_order();
+    DB::Field min;
+    DB::Field max;
+    switch (stats->physical_type())
+    {
+        case parquet::Type::INT32: {
+            if (!(which.isInt8() || which.isInt16() || which.isInt32() || which.isDate32()) || sort_order != parquet::SortOrder::SIGNED)
+                return {};
+            const auto & typed = static_cast<const parquet::Int32Statistics &>(*stats);
+            min = static_cast<Int64>(typed.min());
+            max = static_cast<Int64>(typed.max());
+            break;
+        }
+        case parquet::Type::INT64: {
+            if (!which.isInt64() || sort_order != parquet::SortOrder::SIGNED)
+                return {};
+            const auto & typed = static_cast<const parquet::Int64Statistics &>(*stats);
+            min = static_cast<Int64>(typed.min());
+            max = static_cast<Int64>(typed.max());
+            break;
+        }
+        case parquet::Type::BYTE_ARRAY: {
+            if (!which.isString() || sort_order != parquet::SortOrder::UNSIGNED)
+                return {};
+            const auto & typed = static_cast<const parquet::ByteArrayStatistics &>(*stats);
+            min = String(reinterpret_cast<const char *>(typed.min().ptr), typed.min().len);
+            max = String(reinterpret_cast<const char *>(typed.max().ptr), typed.max().len);
+            break;
+        }
+        default:
+            return {};
+    }
+
+    /// KeyCondition orders NULL after all the values.
+    if (type->isNullable() && (!stats->HasNullCount() || stats->null_count() > 0))
+        max = DB::PositiveInfinity{};
+    return DB::Range(min, true, max, true);
+}
+
+bool ParquetFormatFile::mayMatchFilter(const parquet::RowGroupMetaData & row_group_meta) const
+{
+    const auto * schema = row_group_meta.schema();
+    const auto & key_header = filter->key_header;
+    DB::Hyperrectangle hyperrectangle(key_header.columns(), DB::Range::createWholeUniverse());
+    for (size_t i = 0; i < key_header.columns(); ++i)
+    {
+        const auto & key = key_header.getByPosition(i);
+        int column_index = schema->ColumnIndex(key.name);
+        if (column_index < 0)
+            continue;
+        if (auto range = statisticsToRange(*row_group_meta.ColumnChunk(column_index), key.type))
+            hyperrectangle[i] = std::move(*range);
+    }
+    return filter->key_condition->checkInHyperrectangle(hyperrectangle, key_header.getDataTypes()).can_be_true;
+}
 }
 #endif
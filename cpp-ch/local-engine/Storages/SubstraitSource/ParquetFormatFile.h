@@ -8,6 +8,12 @@
 #include <IO/ReadBuffer.h>
 #include <Storages/SubstraitSource/FormatFile.h>
 // clang-format on
+namespace parquet
+{
+class FileMetaData;
+class RowGroupMetaData;
+}
+
 namespace local_engine
 {
 struct RowGroupInfomation
@@ -32,8 +38,16 @@ private:
     std::mutex mutex;
     std::optional<size_t> total_rows;
 
-    std::vector<RowGroupInfomation> collectRequiredRowGroups(int & total_row_groups);
-    std::vector<RowGroupInfomation> collectRequiredRowGroups(DB::ReadBuffer * read_buffer, int & total_row_groups);
+    /// split_row_groups is the number of row groups in the range of this split, including those skipped by the filter.
+    std::vector<RowGroupInfomation> collectRequiredRowGroups(int & total_row_groups, int & split_row_groups);
+    std::vector<RowGroupInfomation>
+    collectRequiredRowGroups(const parquet::FileMetaData & file_meta, int & total_row_groups, int & split_row_groups);
+
+    /// Footer of the file from the process-wide cache, or read from read_buffer, or from a new one if it's nullptr.
+    std::shared_ptr<parquet::FileMetaData> readFileMetaData(DB::ReadBuffer * read_buffer);
+
+    /// Checks the filter against the min/max statistics of the row group, false if no row of it can match.
+    bool mayMatchFilter(const parquet::RowGroupMetaData & row_group_meta) const;
 };
 
 }
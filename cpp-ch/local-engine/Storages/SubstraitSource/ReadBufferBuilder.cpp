@@ -70,6 +70,17 @@ public:
             read_buffer = std::make_unique<DB::ReadBufferFromFilePRead>(file_path);
         return read_buffer;
     }
+
+    std::optional<FileStat> getFileStat(const substrait::ReadRel::LocalFiles::FileOrFiles & file_info) override
+    {
+        Poco::URI file_uri(file_info.uri_file());
+        struct stat file_stat;
+        if (stat(file_uri.getPath().c_str(), &file_stat))
+            return {};
+        return FileStat{
+            .size = static_cast<size_t>(file_stat.st_size),
+            .modification_time = file_stat.st_mtim.tv_sec * 1000000000L + file_stat.st_mtim.tv_nsec};
+    }
 };
 
 #if USE_HDFS
@@ -116,6 +127,20 @@ public:
         return read_buffer;
     }
 
+    std::optional<FileStat> getFileStat(const substrait::ReadRel::LocalFiles::FileOrFiles & file_info) override
+    {
+        Poco::URI file_uri(file_info.uri_file());
+        std::string uri_path = "hdfs://" + file_uri.getHost();
+        if (file_uri.getPort())
+            uri_path += ":" + std::to_string(file_uri.getPort());
+
+        auto * hdfs_file_info = hdfsGetPathInfo(getFS(uri_path), file_uri.getPath().c_str());
+        if (!hdfs_file_info)
+            return {};
+        SCOPE_EXIT({ hdfsFreeFileInfo(hdfs_file_info, 1); });
+        return FileStat{.size = static_cast<size_t>(hdfs_file_info->mSize), .modification_time = hdfs_file_info->mLastMod};
+    }
+
     std::pair<size_t, size_t>
     adjustFileReadStartAndEndPos(size_t read_start_pos, size_t read_end_pos, std::string uri_path, std::string file_path)
     {
@@ -215,6 +240,32 @@ public:
         result.second = get_next_line_pos(fs.get(), fin, read_end_pos, hdfs_file_size);
         return result;
     }
+
+private:
+    struct Connection
+    {
+        DB::HDFSBuilderWrapper builder;
+        DB::HDFSFSPtr fs;
+    };
+
+    /// Files of a source may be looked up by several prefetching threads.
+    std::mutex connections_mutex;
+    std::map<std::string, Connection> connections;
+
+    /// Connecting to a namenode is expensive, the connection to each one is made once and reused by all the files of the
+    /// source on it.
+    hdfsFS getFS(const std::string & uri_path)
+    {
+        std::lock_guard lock(connections_mutex);
+        auto it = connections.find(uri_path);
+        if (it == connections.end())
+        {
+            auto builder = DB::createHDFSBuilder(uri_path + "/", context->getGlobalContext()->getConfigRef());
+            auto fs = DB::createHDFSFS(builder.get());
+            it = connections.emplace(uri_path, Connection{std::move(builder), std::move(fs)}).first;
+        }
+        return it->second.fs.get();
+    }
 };
 #endif
 
@@ -283,9 +334,20 @@ public:
         return async_reader;
     }
 
+    std::optional<FileStat> getFileStat(const substrait::ReadRel::LocalFiles::FileOrFiles & file_info) override
+    {
+        Poco::URI file_uri(file_info.uri_file());
+        std::string bucket = file_uri.getHost();
+        std::string key = file_uri.getPath().substr(1);
+        auto object_info = DB::S3::getObjectInfo(*getClient(bucket), bucket, key, "");
+        return FileStat{.size = object_info.size, .modification_time = object_info.last_modification_time};
+    }
+
 private:
     // TODO: currently every SubstraitFileSource will create its own ReadBufferBuilder,
     // so the cached clients are not actually shared among different tasks
+    /// Files of a source may be opened by several prefetching threads.
+    std::mutex clients_mutex;
     std::map<std::string, std::shared_ptr<DB::S3::Client>> per_bucket_clients;
     std::shared_ptr<DB::S3::Client> shared_client;
     DB::ReadSettings new_settings;
@@ -323,6 +385,7 @@ private:
 
     std::shared_ptr<DB::S3::Client> getClient(std::string bucket_name)
     {
+        std::lock_guard lock(clients_mutex);
         const auto & config = context->getConfigRef();
         bool use_assumed_role = false;
         bool is_per_bucket = false;
@@ -442,10 +505,12 @@ public:
     }
 
 private:
+    std::mutex client_mutex;
     std::shared_ptr<Azure::Storage::Blobs::BlobContainerClient> shared_client;
 
     std::shared_ptr<Azure::Storage::Blobs::BlobContainerClient> getClient()
     {
+        std::lock_guard lock(client_mutex);
         if (shared_client)
             return shared_client;
         shared_client = DB::getAzureBlobContainerClient(context->getConfigRef(), "blob");
@@ -1,6 +1,7 @@
 #pragma once
 #include <functional>
 #include <memory>
+#include <optional>
 #include <IO/ReadBuffer.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/Context_fwd.h>
@@ -8,6 +9,12 @@
 #include <substrait/plan.pb.h>
 namespace local_engine
 {
+struct FileStat
+{
+    size_t size = 0;
+    Int64 modification_time = 0;
+};
+
 class ReadBufferBuilder
 {
 public:
@@ -18,6 +25,9 @@ public:
     virtual std::unique_ptr<DB::ReadBuffer>
     build(const substrait::ReadRel::LocalFiles::FileOrFiles & file_info, bool set_read_util_position = false) = 0;
 
+    /// Size and modification time of the file, without opening it. nullopt if the storage can't tell them.
+    virtual std::optional<FileStat> getFileStat(const substrait::ReadRel::LocalFiles::FileOrFiles &) { return {}; }
+
 protected:
     DB::ContextPtr context;
 };
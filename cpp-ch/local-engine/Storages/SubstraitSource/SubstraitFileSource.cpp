@@ -18,7 +18,9 @@
 #include <Storages/SubstraitSource/FormatFile.h>
 #include <Storages/SubstraitSource/SubstraitFileSource.h>
 #include <Common/CHUtil.h>
+#include <Common/CurrentThread.h>
 #include <Common/Exception.h>
+#include <Common/scope_guard_safe.h>
 #include <Common/StringUtils.h>
 #include <Common/typeid_cast.h>
 
@@ -43,9 +45,27 @@ static DB::Block getRealHeader(const DB::Block & header)
 }
 
 SubstraitFileSource::SubstraitFileSource(
-    DB::ContextPtr context_, const DB::Block & header_, const substrait::ReadRel::LocalFiles & file_infos)
+    DB::ContextPtr context_,
+    const DB::Block & header_,
+    const substrait::ReadRel::LocalFiles & file_infos,
+    std::shared_ptr<const DB::KeyCondition> key_condition_,
+    DB::PrewhereInfoPtr prewhere_info_)
     : DB::ISource(getRealHeader(header_), false), context(context_), output_header(header_)
 {
+    if (key_condition_ || prewhere_info_)
+    {
+        filter = std::make_shared<FileFilter>();
+        filter->key_condition = std::move(key_condition_);
+        filter->key_header = output_header;
+        if (prewhere_info_)
+        {
+            auto prewhere_actions = prewhere_info_->prewhere_actions->clone();
+            prewhere_actions->removeUnusedActions(DB::Names{prewhere_info_->prewhere_column_name});
+            filter->prewhere_actions = std::make_shared<DB::ExpressionActions>(prewhere_actions);
+            filter->prewhere_column_name = prewhere_info_->prewhere_column_name;
+        }
+    }
+
     /**
      * We may query part fields of a struct column. For example, we have a column c in type
      * struct{x:int, y:int, z:int}, and just want fields c.x and c.y. In the substraint plan, we get
@@ -64,8 +84,14 @@ SubstraitFileSource::SubstraitFileSource(
         for (const auto & item : file_infos.items())
         {
             files.emplace_back(FormatFileUtil::createFile(context, read_buffer_builder, item));
+            files.back()->setFilter(filter);
+            files.back()->setReadStats(read_stats);
         }
 
+        const auto & config = context->getConfigRef();
+        prefetch_max_files = config.getUInt64("file_prefetch.max_files", 0);
+        prefetch_max_bytes = config.getUInt64("file_prefetch.max_bytes", 64UL << 20);
+
         auto partition_keys = files[0]->getFilePartitionKeys();
         /// file partition keys are read from the file path
         for (const auto & key : partition_keys)
@@ -109,6 +135,12 @@ DB::Chunk SubstraitFileSource::generate()
     }
 }
 
+SubstraitFileSource::~SubstraitFileSource()
+{
+    for (auto & task : prefetch_tasks)
+        task->thread.join();
+}
+
 bool SubstraitFileSource::tryPrepareReader()
 {
     if (file_reader) [[likely]]
@@ -117,39 +149,79 @@ bool SubstraitFileSource::tryPrepareReader()
     if (current_file_index >= files.size())
         return false;
 
-    auto current_file = files[current_file_index];
+    if (!prefetch_tasks.empty())
+    {
+        auto task = std::move(prefetch_tasks.front());
+        prefetch_tasks.pop_front();
+        task->thread.join();
+        prefetched_bytes -= task->bytes;
+        if (task->exception)
+            std::rethrow_exception(task->exception);
+        file_reader = std::move(task->reader);
+    }
+    else
+        file_reader = createReader(files[current_file_index]);
     current_file_index += 1;
 
-    if (!current_file->supportSplit() && current_file->getStartOffset())
+    schedulePrefetch();
+    return true;
+}
+
+std::unique_ptr<FileReaderWrapper> SubstraitFileSource::createReader(const FormatFilePtr & file) const
+{
+    if (!file->supportSplit() && file->getStartOffset())
     {
         /// For the files do not support split strategy, the task with not 0 offset will generate empty data
-        file_reader = std::make_unique<EmptyFileReader>(current_file);
-        return true;
+        return std::make_unique<EmptyFileReader>(file);
     }
 
     if (!to_read_header.columns())
     {
-        auto total_rows = current_file->getTotalRows();
+        auto total_rows = file->getTotalRows();
         if (total_rows)
-        {
-            file_reader = std::make_unique<ConstColumnsFileReader>(current_file, context, flatten_output_header, *total_rows);
-        }
-        else
-        {
-            /// For text/json format file, we can't get total rows from file metadata.
-            /// So we add a dummy column to indicate the number of rows.
-            auto dummy_header = BlockUtil::buildRowCountHeader();
-            auto flatten_output_header_contains_dummy = flatten_output_header;
-            flatten_output_header_contains_dummy.insertUnique(dummy_header.getByPosition(0));
-            file_reader = std::make_unique<NormalFileReader>(current_file, context, dummy_header, flatten_output_header_contains_dummy);
-        }
+            return std::make_unique<ConstColumnsFileReader>(file, context, flatten_output_header, *total_rows);
+
+        /// For text/json format file, we can't get total rows from file metadata.
+        /// So we add a dummy column to indicate the number of rows.
+        auto dummy_header = BlockUtil::buildRowCountHeader();
+        auto flatten_output_header_contains_dummy = flatten_output_header;
+        flatten_output_header_contains_dummy.insertUnique(dummy_header.getByPosition(0));
+        return std::make_unique<NormalFileReader>(file, context, dummy_header, flatten_output_header_contains_dummy);
     }
-    else
+
+    return std::make_unique<NormalFileReader>(file, context, to_read_header, flatten_output_header);
+}
+
+void SubstraitFileSource::schedulePrefetch()
+{
+    auto thread_group = DB::CurrentThread::getGroup();
+    while (prefetch_tasks.size() < prefetch_max_files && current_file_index + prefetch_tasks.size() < files.size())
     {
-        file_reader = std::make_unique<NormalFileReader>(current_file, context, to_read_header, flatten_output_header);
+        auto task = std::make_unique<PrefetchTask>();
+        auto file = files[current_file_index + prefetch_tasks.size()];
+        task->thread = ThreadFromGlobalPool(
+            [this, task = task.get(), file, thread_group]
+            {
+                if (thread_group)
+                    DB::CurrentThread::attachToGroupIfDetached(thread_group);
+                SCOPE_EXIT_SAFE(if (thread_group) DB::CurrentThread::detachFromGroupIfNotDetached(););
+                try
+                {
+                    /// Opening the file reads its footer, the first chunk only comes while the byte budget isn't used up.
+                    task->reader = createReader(file);
+                    if (prefetched_bytes < prefetch_max_bytes)
+                    {
+                        task->bytes = task->reader->prefetch();
+                        prefetched_bytes += task->bytes;
+                    }
+                }
+                catch (...)
+                {
+                    task->exception = std::current_exception();
+                }
+            });
+        prefetch_tasks.emplace_back(std::move(task));
     }
-
-    return true;
 }
 
 DB::Block SubstraitFileSource::foldFlattenColumns(const DB::Columns & cols, const DB::Block & header)
@@ -357,10 +429,25 @@ NormalFileReader::NormalFileReader(
 }
 
 
+size_t NormalFileReader::prefetch()
+{
+    prefetched_status = reader->pull(prefetched_chunk);
+    has_prefetched = true;
+    return prefetched_chunk.bytes();
+}
+
 bool NormalFileReader::pull(DB::Chunk & chunk)
 {
     DB::Chunk tmp_chunk;
-    auto status = reader->pull(tmp_chunk);
+    bool status;
+    if (has_prefetched)
+    {
+        tmp_chunk = std::move(prefetched_chunk);
+        status = prefetched_status;
+        has_prefetched = false;
+    }
+    else
+        status = reader->pull(tmp_chunk);
     if (!status)
         return false;
 
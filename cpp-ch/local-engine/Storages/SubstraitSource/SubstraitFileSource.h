@@ -1,5 +1,7 @@
 #pragma once
 
+#include <deque>
+
 #include <Columns/IColumn.h>
 #include <Core/Block.h>
 #include <Core/ColumnsWithTypeAndName.h>
@@ -9,9 +11,11 @@
 #include <Processors/Executors/PullingPipelineExecutor.h>
 #include <Processors/ISource.h>
 #include <QueryPipeline/QueryPipeline.h>
+#include <Storages/SelectQueryInfo.h>
 #include <Storages/SubstraitSource/FormatFile.h>
 #include <Storages/SubstraitSource/ReadBufferBuilder.h>
 #include <base/types.h>
+#include <Common/ThreadPool.h>
 
 namespace local_engine
 {
@@ -22,6 +26,9 @@ public:
     virtual ~FileReaderWrapper() = default;
     virtual bool pull(DB::Chunk & chunk) = 0;
 
+    /// Reads the first chunk ahead, called in the background before the reader is used. Returns its bytes.
+    virtual size_t prefetch() { return 0; }
+
 protected:
     FormatFilePtr file;
 
@@ -36,6 +43,7 @@ public:
     NormalFileReader(FormatFilePtr file_, DB::ContextPtr context_, const DB::Block & to_read_header_, const DB::Block & output_header_);
     ~NormalFileReader() override = default;
     bool pull(DB::Chunk & chunk) override;
+    size_t prefetch() override;
 
 private:
     DB::ContextPtr context;
@@ -45,6 +53,10 @@ private:
     FormatFile::InputFormatPtr input_format;
     std::unique_ptr<DB::QueryPipeline> pipeline;
     std::unique_ptr<DB::PullingPipelineExecutor> reader;
+
+    bool has_prefetched = false;
+    bool prefetched_status = false;
+    DB::Chunk prefetched_chunk;
 };
 
 class EmptyFileReader : public FileReaderWrapper
@@ -73,11 +85,20 @@ private:
 class SubstraitFileSource : public DB::ISource
 {
 public:
-    SubstraitFileSource(DB::ContextPtr context_, const DB::Block & header_, const substrait::ReadRel::LocalFiles & file_infos);
-    ~SubstraitFileSource() override = default;
+    /// key_condition_ and prewhere_info_ are the filter of the scan over the columns of header_, they are only used to
+    /// skip row groups and rows early, the filter still has to be applied on the output.
+    SubstraitFileSource(
+        DB::ContextPtr context_,
+        const DB::Block & header_,
+        const substrait::ReadRel::LocalFiles & file_infos,
+        std::shared_ptr<const DB::KeyCondition> key_condition_ = nullptr,
+        DB::PrewhereInfoPtr prewhere_info_ = nullptr);
+    ~SubstraitFileSource() override;
 
     String getName() const override { return "SubstraitFileSource"; }
 
+    const FileReadStats & getReadStats() const { return *read_stats; }
+
 protected:
     DB::Chunk generate() override;
 
@@ -87,12 +108,30 @@ private:
     DB::Block flatten_output_header; // Sample header after flatten, include partition keys
     DB::Block to_read_header; // Sample header after flatten, not include partition keys
     FormatFiles files;
+    FileFilterPtr filter;
+    FileReadStatsPtr read_stats = std::make_shared<FileReadStats>();
 
     UInt32 current_file_index = 0;
     std::unique_ptr<FileReaderWrapper> file_reader;
     ReadBufferBuilderPtr read_buffer_builder;
 
+    /// Reader of a file after the current one, opened in the background.
+    struct PrefetchTask
+    {
+        std::unique_ptr<FileReaderWrapper> reader;
+        size_t bytes = 0;
+        std::exception_ptr exception;
+        ThreadFromGlobalPool thread;
+    };
+    /// Tasks of the files from current_file_index on, in file order.
+    std::deque<std::unique_ptr<PrefetchTask>> prefetch_tasks;
+    size_t prefetch_max_files = 0;
+    size_t prefetch_max_bytes = 0;
+    std::atomic<size_t> prefetched_bytes = 0;
+
     bool tryPrepareReader();
+    std::unique_ptr<FileReaderWrapper> createReader(const FormatFilePtr & file) const;
+    void schedulePrefetch();
 
     // E.g we have flatten columns correspond to header {a:int, b.x.i: int, b.x.j: string, b.y: string}
     // but we want to fold all the flatten struct columns into one struct column,
@@ -24,8 +24,9 @@ namespace ErrorCodes
             throw Exception::createRuntime(ErrorCodes::BAD_ARGUMENTS, _s.ToString()); \
     } while (false)
 // clang-format on
-OptimizedParquetBlockInputFormat::OptimizedParquetBlockInputFormat(ReadBuffer & in_, Block header_, const FormatSettings & format_settings_)
-    : IInputFormat(std::move(header_), in_), format_settings(format_settings_)
+OptimizedParquetBlockInputFormat::OptimizedParquetBlockInputFormat(
+    ReadBuffer & in_, Block header_, const FormatSettings & format_settings_, std::shared_ptr<parquet::FileMetaData> metadata_)
+    : IInputFormat(std::move(header_), in_), metadata(std::move(metadata_)), format_settings(format_settings_)
 {
 }
 
@@ -108,12 +109,16 @@ static void getFileReaderAndSchema(
     std::unique_ptr<ch_parquet::arrow::FileReader> & file_reader,
     std::shared_ptr<arrow::Schema> & schema,
     const FormatSettings & format_settings,
-    std::atomic<int> & is_stopped)
+    std::atomic<int> & is_stopped,
+    std::shared_ptr<parquet::FileMetaData> metadata = nullptr)
 {
     auto arrow_file = asArrowFile(in, format_settings, is_stopped, "Parquet", PARQUET_MAGIC_BYTES);
     if (is_stopped)
         return;
-    THROW_ARROW_NOT_OK(ch_parquet::arrow::OpenFile(std::move(arrow_file), arrow::default_memory_pool(), &file_reader));
+    /// With the metadata given, the footer isn't read again.
+    ch_parquet::arrow::FileReaderBuilder builder;
+    THROW_ARROW_NOT_OK(builder.Open(std::move(arrow_file), parquet::default_reader_properties(), std::move(metadata)));
+    THROW_ARROW_NOT_OK(builder.memory_pool(arrow::default_memory_pool())->Build(&file_reader));
     THROW_ARROW_NOT_OK(file_reader->GetSchema(&schema));
 
     if (format_settings.use_lowercase_column_name)
@@ -134,7 +139,7 @@ static void getFileReaderAndSchema(
 void OptimizedParquetBlockInputFormat::prepareReader()
 {
     std::shared_ptr<arrow::Schema> schema;
-    getFileReaderAndSchema(*in, file_reader, schema, format_settings, is_stopped);
+    getFileReaderAndSchema(*in, file_reader, schema, format_settings, is_stopped, metadata);
     if (is_stopped)
         return;
 
@@ -18,6 +18,11 @@ namespace arrow
 class Buffer;
 }
 
+namespace parquet
+{
+class FileMetaData;
+}
+
 namespace DB
 {
 class OptimizedArrowColumnToCHColumn;
@@ -25,7 +30,12 @@ class OptimizedArrowColumnToCHColumn;
 class OptimizedParquetBlockInputFormat : public IInputFormat
 {
 public:
-    OptimizedParquetBlockInputFormat(ReadBuffer & in_, Block header_, const FormatSettings & format_settings_);
+    /// metadata_ is the already parsed footer of the file, if the caller has it.
+    OptimizedParquetBlockInputFormat(
+        ReadBuffer & in_,
+        Block header_,
+        const FormatSettings & format_settings_,
+        std::shared_ptr<parquet::FileMetaData> metadata_ = nullptr);
 
     void resetParser() override;
 
@@ -42,6 +52,7 @@ protected:
     void onCancel() override { is_stopped = 1; }
 
     std::unique_ptr<ch_parquet::arrow::FileReader> file_reader;
+    std::shared_ptr<parquet::FileMetaData> metadata;
     int row_group_total = 0;
     // indices of columns to read from Parquet file
     std::vector<int> column_indices;
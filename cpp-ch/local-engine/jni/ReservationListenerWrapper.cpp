@@ -23,8 +23,10 @@ ReservationListenerWrapper::~ReservationListenerWrapper()
 void ReservationListenerWrapper::reserve(int64_t size)
 {
     GET_JNIENV(env)
-    safeCallVoidMethod(env, listener, reservation_listener_reserve, size);
+    int64_t granted = safeCallLongMethod(env, listener, reservation_listener_reserve, size);
     CLEAN_JNIENV
+    if (granted < size)
+        unmet_reservations += size - granted;
 }
 
 void ReservationListenerWrapper::reserveOrThrow(int64_t size)
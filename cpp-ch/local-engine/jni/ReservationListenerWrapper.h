@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <memory>
 #include <jni.h>
 #include <stdint.h>
@@ -15,12 +16,16 @@ public:
 
     explicit ReservationListenerWrapper(jobject listener);
     ~ReservationListenerWrapper();
+    /// Spark may grant less than size, the difference is added to the unmet reservations.
     void reserve(int64_t size);
     void reserveOrThrow(int64_t size);
     void free(int64_t size);
+    /// Bytes Spark didn't grant to reserve() since the last call, the count is reset.
+    int64_t takeUnmetReservations() { return unmet_reservations.exchange(0); }
 
 private:
     jobject listener;
+    std::atomic<int64_t> unmet_reservations = 0;
 };
 using ReservationListenerWrapperPtr = std::shared_ptr<ReservationListenerWrapper>;
 }
@@ -4,6 +4,8 @@
 #include <jni.h>
 #include <Builder/BroadCastJoinBuilder.h>
 #include <Builder/SerializedPlanBuilder.h>
+#include <Columns/ColumnConst.h>
+#include <Columns/ColumnString.h>
 #include <DataTypes/DataTypeNullable.h>
 #include <Operator/BlockCoalesceOperator.h>
 #include <Parser/CHColumnToSparkRow.h>
@@ -484,6 +486,46 @@ JNIEXPORT jstring Java_io_glutenproject_vectorized_CHColumnVector_nativeGetStrin
     LOCAL_ENGINE_JNI_METHOD_END(env, local_engine::charTojstring(env, ""))
 }
 
+/// Returns {null map, data, offsets, value size} of a column whose values are stored contiguously, so that the JVM reads
+/// them in place instead of calling back for each value. The null map holds a byte per row, 1 for null, and is 0 for
+/// columns that aren't nullable. Strings have their chars in data and their end offsets in offsets, each string
+/// followed by a zero byte, offsets[-1] is readable and 0. Returns null for the other columns.
+JNIEXPORT jlongArray
+Java_io_glutenproject_vectorized_CHColumnVector_nativeGetBuffers(JNIEnv * env, jobject obj, jlong block_address, jint column_position)
+{
+    LOCAL_ENGINE_JNI_METHOD_START
+    auto col = getColumnFromColumnVector(env, obj, block_address, column_position);
+    if (isColumnConst(*col.column))
+        return nullptr;
+
+    const UInt8 * null_map = nullptr;
+    DB::ColumnPtr nested_col = col.column;
+    if (const auto * nullable_col = checkAndGetColumn<DB::ColumnNullable>(nested_col.get()))
+    {
+        null_map = nullable_col->getNullMapData().data();
+        nested_col = nullable_col->getNestedColumnPtr();
+    }
+
+    jlong buffers[4] = {reinterpret_cast<jlong>(null_map), 0, 0, 0};
+    if (const auto * string_col = checkAndGetColumn<DB::ColumnString>(nested_col.get()))
+    {
+        buffers[1] = reinterpret_cast<jlong>(string_col->getChars().data());
+        buffers[2] = reinterpret_cast<jlong>(string_col->getOffsets().data());
+    }
+    else if (nested_col->isNumeric())
+    {
+        buffers[1] = nested_col->empty() ? 0 : reinterpret_cast<jlong>(nested_col->getDataAt(0).data);
+        buffers[3] = nested_col->sizeOfValueIfFixed();
+    }
+    else
+        return nullptr;
+
+    auto * result = env->NewLongArray(4);
+    env->SetLongArrayRegion(result, 0, 4, buffers);
+    return result;
+    LOCAL_ENGINE_JNI_METHOD_END(env, nullptr)
+}
+
 // native block
 JNIEXPORT void Java_io_glutenproject_vectorized_CHNativeBlock_nativeClose(JNIEnv * /*env*/, jobject /*obj*/, jlong /*block_address*/)
 {
@@ -530,7 +572,10 @@ JNIEXPORT jlong Java_io_glutenproject_vectorized_CHStreamReader_createNativeShuf
 {
     LOCAL_ENGINE_JNI_METHOD_START
     auto * input = env->NewGlobalRef(input_stream);
-    auto read_buffer = std::make_unique<local_engine::ReadBufferFromJavaInputStream>(input, customize_buffer_size);
+    /// 0 reads the stream on the calling thread, otherwise a helper thread reads ahead into buffers of this size.
+    size_t read_ahead_buffer_size
+        = local_engine::SerializedPlanParser::global_context->getConfigRef().getUInt64("shuffle_read_ahead_buffer_size", 0);
+    auto read_buffer = std::make_unique<local_engine::ReadBufferFromJavaInputStream>(input, customize_buffer_size, read_ahead_buffer_size);
     auto * shuffle_reader = new local_engine::ShuffleReader(std::move(read_buffer), compressed);
     return reinterpret_cast<jlong>(shuffle_reader);
     LOCAL_ENGINE_JNI_METHOD_END(env, -1)
@@ -545,6 +590,24 @@ JNIEXPORT jlong Java_io_glutenproject_vectorized_CHStreamReader_nativeNext(JNIEn
     LOCAL_ENGINE_JNI_METHOD_END(env, -1)
 }
 
+/// The calls to the Java input stream, the bytes they read and the nanoseconds spent in them.
+JNIEXPORT jlongArray Java_io_glutenproject_vectorized_CHStreamReader_nativeReadStats(JNIEnv * env, jobject /*obj*/, jlong shuffle_reader)
+{
+    LOCAL_ENGINE_JNI_METHOD_START
+    local_engine::ShuffleReader * reader = reinterpret_cast<local_engine::ShuffleReader *>(shuffle_reader);
+    jlong stats[3] = {0, 0, 0};
+    if (const auto * in = dynamic_cast<const local_engine::ReadBufferWithReadAhead *>(reader->in.get()))
+    {
+        stats[0] = in->getReadCalls();
+        stats[1] = in->getReadBytes();
+        stats[2] = in->getReadNanoseconds();
+    }
+    auto * result = env->NewLongArray(3);
+    env->SetLongArrayRegion(result, 0, 3, stats);
+    return result;
+    LOCAL_ENGINE_JNI_METHOD_END(env, nullptr)
+}
+
 JNIEXPORT void Java_io_glutenproject_vectorized_CHStreamReader_nativeClose(JNIEnv * env, jobject /*obj*/, jlong shuffle_reader)
 {
     LOCAL_ENGINE_JNI_METHOD_START
@@ -613,7 +676,9 @@ JNIEXPORT jlong Java_io_glutenproject_vectorized_CHShuffleSplitterJniWrapper_nat
     jstring codec,
     jstring data_file,
     jstring local_dirs,
-    jint num_sub_dirs)
+    jint num_sub_dirs,
+    jlong allocator_id,
+    jlong spill_threshold)
 {
     LOCAL_ENGINE_JNI_METHOD_START
     std::string hash_exprs;
@@ -653,7 +718,10 @@ JNIEXPORT jlong Java_io_glutenproject_vectorized_CHShuffleSplitterJniWrapper_nat
         .partition_nums = static_cast<size_t>(num_partitions),
         .hash_exprs = hash_exprs,
         .out_exprs = out_exprs,
-        .compress_method = jstring2string(env, codec)};
+        .compress_method = jstring2string(env, codec),
+        .spill_threshold = static_cast<size_t>(spill_threshold)};
+    if (auto allocator = local_engine::getAllocator(allocator_id))
+        options.listener = allocator->listener;
     local_engine::SplitterHolder * splitter
         = new local_engine::SplitterHolder{.splitter = local_engine::ShuffleSplitter::create(jstring2string(env, short_name), options)};
     return reinterpret_cast<jlong>(splitter);
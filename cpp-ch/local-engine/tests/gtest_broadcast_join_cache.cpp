@@ -0,0 +1,70 @@
+#include <Builder/BroadcastJoinCache.h>
+#include <gtest/gtest.h>
+
+using namespace local_engine;
+
+namespace
+{
+using Cache = BroadcastJoinCache<String>;
+
+/// Builds the key itself as the join and counts the builds.
+struct Builder
+{
+    Cache & cache;
+    size_t builds = 0;
+
+    Cache::JoinPtr get(const String & key)
+    {
+        return cache.getOrBuild(
+            key,
+            [&]
+            {
+                ++builds;
+                return std::make_shared<String>(key);
+            });
+    }
+};
+}
+
+TEST(BroadcastJoinCache, ReusedAcrossTasks)
+{
+    Cache cache;
+    Builder builder{cache};
+    /// The JVM cache holds the first build, the tasks after it get the same join.
+    auto owner = builder.get("bhj_1");
+    EXPECT_EQ(builder.get("bhj_1"), owner);
+    EXPECT_EQ(cache.get("bhj_1"), owner);
+    EXPECT_EQ(builder.builds, 1);
+    EXPECT_EQ(cache.getHits(), 2);
+
+    EXPECT_NE(builder.get("bhj_2"), owner);
+    EXPECT_EQ(builder.builds, 2);
+}
+
+TEST(BroadcastJoinCache, ReleasedByOwner)
+{
+    Cache cache;
+    Builder builder{cache};
+    auto owner = builder.get("bhj_1");
+    /// A running task still holds the join after the JVM cache released it, it's reused.
+    auto task = owner;
+    owner.reset();
+    EXPECT_EQ(builder.get("bhj_1"), task);
+    EXPECT_EQ(builder.builds, 1);
+
+    /// Nobody holds it anymore, it's built again.
+    task.reset();
+    EXPECT_EQ(cache.get("bhj_1"), nullptr);
+    EXPECT_EQ(*builder.get("bhj_1"), "bhj_1");
+    EXPECT_EQ(builder.builds, 2);
+}
+
+TEST(BroadcastJoinCache, FirstPutWins)
+{
+    Cache cache;
+    auto first = std::make_shared<String>("first");
+    EXPECT_EQ(cache.put("bhj_1", first), first);
+    EXPECT_EQ(cache.put("bhj_1", std::make_shared<String>("second")), first);
+    EXPECT_EQ(cache.put("bhj_2", nullptr), nullptr);
+    EXPECT_EQ(cache.get("bhj_2"), nullptr);
+}
@@ -1,3 +1,4 @@
+#include <DataTypes/DataTypeNullable.h>
 #include <Functions/FunctionFactory.h>
 #include <Parser/SerializedPlanParser.h>
 #include <Parsers/ASTIdentifier.h>
@@ -9,6 +10,7 @@
 #include <Processors/Sources/SourceFromSingleChunk.h>
 #include <QueryPipeline/QueryPipelineBuilder.h>
 #include <Storages/CustomMergeTreeSink.h>
+#include <Storages/PartitionedHashJoin.h>
 #include <Storages/StorageJoinFromReadBuffer.h>
 #include <Storages/SubstraitSource/SubstraitFileSource.h>
 #include <gtest/gtest.h>
@@ -226,3 +228,119 @@ TEST(TestJoin, StorageJoinFromReadBufferTest)
     executor.pull(res);
     debug::headBlock(res);
 }
+
+TEST(TestJoin, ScatterByKeysIgnoresNullable)
+{
+    auto int_type = DataTypeFactory::instance().get("Int64");
+    auto nullable_type = makeNullable(int_type);
+    auto column = int_type->createColumn();
+    auto nullable_column = nullable_type->createColumn();
+    for (Int64 i = 0; i < 1000; ++i)
+    {
+        column->insert(i * 7919);
+        nullable_column->insert(i * 7919);
+    }
+    Block left({ColumnWithTypeAndName(std::move(column), int_type, "key")});
+    Block right({ColumnWithTypeAndName(std::move(nullable_column), nullable_type, "key")});
+
+    auto left_parts = scatterByKeys(left, {"key"}, 4);
+    auto right_parts = scatterByKeys(right, {"key"}, 4);
+    ASSERT_EQ(left_parts.size(), 4UL);
+    ASSERT_EQ(right_parts.size(), 4UL);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        ASSERT_EQ(left_parts[i].rows(), right_parts[i].rows());
+        ASSERT_GT(left_parts[i].rows(), 0UL);
+        for (size_t row = 0; row < left_parts[i].rows(); ++row)
+            ASSERT_EQ((*left_parts[i].getByName("key").column)[row], (*right_parts[i].getByName("key").column)[row]);
+    }
+}
+
+namespace
+{
+/// Left joins keys 0..5999 with a right side of 10000 rows in 10 blocks, where key k < 5000 is in the rows k and
+/// k + 5000, built by build_threads threads. Returns the (left key, right row) pairs of the result, sorted.
+std::vector<std::pair<Int64, Int64>> joinWithBuildThreads(size_t build_threads)
+{
+    auto global_context = SerializedPlanParser::global_context;
+    auto int_type = DataTypeFactory::instance().get("Int64");
+
+    Block right_header({ColumnWithTypeAndName(int_type, "colD"), ColumnWithTypeAndName(int_type, "colC")});
+    std::string buf;
+    WriteBufferFromString write_buf(buf);
+    NativeWriter writer(write_buf, 0, right_header);
+    for (Int64 block_id = 0; block_id < 10; ++block_id)
+    {
+        auto keys = int_type->createColumn();
+        auto rows = int_type->createColumn();
+        for (Int64 row = block_id * 1000; row < (block_id + 1) * 1000; ++row)
+        {
+            keys->insert(row % 5000);
+            rows->insert(row);
+        }
+        writer.write(right_header.cloneWithColumns(MutableColumns{std::move(keys), std::move(rows)}));
+    }
+    write_buf.finalize();
+
+    auto left_keys = int_type->createColumn();
+    for (Int64 key = 0; key < 6000; ++key)
+        left_keys->insert(key);
+    Block left({ColumnWithTypeAndName(std::move(left_keys), int_type, "colA")});
+
+    auto metadata = local_engine::buildMetaData(right_header.getNamesAndTypesList(), global_context);
+    auto join_storage = std::make_shared<StorageJoinFromReadBuffer>(
+        std::make_unique<ReadBufferFromString>(buf),
+        Names{"colD"},
+        false,
+        SizeLimits{},
+        JoinKind::Left,
+        JoinStrictness::All,
+        ColumnsDescription(right_header.getNamesAndTypesList()),
+        ConstraintsDescription{},
+        "test",
+        true,
+        build_threads);
+
+    QueryPlan left_plan;
+    left_plan.addStep(std::make_unique<ReadFromPreparedSource>(Pipe(std::make_shared<SourceFromSingleChunk>(left))));
+    auto join = std::make_shared<TableJoin>(SizeLimits(), false, JoinKind::Left, JoinStrictness::All, right_header.getNames());
+    join->addJoinedColumn(NameAndTypePair("colD", int_type));
+    join->addJoinedColumn(NameAndTypePair("colC", int_type));
+    join->addOnKeys(std::make_shared<ASTIdentifier>("colA"), std::make_shared<ASTIdentifier>("colD"));
+    auto join_step = std::make_unique<FilledJoinStep>(
+        left_plan.getCurrentDataStream(), join_storage->getJoinLocked(join, global_context), 8192);
+    left_plan.addStep(std::move(join_step));
+
+    auto pipeline = left_plan.buildQueryPipeline(QueryPlanOptimizationSettings(), BuildQueryPipelineSettings());
+    auto executable_pipe = QueryPipelineBuilder::getPipeline(std::move(*pipeline));
+    PullingPipelineExecutor executor(executable_pipe);
+    std::vector<std::pair<Int64, Int64>> result;
+    Block block;
+    while (executor.pull(block))
+    {
+        const auto & left_column = block.getByName("colA").column;
+        const auto & right_column = block.getByName("colC").column;
+        for (size_t row = 0; row < block.rows(); ++row)
+            result.emplace_back(left_column->getInt(row), right_column->getInt(row));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+}
+
+TEST(TestJoin, StorageJoinFromReadBufferBuildThreads)
+{
+    std::vector<std::pair<Int64, Int64>> expected;
+    for (Int64 key = 0; key < 5000; ++key)
+    {
+        expected.emplace_back(key, key);
+        expected.emplace_back(key, key + 5000);
+    }
+    /// Unmatched rows of a left join get the default value.
+    for (Int64 key = 5000; key < 6000; ++key)
+        expected.emplace_back(key, 0);
+    std::sort(expected.begin(), expected.end());
+
+    ASSERT_EQ(joinWithBuildThreads(1), expected);
+    ASSERT_EQ(joinWithBuildThreads(4), expected);
+}
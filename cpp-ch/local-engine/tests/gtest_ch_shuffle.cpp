@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <filesystem>
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <IO/ReadBufferFromFile.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/ReadHelpers.h>
+#include <Shuffle/ShuffleReader.h>
+#include <Shuffle/ShuffleSplitter.h>
+#include <gtest/gtest.h>
+#include <Common/assert_cast.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+constexpr size_t num_partitions = 4;
+constexpr size_t rows_per_block = 1000;
+constexpr size_t num_blocks = 20;
+
+Block makeBlock(size_t first_id)
+{
+    auto ids = ColumnInt64::create();
+    auto names = ColumnString::create();
+    for (size_t i = first_id; i < first_id + rows_per_block; ++i)
+    {
+        ids->insertValue(i);
+        names->insert("name_" + std::to_string(i));
+    }
+    return Block{
+        ColumnWithTypeAndName(std::move(ids), std::make_shared<DataTypeInt64>(), "id"),
+        ColumnWithTypeAndName(std::move(names), std::make_shared<DataTypeString>(), "name")};
+}
+
+struct ShuffleOutput
+{
+    SplitResult result;
+    /// Ids of every partition in the order they were read back from the data file.
+    std::vector<std::vector<Int64>> partition_ids;
+};
+
+/// Splits num_blocks blocks of increasing ids round robin and reads every partition back from the data file.
+ShuffleOutput shuffle(const std::string & name, size_t split_size, size_t spill_threshold)
+{
+    auto dir = std::filesystem::temp_directory_path() / ("gtest_ch_shuffle_" + name);
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    SplitOptions options;
+    options.split_size = split_size;
+    options.spill_threshold = spill_threshold;
+    options.data_file = dir / "shuffle.data";
+    options.local_dirs_list = {dir};
+    options.num_sub_dirs = 1;
+    options.shuffle_id = 0;
+    options.map_id = 0;
+    options.partition_nums = num_partitions;
+    options.out_exprs = "0,1";
+    options.compress_method = "LZ4";
+    auto splitter = ShuffleSplitter::create("rr", options);
+    for (size_t i = 0; i < num_blocks; ++i)
+    {
+        auto block = makeBlock(i * rows_per_block);
+        splitter->split(block);
+    }
+
+    ShuffleOutput output;
+    output.result = splitter->stop();
+    EXPECT_FALSE(std::filesystem::exists(dir / "00" / "0_0.spill"));
+
+    String data;
+    ReadBufferFromFile in(options.data_file);
+    readStringUntilEOF(data, in);
+    EXPECT_EQ(output.result.total_bytes_written, static_cast<Int64>(data.size()));
+
+    size_t offset = 0;
+    output.partition_ids.resize(num_partitions);
+    for (size_t i = 0; i < num_partitions; ++i)
+    {
+        size_t length = output.result.partition_length[i];
+        ShuffleReader reader(std::make_unique<ReadBufferFromOwnString>(data.substr(offset, length)), true);
+        for (auto * block = reader.read(); block->rows() > 0; block = reader.read())
+        {
+            const auto & ids = assert_cast<const ColumnInt64 &>(*block->getByPosition(0).column);
+            const auto & names = assert_cast<const ColumnString &>(*block->getByPosition(1).column);
+            for (size_t row = 0; row < block->rows(); ++row)
+            {
+                EXPECT_EQ(names.getDataAt(row).toString(), "name_" + std::to_string(ids.getElement(row)));
+                output.partition_ids[i].push_back(ids.getElement(row));
+            }
+        }
+        offset += length;
+    }
+    EXPECT_EQ(offset, data.size());
+    std::filesystem::remove_all(dir);
+    return output;
+}
+
+/// Every id is read back exactly once, and the spilled and buffered parts of each partition are merged in the order
+/// they were split.
+void checkOutput(const ShuffleOutput & output)
+{
+    std::vector<bool> seen(num_blocks * rows_per_block, false);
+    for (const auto & ids : output.partition_ids)
+    {
+        EXPECT_NEAR(ids.size(), num_blocks * rows_per_block / num_partitions, num_blocks);
+        EXPECT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+        for (auto id : ids)
+        {
+            ASSERT_LT(id, static_cast<Int64>(seen.size()));
+            EXPECT_FALSE(seen[id]) << "id " << id << " read twice";
+            seen[id] = true;
+        }
+    }
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](bool s) { return s; }));
+}
+}
+
+TEST(ShuffleSplitter, BufferedOnly)
+{
+    auto output = shuffle("buffered", 1000000, 0);
+    EXPECT_EQ(output.result.total_bytes_spilled, 0);
+    checkOutput(output);
+}
+
+TEST(ShuffleSplitter, SpillOnSplitSize)
+{
+    /// Each partition gets 250 rows per block, so every partition spills several ranges between the others'.
+    auto output = shuffle("split_size", 600, 0);
+    EXPECT_GT(output.result.total_bytes_spilled, 0);
+    checkOutput(output);
+}
+
+TEST(ShuffleSplitter, SpillOnThreshold)
+{
+    auto output = shuffle("threshold", 1000000, 64 * 1024);
+    EXPECT_GT(output.result.total_bytes_spilled, 0);
+    checkOutput(output);
+
+    /// Spilling doesn't change what each partition holds.
+    auto buffered = shuffle("threshold_buffered", 1000000, 0);
+    EXPECT_EQ(output.partition_ids, buffered.partition_ids);
+}
@@ -0,0 +1,170 @@
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Operator/ExpandStep.h>
+#include <Processors/Executors/PullingPipelineExecutor.h>
+#include <Processors/ISource.h>
+#include <Processors/QueryPlan/BuildQueryPipelineSettings.h>
+#include <Processors/QueryPlan/Optimizations/QueryPlanOptimizationSettings.h>
+#include <Processors/QueryPlan/QueryPlan.h>
+#include <Processors/QueryPlan/ReadFromPreparedSource.h>
+#include <QueryPipeline/QueryPipelineBuilder.h>
+#include <gtest/gtest.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+/// Emits a chunk of each size, "k" numbers the rows of all the chunks, "s" is null in every third row.
+class ChunksSource : public ISource
+{
+public:
+    ChunksSource(const Block & header_, std::vector<size_t> sizes_) : ISource(header_), sizes(std::move(sizes_)) { }
+
+    String getName() const override { return "ChunksSource"; }
+
+private:
+    Chunk generate() override
+    {
+        if (next == sizes.size())
+            return {};
+        size_t rows = sizes[next++];
+        auto k = ColumnInt64::create();
+        auto s = ColumnNullable::create(ColumnString::create(), ColumnUInt8::create());
+        auto v = ColumnInt32::create();
+        for (size_t i = 0; i < rows; ++i, ++first_row)
+        {
+            k->insertValue(first_row);
+            if (first_row % 3)
+                s->insert(Field("s" + std::to_string(first_row)));
+            else
+                s->insertDefault();
+            v->insertValue(static_cast<Int32>(first_row * 7 % 100));
+        }
+        Columns columns;
+        columns.emplace_back(std::move(k));
+        columns.emplace_back(std::move(s));
+        columns.emplace_back(std::move(v));
+        return Chunk(std::move(columns), rows);
+    }
+
+    const std::vector<size_t> sizes;
+    size_t next = 0;
+    Int64 first_row = 0;
+};
+
+Block inputHeader()
+{
+    return Block{
+        {std::make_shared<DataTypeInt64>(), "k"},
+        {makeNullable(std::make_shared<DataTypeString>()), "s"},
+        {std::make_shared<DataTypeInt32>(), "v"}};
+}
+
+/// The grouping sets (k, s), (k) and () with the grouping id, like spark plans them. The non-nullable "k" is selected
+/// into a nullable column.
+ExpandField groupingSets()
+{
+    const auto selection = EXPAND_FIELD_KIND_SELECTION;
+    const auto literal = EXPAND_FIELD_KIND_LITERAL;
+    return ExpandField(
+        {"k", "s", "v", "gid"},
+        {makeNullable(std::make_shared<DataTypeInt64>()),
+         makeNullable(std::make_shared<DataTypeString>()),
+         std::make_shared<DataTypeInt32>(),
+         std::make_shared<DataTypeInt64>()},
+        {{selection, selection, selection, literal}, {selection, literal, selection, literal}, {literal, literal, selection, literal}},
+        {{Field(Int32(0)), Field(Int32(1)), Field(Int32(2)), Field(Int64(0))},
+         {Field(Int32(0)), Field(), Field(Int32(2)), Field(Int64(1))},
+         {Field(), Field(), Field(Int32(2)), Field(Int64(3))}});
+}
+
+using Rows = std::vector<std::vector<Field>>;
+
+/// The expansion as ExpandTransform built it before emitting the projections one at a time: all the projections of a
+/// chunk, each with its own columns.
+Rows expectedRows(const std::vector<size_t> & sizes, const ExpandField & expand)
+{
+    Rows rows;
+    Int64 first_row = 0;
+    for (size_t size : sizes)
+    {
+        for (size_t i = 0; i < expand.getExpandRows(); ++i)
+        {
+            for (Int64 row = first_row; row < first_row + static_cast<Int64>(size); ++row)
+            {
+                std::vector<Field> input{Field(row), row % 3 ? Field("s" + std::to_string(row)) : Field(), Field(Int32(row * 7 % 100))};
+                auto & fields = rows.emplace_back();
+                for (size_t j = 0; j < expand.getExpandCols(); ++j)
+                {
+                    const auto & field = expand.getFields()[i][j];
+                    fields.push_back(expand.getKinds()[i][j] == EXPAND_FIELD_KIND_SELECTION ? input[field.get<Int32>()] : field);
+                }
+            }
+        }
+        first_row += size;
+    }
+    return rows;
+}
+
+/// Runs the expand over chunks of the sizes. The output blocks are all kept until the end, the columns shared between
+/// them must not change when later ones are built.
+Rows expand(const std::vector<size_t> & sizes, const ExpandField & expand_field)
+{
+    QueryPlan plan;
+    auto source = std::make_unique<ReadFromPreparedSource>(Pipe(std::make_shared<ChunksSource>(inputHeader(), sizes)));
+    plan.addStep(std::move(source));
+    plan.addStep(std::make_unique<ExpandStep>(plan.getCurrentDataStream(), expand_field));
+    auto builder = plan.buildQueryPipeline(QueryPlanOptimizationSettings(), BuildQueryPipelineSettings());
+    auto pipeline = QueryPipelineBuilder::getPipeline(std::move(*builder));
+    PullingPipelineExecutor executor(pipeline);
+
+    std::vector<Block> blocks;
+    Block block;
+    while (executor.pull(block))
+        blocks.push_back(block);
+
+    Rows rows;
+    for (const auto & output : blocks)
+    {
+        EXPECT_EQ(output.columns(), expand_field.getExpandCols());
+        for (size_t row = 0; row < output.rows(); ++row)
+        {
+            auto & fields = rows.emplace_back();
+            for (const auto & column : output)
+                fields.push_back((*column.column)[row]);
+        }
+    }
+    return rows;
+}
+}
+
+TEST(ExpandTransform, SameRowsAsEagerExpand)
+{
+    auto expand_field = groupingSets();
+    /// Chunks of one size share the literal columns, they are built again when the size changes.
+    std::vector<size_t> sizes{5, 5, 3, 1000, 1, 5};
+    auto rows = expand(sizes, expand_field);
+    ASSERT_EQ(rows.size(), 1019 * 3);
+    EXPECT_EQ(rows, expectedRows(sizes, expand_field));
+}
+
+TEST(ExpandTransform, SingleProjection)
+{
+    ExpandField expand_field(
+        {"v", "gid"},
+        {std::make_shared<DataTypeInt32>(), std::make_shared<DataTypeInt64>()},
+        {{EXPAND_FIELD_KIND_SELECTION, EXPAND_FIELD_KIND_LITERAL}},
+        {{Field(Int32(2)), Field(Int64(7))}});
+    std::vector<size_t> sizes{10, 1, 10};
+    EXPECT_EQ(expand(sizes, expand_field), expectedRows(sizes, expand_field));
+}
+
+TEST(ExpandTransform, NoInput)
+{
+    EXPECT_TRUE(expand({}, groupingSets()).empty());
+}
@@ -0,0 +1,91 @@
+#include <Storages/SubstraitSource/FileMetaCache.h>
+#include <gtest/gtest.h>
+
+using namespace local_engine;
+
+namespace
+{
+using Cache = FileMetaCache<String>;
+
+/// Loads the key itself as the metadata and counts the loads.
+struct Loader
+{
+    Cache & cache;
+    size_t loads = 0;
+
+    Cache::MetadataPtr get(const String & key, bool & hit)
+    {
+        return cache.getOrLoad(
+            key,
+            [&]
+            {
+                ++loads;
+                return std::make_shared<String>(key);
+            },
+            [](const String & metadata) { return metadata.size(); },
+            hit);
+    }
+
+    bool cached(const String & key)
+    {
+        bool hit = false;
+        get(key, hit);
+        return hit;
+    }
+};
+}
+
+TEST(FileMetaCache, HitAfterMiss)
+{
+    Cache cache(100);
+    Loader loader{cache};
+    bool hit = true;
+    auto first = loader.get("a:10:1", hit);
+    EXPECT_FALSE(hit);
+    auto second = loader.get("a:10:1", hit);
+    EXPECT_TRUE(hit);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(loader.loads, 1);
+
+    /// A rewritten file has another size or modification time, and so another key.
+    EXPECT_FALSE(loader.cached("a:10:2"));
+    EXPECT_EQ(loader.loads, 2);
+}
+
+TEST(FileMetaCache, EvictsLeastRecentlyUsed)
+{
+    /// Room for two of the ten byte keys.
+    Cache cache(25);
+    Loader loader{cache};
+    EXPECT_FALSE(loader.cached("file_0:1:1"));
+    EXPECT_FALSE(loader.cached("file_1:1:1"));
+    /// Touches the first file so that the second one is the least recently used.
+    EXPECT_TRUE(loader.cached("file_0:1:1"));
+    EXPECT_FALSE(loader.cached("file_2:1:1"));
+
+    EXPECT_TRUE(loader.cached("file_0:1:1"));
+    EXPECT_TRUE(loader.cached("file_2:1:1"));
+    EXPECT_FALSE(loader.cached("file_1:1:1"));
+    EXPECT_EQ(loader.loads, 4);
+}
+
+TEST(FileMetaCache, OversizedNotCached)
+{
+    Cache cache(5);
+    Loader loader{cache};
+    bool hit = true;
+    auto metadata = loader.get("file_0:1:1", hit);
+    EXPECT_FALSE(hit);
+    EXPECT_EQ(*metadata, "file_0:1:1");
+    EXPECT_FALSE(loader.cached("file_0:1:1"));
+    EXPECT_EQ(loader.loads, 2);
+}
+
+TEST(FileMetaCache, Disabled)
+{
+    Cache cache(0);
+    Loader loader{cache};
+    EXPECT_FALSE(loader.cached("a:1:1"));
+    EXPECT_FALSE(loader.cached("a:1:1"));
+    EXPECT_EQ(loader.loads, 2);
+}
@@ -0,0 +1,152 @@
+#include "config.h"
+
+#if USE_PARQUET
+
+#include <filesystem>
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Parser/SerializedPlanParser.h>
+#include <Poco/Util/MapConfiguration.h>
+#include <Processors/Executors/PullingPipelineExecutor.h>
+#include <QueryPipeline/QueryPipeline.h>
+#include <Storages/SubstraitSource/SubstraitFileSource.h>
+#include <gtest/gtest.h>
+#include <parquet/arrow/writer.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+/// Rows of the test files, the third one is empty.
+const std::vector<size_t> file_rows{1000, 10, 0, 3000, 1, 500};
+
+/// Writes file i with file_rows[i] rows in row groups of 256 rows, "id" numbers the rows of all the files.
+String writeTestFile(size_t i)
+{
+    auto path = std::filesystem::temp_directory_path() / ("gtest_file_prefetch_" + std::to_string(i) + ".parquet");
+    size_t first_id = 0;
+    for (size_t j = 0; j < i; ++j)
+        first_id += file_rows[j];
+
+    arrow::Int64Builder ids;
+    arrow::StringBuilder names;
+    for (size_t row = 0; row < file_rows[i]; ++row)
+    {
+        EXPECT_TRUE(ids.Append(first_id + row).ok());
+        EXPECT_TRUE(names.Append("file " + std::to_string(i) + " row " + std::to_string(row)).ok());
+    }
+    std::shared_ptr<arrow::Array> id_array;
+    std::shared_ptr<arrow::Array> name_array;
+    EXPECT_TRUE(ids.Finish(&id_array).ok());
+    EXPECT_TRUE(names.Finish(&name_array).ok());
+    auto schema = arrow::schema({arrow::field("id", arrow::int64(), false), arrow::field("name", arrow::utf8(), false)});
+    auto table = arrow::Table::Make(schema, {id_array, name_array});
+    auto out = arrow::io::FileOutputStream::Open(path.string()).ValueOrDie();
+    EXPECT_TRUE(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), out, 256).ok());
+    EXPECT_TRUE(out->Close().ok());
+    return path.string();
+}
+
+const std::vector<String> & testFiles()
+{
+    static const std::vector<String> paths = []
+    {
+        std::vector<String> result;
+        for (size_t i = 0; i < file_rows.size(); ++i)
+            result.push_back(writeTestFile(i));
+        return result;
+    }();
+    return paths;
+}
+
+/// Sets the prefetch settings of SubstraitFileSource for its lifetime.
+class FilePrefetch
+{
+public:
+    FilePrefetch(size_t max_files, size_t max_bytes)
+    {
+        Poco::AutoPtr<Poco::Util::MapConfiguration> config(new Poco::Util::MapConfiguration());
+        config->setUInt64("file_prefetch.max_files", max_files);
+        config->setUInt64("file_prefetch.max_bytes", max_bytes);
+        SerializedPlanParser::global_context->setConfig(config);
+    }
+
+    ~FilePrefetch() { SerializedPlanParser::global_context->setConfig(Poco::AutoPtr(new Poco::Util::MapConfiguration())); }
+};
+
+/// Reads the files in one source, returns the rows in the order they are read.
+std::vector<std::pair<Int64, String>> scan(const std::vector<String> & paths)
+{
+    substrait::ReadRel::LocalFiles files;
+    for (const auto & path : paths)
+    {
+        auto * file = files.add_items();
+        file->set_uri_file("file://" + path);
+        file->set_start(0);
+        file->set_length(std::filesystem::exists(path) ? std::filesystem::file_size(path) : 1);
+        file->mutable_parquet();
+    }
+    Block header{{std::make_shared<DataTypeInt64>(), "id"}, {std::make_shared<DataTypeString>(), "name"}};
+    QueryPipeline pipeline(std::make_shared<SubstraitFileSource>(SerializedPlanParser::global_context, header, files));
+    PullingPipelineExecutor executor(pipeline);
+
+    std::vector<std::pair<Int64, String>> rows;
+    Block block;
+    while (executor.pull(block))
+    {
+        const auto & ids = *block.getByName("id").column;
+        const auto & names = *block.getByName("name").column;
+        for (size_t row = 0; row < block.rows(); ++row)
+            rows.emplace_back(ids.getInt(row), names.getDataAt(row).toString());
+    }
+    return rows;
+}
+}
+
+TEST(FilePrefetch, SameRowsAsWithout)
+{
+    std::vector<std::pair<Int64, String>> expected;
+    {
+        FilePrefetch prefetch(0, 0);
+        expected = scan(testFiles());
+    }
+    ASSERT_EQ(expected.size(), 4511);
+    for (size_t i = 0; i < expected.size(); ++i)
+        ASSERT_EQ(expected[i].first, static_cast<Int64>(i));
+
+    /// One file ahead, more files ahead than there are, and a budget too small for more than one chunk at a time.
+    for (auto [max_files, max_bytes] : std::vector<std::pair<size_t, size_t>>{{1, 64UL << 20}, {16, 64UL << 20}, {4, 1}})
+    {
+        FilePrefetch prefetch(max_files, max_bytes);
+        EXPECT_EQ(scan(testFiles()), expected) << "max_files " << max_files << ", max_bytes " << max_bytes;
+    }
+}
+
+TEST(FilePrefetch, SingleFile)
+{
+    std::vector<String> paths{testFiles()[3]};
+    std::vector<std::pair<Int64, String>> expected;
+    {
+        FilePrefetch prefetch(0, 0);
+        expected = scan(paths);
+    }
+    FilePrefetch prefetch(4, 64UL << 20);
+    EXPECT_EQ(scan(paths), expected);
+}
+
+TEST(FilePrefetch, MissingFileFailsTheScan)
+{
+    /// The error of a file opened in the background surfaces when the scan gets to it, as it does without prefetching.
+    auto paths = testFiles();
+    paths.insert(paths.begin() + 2, (std::filesystem::temp_directory_path() / "gtest_file_prefetch_missing.parquet").string());
+    for (size_t max_files : {0, 4})
+    {
+        FilePrefetch prefetch(max_files, 64UL << 20);
+        EXPECT_ANY_THROW(scan(paths)) << "max_files " << max_files;
+    }
+}
+
+#endif
@@ -0,0 +1,161 @@
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <Interpreters/ActionsDAG.h>
+#include <Interpreters/ExpressionActions.h>
+#include <Parser/SerializedPlanParser.h>
+#include <gtest/gtest.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+/// Function anchors of the test plans.
+constexpr int32_t get_json_object = 1;
+constexpr int32_t upper = 2;
+
+google::protobuf::RepeatedPtrField<substrait::extensions::SimpleExtensionDeclaration> extensions()
+{
+    google::protobuf::RepeatedPtrField<substrait::extensions::SimpleExtensionDeclaration> result;
+    std::vector<std::pair<int32_t, String>> functions{{get_json_object, "get_json_object:str_str"}, {upper, "upper:str"}};
+    for (const auto & [anchor, name] : functions)
+    {
+        auto * function = result.Add()->mutable_extension_function();
+        function->set_function_anchor(anchor);
+        function->set_name(name);
+    }
+    return result;
+}
+
+substrait::Expression selection(int32_t field)
+{
+    substrait::Expression expr;
+    expr.mutable_selection()->mutable_direct_reference()->mutable_struct_field()->set_field(field);
+    return expr;
+}
+
+substrait::Expression function(int32_t anchor, const std::vector<substrait::Expression> & args)
+{
+    substrait::Expression expr;
+    auto * scalar_function = expr.mutable_scalar_function();
+    scalar_function->set_function_reference(anchor);
+    for (const auto & arg : args)
+        *scalar_function->add_arguments()->mutable_value() = arg;
+    return expr;
+}
+
+/// get_json_object(column field, path).
+substrait::Expression getJsonObject(int32_t field, const String & path)
+{
+    substrait::Expression literal;
+    literal.mutable_literal()->set_string(path);
+    return function(get_json_object, {selection(field), literal});
+}
+
+/// "json" is nullable and holds null, invalid JSON, an empty string and documents missing some of the paths. "other" is
+/// a second JSON column, whose calls are fused apart from those of "json".
+Block testBlock()
+{
+    auto json = ColumnNullable::create(ColumnString::create(), ColumnUInt8::create());
+    auto other = ColumnString::create();
+    std::vector<std::pair<std::optional<String>, String>> rows{
+        {{}, R"({"a":1})"},
+        {R"({"a":1,"b":"x","c":[1,2]})", R"({"a":2})"},
+        {"not json", "{"},
+        {"", ""},
+        {"{}", "{}"},
+        {R"({"a":{"b":[1,{"c":2}]},"b":null})", R"({"a":[3]})"},
+        {"[1,2]", "[]"},
+        {R"({"a":"é","b":true,"c":[{"d":"e"}]})", R"({"b":1})"},
+        {R"({"a":"y","b":"x"} trailing)", R"({"a":"z"})"}};
+    for (const auto & [json_value, other_value] : rows)
+    {
+        if (json_value)
+            json->insert(Field(*json_value));
+        else
+            json->insertDefault();
+        other->insert(Field(other_value));
+    }
+    return Block{
+        {std::move(json), makeNullable(std::make_shared<DataTypeString>()), "json"},
+        {std::move(other), std::make_shared<DataTypeString>(), "other"}};
+}
+
+/// Number of get_json_object_multi nodes of the projection dag.
+size_t fusedCalls(const ActionsDAG & dag)
+{
+    size_t calls = 0;
+    for (const auto & node : dag.getNodes())
+        calls += node.type == ActionsDAG::ActionType::FUNCTION && node.function_base->getName() == "get_json_object_multi";
+    return calls;
+}
+
+/// Evaluates the projection of expressions over the test block, returns its columns in the order of expressions.
+Columns project(const std::vector<substrait::Expression> & expressions, size_t expected_fused_calls)
+{
+    SerializedPlanParser parser(SerializedPlanParser::global_context);
+    parser.parseExtensions(extensions());
+    auto block = testBlock();
+    auto header = block.cloneEmpty();
+    auto dag = parser.expressionsToActionsDAG(expressions, header, header);
+    EXPECT_EQ(fusedCalls(*dag), expected_fused_calls);
+
+    ExpressionActions actions(dag);
+    actions.execute(block);
+    EXPECT_EQ(block.columns(), expressions.size());
+    return block.getColumns();
+}
+
+/// Checks the fused projection of expressions gives the results of each expression projected on its own, where no call
+/// is fused.
+void checkFused(const std::vector<substrait::Expression> & expressions, size_t expected_fused_calls)
+{
+    auto fused = project(expressions, expected_fused_calls);
+    ASSERT_EQ(fused.size(), expressions.size());
+    for (size_t i = 0; i < expressions.size(); ++i)
+    {
+        auto unfused = project({expressions[i]}, 0);
+        ASSERT_EQ(unfused.size(), 1);
+        ASSERT_EQ(fused[i]->size(), unfused[0]->size());
+        for (size_t row = 0; row < unfused[0]->size(); ++row)
+            EXPECT_EQ((*fused[i])[row], (*unfused[0])[row]) << "expression " << i << ", row " << row;
+    }
+}
+}
+
+TEST(GetJsonObject, FusedSameAsUnfused)
+{
+    /// Paths of nested objects and arrays, a missing path and a path given twice.
+    checkFused(
+        {getJsonObject(0, "$.a"),
+         getJsonObject(0, "$.b"),
+         getJsonObject(0, "$.a.b[1].c"),
+         getJsonObject(0, "$.c[0]"),
+         getJsonObject(0, "$.missing"),
+         getJsonObject(0, "$.a")},
+        1);
+}
+
+TEST(GetJsonObject, MixedWithNonFusedCalls)
+{
+    /// The calls on "json" are fused, including the one under upper. The single call on "other" and the plain column
+    /// are left as they are.
+    checkFused(
+        {getJsonObject(0, "$.a"),
+         function(upper, {getJsonObject(0, "$.b")}),
+         getJsonObject(1, "$.a"),
+         selection(0),
+         getJsonObject(0, "$.c[*].d")},
+        1);
+    /// Two paths on each column, one get_json_object_multi for each.
+    checkFused({getJsonObject(0, "$.a"), getJsonObject(1, "$.a"), getJsonObject(0, "$.b"), getJsonObject(1, "$.b")}, 2);
+}
+
+TEST(GetJsonObject, SinglePathNotFused)
+{
+    /// The same call twice is one path, it isn't fused.
+    checkFused({getJsonObject(0, "$.a"), getJsonObject(0, "$.a")}, 0);
+}
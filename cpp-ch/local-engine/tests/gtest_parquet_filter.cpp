@@ -0,0 +1,343 @@
+#include "config.h"
+
+#if USE_PARQUET
+
+#include <filesystem>
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeDate32.h>
+#include <DataTypes/DataTypeDateTime64.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesDecimal.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Functions/FunctionFactory.h>
+#include <Interpreters/ExpressionActions.h>
+#include <Parser/SerializedPlanParser.h>
+#include <Poco/Util/MapConfiguration.h>
+#include <Processors/Executors/PullingPipelineExecutor.h>
+#include <QueryPipeline/QueryPipeline.h>
+#include <Storages/MergeTree/KeyCondition.h>
+#include <Storages/SelectQueryInfo.h>
+#include <Storages/SubstraitSource/SubstraitFileSource.h>
+#include <gtest/gtest.h>
+#include <parquet/arrow/writer.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+constexpr size_t row_group_rows = 100;
+constexpr size_t num_row_groups = 5;
+constexpr size_t num_rows = row_group_rows * num_row_groups;
+
+/// Builds a column of num_rows values, value(i) returns nullopt for a null.
+template <typename Builder, typename Value>
+std::shared_ptr<arrow::Array>
+makeArray(const std::shared_ptr<arrow::DataType> & type, const std::function<std::optional<Value>(size_t)> & value)
+{
+    auto builder = arrow::MakeBuilder(type).ValueOrDie();
+    auto & typed = static_cast<Builder &>(*builder);
+    for (size_t i = 0; i < num_rows; ++i)
+    {
+        auto v = value(i);
+        EXPECT_TRUE((v ? typed.Append(*v) : typed.AppendNull()).ok());
+    }
+    std::shared_ptr<arrow::Array> array;
+    EXPECT_TRUE(builder->Finish(&array).ok());
+    return array;
+}
+
+/// Row groups of row_group_rows rows. In every column but "nulls" the values increase with the row, so the row groups
+/// hold disjoint ranges.
+/// - i8, i32, i64: signed, negative in the first groups.
+/// - u32: crosses 2^31 in the third group, where signed and unsigned order disagree.
+/// - dec: Decimal(10, 2).
+/// - str: zero padded, "tail" is ASCII but for non-ASCII UTF-8 strings in the last group.
+/// - date: days before and after the epoch.
+/// - ts: microseconds.
+/// - nulls: the third group is all null, the fourth has a null in every other row.
+String writeTestFile()
+{
+    auto path = std::filesystem::temp_directory_path() / "gtest_parquet_filter.parquet";
+    auto signed_value = [](size_t i) -> Int64 { return static_cast<Int64>(i) - 250; };
+    auto padded = [](size_t i)
+    {
+        String s = std::to_string(i);
+        return String(5 - s.size(), '0') + s;
+    };
+    std::vector<std::shared_ptr<arrow::Field>> fields{
+        arrow::field("i8", arrow::int8(), false),
+        arrow::field("i32", arrow::int32(), false),
+        arrow::field("i64", arrow::int64(), false),
+        arrow::field("u32", arrow::uint32(), false),
+        arrow::field("dec", arrow::decimal128(10, 2), false),
+        arrow::field("str", arrow::utf8(), false),
+        arrow::field("tail", arrow::utf8(), false),
+        arrow::field("date", arrow::date32(), false),
+        arrow::field("ts", arrow::timestamp(arrow::TimeUnit::MICRO), false),
+        arrow::field("nulls", arrow::int64(), true)};
+    std::vector<std::shared_ptr<arrow::Array>> arrays{
+        makeArray<arrow::Int8Builder, int8_t>(arrow::int8(), [](size_t i) { return static_cast<int8_t>(i / 4 - 62); }),
+        makeArray<arrow::Int32Builder, int32_t>(arrow::int32(), [&](size_t i) { return static_cast<int32_t>(signed_value(i)); }),
+        makeArray<arrow::Int64Builder, int64_t>(arrow::int64(), [&](size_t i) { return signed_value(i) * 1000000000000L; }),
+        makeArray<arrow::UInt32Builder, uint32_t>(arrow::uint32(), [](size_t i) { return static_cast<uint32_t>(i * 8000000); }),
+        makeArray<arrow::Decimal128Builder, arrow::Decimal128>(
+            arrow::decimal128(10, 2), [&](size_t i) { return arrow::Decimal128(signed_value(i) * 101); }),
+        makeArray<arrow::StringBuilder, String>(arrow::utf8(), [&](size_t i) { return "s" + padded(i); }),
+        makeArray<arrow::StringBuilder, String>(
+            arrow::utf8(), [&](size_t i) { return (i < 4 * row_group_rows ? "a" : "\xc3\xa9") + padded(i); }),
+        makeArray<arrow::Date32Builder, int32_t>(arrow::date32(), [&](size_t i) { return static_cast<int32_t>(signed_value(i)); }),
+        makeArray<arrow::TimestampBuilder, int64_t>(
+            arrow::timestamp(arrow::TimeUnit::MICRO), [&](size_t i) { return signed_value(i) * 3600000000L; }),
+        makeArray<arrow::Int64Builder, int64_t>(
+            arrow::int64(),
+            [&](size_t i) -> std::optional<int64_t>
+            {
+                if (i / row_group_rows == 2 || (i / row_group_rows == 3 && i % 2))
+                    return {};
+                return signed_value(i);
+            })};
+    auto table = arrow::Table::Make(arrow::schema(fields), arrays);
+    auto out = arrow::io::FileOutputStream::Open(path.string()).ValueOrDie();
+    EXPECT_TRUE(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), out, row_group_rows).ok());
+    EXPECT_TRUE(out->Close().ok());
+    return path;
+}
+
+Block testHeader()
+{
+    return Block{
+        {std::make_shared<DataTypeInt8>(), "i8"},
+        {std::make_shared<DataTypeInt32>(), "i32"},
+        {std::make_shared<DataTypeInt64>(), "i64"},
+        {std::make_shared<DataTypeUInt32>(), "u32"},
+        {std::make_shared<DataTypeDecimal<Decimal64>>(10, 2), "dec"},
+        {std::make_shared<DataTypeString>(), "str"},
+        {std::make_shared<DataTypeString>(), "tail"},
+        {std::make_shared<DataTypeDate32>(), "date"},
+        {std::make_shared<DataTypeDateTime64>(6), "ts"},
+        {makeNullable(std::make_shared<DataTypeInt64>()), "nulls"}};
+}
+
+/// `function(column, value)`, or `function(column)` without a value, as the filter of a scan of header.
+PrewhereInfoPtr makeFilter(const Block & header, const String & function, const String & column, std::optional<Field> value = {})
+{
+    auto context = SerializedPlanParser::global_context;
+    auto prewhere_info = std::make_shared<PrewhereInfo>();
+    auto dag = std::make_shared<ActionsDAG>(header.getNamesAndTypesList());
+    ActionsDAG::NodeRawConstPtrs args{&dag->findInOutputs(column)};
+    if (value)
+    {
+        auto type = removeNullable(header.getByName(column).type);
+        args.push_back(&dag->addColumn({type->createColumnConst(1, *value), type, toString(*value)}));
+    }
+    const auto & node = dag->addFunction(FunctionFactory::instance().get(function, context), args, "");
+    dag->addOrReplaceInOutputs(node);
+    prewhere_info->prewhere_actions = dag;
+    prewhere_info->prewhere_column_name = node.result_name;
+    prewhere_info->need_filter = true;
+    return prewhere_info;
+}
+
+/// `less(function(), 0)`, a filter no row passes that the prewhere must leave alone, function takes no arguments.
+PrewhereInfoPtr makeNonDeterministicFilter(const Block & header, const String & function)
+{
+    auto context = SerializedPlanParser::global_context;
+    auto prewhere_info = std::make_shared<PrewhereInfo>();
+    auto dag = std::make_shared<ActionsDAG>(header.getNamesAndTypesList());
+    const auto & value = dag->addFunction(FunctionFactory::instance().get(function, context), {}, "");
+    auto type = std::make_shared<DataTypeUInt64>();
+    const auto & zero = dag->addColumn({type->createColumnConst(1, Field(UInt64(0))), type, "0"});
+    const auto & node = dag->addFunction(FunctionFactory::instance().get("less", context), {&value, &zero}, "");
+    dag->addOrReplaceInOutputs(node);
+    prewhere_info->prewhere_actions = dag;
+    prewhere_info->prewhere_column_name = node.result_name;
+    prewhere_info->need_filter = true;
+    return prewhere_info;
+}
+
+struct ScanResult
+{
+    /// The rows of the file that pass the filter, in file order.
+    std::vector<std::vector<Field>> rows;
+    size_t total_row_groups = 0;
+    size_t skipped_row_groups = 0;
+};
+
+/// Scans the file and applies the filter to the output, as the filter step following the scan does. With prune the
+/// scan is given the filter too, to skip row groups by their statistics, with prewhere to evaluate it ahead of the other
+/// columns.
+ScanResult scan(const String & path, const Block & header, const PrewhereInfoPtr & filter, bool prune, bool prewhere = false)
+{
+    auto context = SerializedPlanParser::global_context;
+    substrait::ReadRel::LocalFiles files;
+    auto * file = files.add_items();
+    file->set_uri_file("file://" + path);
+    file->set_start(0);
+    file->set_length(std::filesystem::file_size(path));
+    file->mutable_parquet();
+
+    std::shared_ptr<const KeyCondition> key_condition;
+    if (prune)
+    {
+        auto key_expr = std::make_shared<ExpressionActions>(std::make_shared<ActionsDAG>(header.getNamesAndTypesList()));
+        key_condition = std::make_shared<const KeyCondition>(
+            filter->prewhere_actions->clone(), context, header.getNames(), key_expr, NameSet{});
+    }
+    auto source = std::make_shared<SubstraitFileSource>(context, header, files, key_condition, prewhere ? filter : nullptr);
+    QueryPipeline pipeline(source);
+    PullingPipelineExecutor executor(pipeline);
+    ExpressionActions filter_actions(filter->prewhere_actions->clone());
+
+    ScanResult result;
+    Block block;
+    while (executor.pull(block))
+    {
+        filter_actions.execute(block);
+        const auto & passed = *block.getByName(filter->prewhere_column_name).column->convertToFullColumnIfConst();
+        for (size_t row = 0; row < block.rows(); ++row)
+        {
+            if (!passed.getBool(row))
+                continue;
+            auto & fields = result.rows.emplace_back();
+            for (const auto & column : header)
+                fields.push_back((*block.getByName(column.name).column)[row]);
+        }
+    }
+    result.total_row_groups = source->getReadStats().total_row_groups;
+    result.skipped_row_groups = source->getReadStats().skipped_row_groups;
+    return result;
+}
+
+const String & testFilePath()
+{
+    static const String path = writeTestFile();
+    return path;
+}
+
+/// Checks the scan with pruning returns the rows of the scan without, and skips skipped_row_groups row groups.
+void checkPruning(const PrewhereInfoPtr & filter, size_t skipped_row_groups, bool prewhere = false)
+{
+    const auto & path = testFilePath();
+    auto header = testHeader();
+    auto pruned = scan(path, header, filter, !prewhere, prewhere);
+    auto full = scan(path, header, filter, false);
+    EXPECT_EQ(full.skipped_row_groups, 0);
+    EXPECT_EQ(pruned.total_row_groups, num_row_groups);
+    EXPECT_EQ(pruned.skipped_row_groups, skipped_row_groups) << "filter " << filter->prewhere_column_name;
+    EXPECT_EQ(pruned.rows, full.rows) << "filter " << filter->prewhere_column_name;
+}
+
+/// Turns the parquet prewhere on for the lifetime of the object, the tests run with an empty config.
+class PrewhereEnabled
+{
+public:
+    explicit PrewhereEnabled(bool enabled)
+    {
+        Poco::AutoPtr<Poco::Util::MapConfiguration> config(new Poco::Util::MapConfiguration());
+        config->setBool("parquet.prewhere.enabled", enabled);
+        SerializedPlanParser::global_context->setConfig(config);
+    }
+
+    ~PrewhereEnabled() { SerializedPlanParser::global_context->setConfig(Poco::AutoPtr(new Poco::Util::MapConfiguration())); }
+};
+}
+
+TEST(ParquetFilter, SignedIntegers)
+{
+    auto header = testHeader();
+    /// Rows 332 on, the last two groups.
+    checkPruning(makeFilter(header, "greater", "i8", Field(Int64(20))), 3);
+    /// Rows 0 to 89, negative values of the first group only.
+    checkPruning(makeFilter(header, "less", "i32", Field(Int64(-160))), 4);
+    checkPruning(makeFilter(header, "equals", "i64", Field(Int64(-1000000000000L))), 4);
+    /// No row matches, every group is skipped.
+    checkPruning(makeFilter(header, "greater", "i64", Field(Int64(1000000000000000L))), 5);
+}
+
+TEST(ParquetFilter, UnsignedIntegers)
+{
+    auto header = testHeader();
+    /// Unsigned statistics aren't used, in signed order the values past 2^31 would look negative.
+    checkPruning(makeFilter(header, "greater", "u32", Field(UInt64(3000000000UL))), 0);
+    checkPruning(makeFilter(header, "less", "u32", Field(UInt64(100000000UL))), 0);
+}
+
+TEST(ParquetFilter, Decimals)
+{
+    auto header = testHeader();
+    /// Decimals are stored as fixed length byte arrays, whose statistics aren't used.
+    checkPruning(makeFilter(header, "greater", "dec", Field(DecimalField<Decimal64>(10000, 2))), 0);
+}
+
+TEST(ParquetFilter, Strings)
+{
+    auto header = testHeader();
+    checkPruning(makeFilter(header, "greaterOrEquals", "str", Field(String("s00450"))), 4);
+    checkPruning(makeFilter(header, "less", "str", Field(String("s00100"))), 4);
+    /// Byte arrays are ordered unsigned like ClickHouse strings, the non-ASCII strings of the last group come after "z".
+    checkPruning(makeFilter(header, "greater", "tail", Field(String("z"))), 4);
+    checkPruning(makeFilter(header, "less", "tail", Field(String("b"))), 1);
+}
+
+TEST(ParquetFilter, Dates)
+{
+    auto header = testHeader();
+    /// Days -250 to -161.
+    checkPruning(makeFilter(header, "less", "date", Field(Int64(-160))), 4);
+    checkPruning(makeFilter(header, "greaterOrEquals", "date", Field(Int64(0))), 2);
+}
+
+TEST(ParquetFilter, Timestamps)
+{
+    auto header = testHeader();
+    /// Timestamps are read as DateTime64, whose statistics aren't used.
+    checkPruning(makeFilter(header, "greater", "ts", Field(DecimalField<DateTime64>(0, 6))), 0);
+}
+
+TEST(ParquetFilter, NullOnlyGroups)
+{
+    auto header = testHeader();
+    /// The all-null group has no min/max and is kept, the groups of values below 60 are skipped.
+    checkPruning(makeFilter(header, "greater", "nulls", Field(Int64(60))), 2);
+    /// Only the groups with nulls may match, their max is past all the values.
+    checkPruning(makeFilter(header, "isNull", "nulls"), 3);
+    checkPruning(makeFilter(header, "isNotNull", "nulls"), 0);
+}
+
+TEST(ParquetFilter, Prewhere)
+{
+    PrewhereEnabled prewhere(true);
+    auto header = testHeader();
+    /// The statistics of unsigned columns aren't used, the row groups are skipped by the prewhere only.
+    /// Rows 376 on.
+    checkPruning(makeFilter(header, "greater", "u32", Field(UInt64(3000000000UL))), 3, true);
+    /// Rows 0 to 12.
+    checkPruning(makeFilter(header, "less", "u32", Field(UInt64(100000000UL))), 4, true);
+    checkPruning(makeFilter(header, "greater", "u32", Field(UInt64(4000000000UL))), 5, true);
+    checkPruning(makeFilter(header, "greater", "dec", Field(DecimalField<Decimal64>(10000, 2))), 3, true);
+    checkPruning(makeFilter(header, "isNull", "nulls"), 3, true);
+    /// Every row group has rows passing, they are filtered but none is skipped.
+    checkPruning(makeFilter(header, "notEquals", "i64", Field(Int64(0))), 0, true);
+}
+
+TEST(ParquetFilter, PrewhereNonDeterministic)
+{
+    PrewhereEnabled prewhere(true);
+    auto header = testHeader();
+    /// No row passes, yet no row group is skipped, the filter isn't evaluated ahead of the filter step.
+    checkPruning(makeNonDeterministicFilter(header, "rand"), 0, true);
+    checkPruning(makeNonDeterministicFilter(header, "rowNumberInBlock"), 0, true);
+}
+
+TEST(ParquetFilter, PrewhereDisabled)
+{
+    PrewhereEnabled prewhere(false);
+    auto header = testHeader();
+    checkPruning(makeFilter(header, "greater", "u32", Field(UInt64(3000000000UL))), 0, true);
+}
+
+#endif
@@ -0,0 +1,165 @@
+#include <thread>
+#include <Columns/ColumnArray.h>
+#include <Columns/ColumnConst.h>
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Functions/FunctionFactory.h>
+#include <Functions/Regexps.h>
+#include <Parser/SerializedPlanParser.h>
+#include <gtest/gtest.h>
+
+using namespace DB;
+
+namespace
+{
+const std::vector<String> haystacks{
+    "",
+    "a1b22c333",
+    "no digits",
+    "x9y8z7-x10",
+    "key=v1, key=v22; other=v3",
+    "line1\nline2\nkey=nl\nv4",
+    "x1x2x3x4x5x6x7x8x9x10x11x12"};
+
+using Result = std::vector<std::vector<String>>;
+
+/// regexpExtractAllSpark without the regexp cache: the pattern is compiled for the call, as the function did before.
+Result extractAll(const String & pattern, size_t index)
+{
+    const auto regexp = Regexps::createRegexp<false, false, false>(pattern);
+    OptimizedRegularExpression::MatchVec matches;
+    Result result;
+    for (const auto & haystack : haystacks)
+    {
+        auto & row = result.emplace_back();
+        const char * pos = haystack.data();
+        const char * end = pos + haystack.size();
+        while (pos < end)
+        {
+            regexp.match(pos, end - pos, matches, static_cast<unsigned>(index + 1));
+            if (index >= matches.size())
+                break;
+            const auto & match = matches[index];
+            row.push_back(match.offset == std::string::npos ? "" : String(pos + match.offset, match.length));
+            pos += matches[0].offset + matches[0].length;
+        }
+    }
+    return result;
+}
+
+/// One instance of the function, so that its calls go through the same cached pattern.
+class RegexpExtractAll
+{
+public:
+    RegexpExtractAll()
+        : function(FunctionFactory::instance().get("regexpExtractAllSpark", local_engine::SerializedPlanParser::global_context))
+    {
+    }
+
+    Result operator()(const String & pattern, size_t index) const
+    {
+        auto haystack_column = ColumnString::create();
+        for (const auto & haystack : haystacks)
+            haystack_column->insert(Field(haystack));
+        auto string_type = std::make_shared<DataTypeString>();
+        auto index_type = std::make_shared<DataTypeInt32>();
+        ColumnsWithTypeAndName arguments{
+            {std::move(haystack_column), string_type, "haystack"},
+            {string_type->createColumnConst(haystacks.size(), Field(pattern)), string_type, "pattern"},
+            {index_type->createColumnConst(haystacks.size(), Field(static_cast<Int64>(index))), index_type, "index"}};
+        auto executable = function->build(arguments);
+        auto column = executable->execute(arguments, executable->getResultType(), haystacks.size());
+
+        const auto & array = assert_cast<const ColumnArray &>(*column->convertToFullColumnIfConst());
+        const auto & strings = assert_cast<const ColumnString &>(array.getData());
+        Result result;
+        for (size_t row = 0; row < array.size(); ++row)
+        {
+            auto & values = result.emplace_back();
+            for (size_t i = array.getOffsets()[row - 1]; i < array.getOffsets()[row]; ++i)
+                values.push_back(strings.getDataAt(i).toString());
+        }
+        return result;
+    }
+
+private:
+    FunctionOverloadResolverPtr function;
+};
+
+/// Patterns with and without groups, a group that may not take part in the match, and a dot that matches newlines.
+const std::vector<std::pair<String, size_t>> patterns{
+    {"\\d+", 0},
+    {"([a-z])(\\d+)", 1},
+    {"([a-z])(\\d+)", 2},
+    {"(\\w+)=v(\\d+)", 2},
+    {"(\\w+)=(x)?v(\\d)", 2},
+    {"\\d.k", 0},
+    {"x(1\\d)", 1}};
+}
+
+TEST(RegexpExtractAll, SameAsWithoutCache)
+{
+    RegexpExtractAll function;
+    /// Each pattern three times: compiled, then from the function's cached pattern.
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (const auto & [pattern, index] : patterns)
+            EXPECT_EQ(function(pattern, index), extractAll(pattern, index)) << "pattern " << pattern << ", index " << index;
+    }
+}
+
+TEST(RegexpExtractAll, SharedBetweenFunctions)
+{
+    /// The second function finds the patterns the first one compiled in the process wide cache.
+    RegexpExtractAll first;
+    RegexpExtractAll second;
+    for (const auto & [pattern, index] : patterns)
+    {
+        auto expected = extractAll(pattern, index);
+        EXPECT_EQ(first(pattern, index), expected) << "pattern " << pattern;
+        EXPECT_EQ(second(pattern, index), expected) << "pattern " << pattern;
+    }
+}
+
+TEST(RegexpExtractAll, CacheFull)
+{
+    /// More distinct patterns than the cache holds, it's dropped on the way and the first patterns are compiled again.
+    RegexpExtractAll function;
+    for (size_t i = 0; i < 1100; ++i)
+    {
+        auto pattern = "x" + std::to_string(i % 13) + "|" + std::to_string(i) + "(\\d)";
+        ASSERT_EQ(function(pattern, 0), extractAll(pattern, 0)) << "pattern " << pattern;
+    }
+    for (const auto & [pattern, index] : patterns)
+        EXPECT_EQ(function(pattern, index), extractAll(pattern, index)) << "pattern " << pattern;
+}
+
+TEST(RegexpExtractAll, ConcurrentCalls)
+{
+    /// The threads of a query share the function, each switches between the patterns.
+    RegexpExtractAll function;
+    std::vector<Result> expected;
+    for (const auto & [pattern, index] : patterns)
+        expected.push_back(extractAll(pattern, index));
+
+    std::atomic<size_t> mismatches = 0;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 8; ++t)
+    {
+        threads.emplace_back(
+            [&, t]
+            {
+                for (size_t i = 0; i < 100; ++i)
+                {
+                    size_t p = (t + i) % patterns.size();
+                    if (function(patterns[p].first, patterns[p].second) != expected[p])
+                        ++mismatches;
+                }
+            });
+    }
+    for (auto & thread : threads)
+        thread.join();
+    EXPECT_EQ(mismatches, 0);
+}
@@ -0,0 +1,136 @@
+#include <IO/ReadHelpers.h>
+#include <Shuffle/ShuffleReader.h>
+#include <gtest/gtest.h>
+#include <Common/Exception.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+/// Serves data in chunks of at most buffer_size bytes, throws instead of returning the chunk at fail_at if set.
+class StringReadAheadBuffer : public ReadBufferWithReadAhead
+{
+public:
+    StringReadAheadBuffer(String data_, size_t buffer_size_, bool read_ahead_, std::optional<size_t> fail_at_ = {})
+        : ReadBufferWithReadAhead(buffer_size_, read_ahead_), data(std::move(data_)), fail_at(fail_at_)
+    {
+    }
+
+    ~StringReadAheadBuffer() override { stopReadAhead(); }
+
+    std::atomic<size_t> attached = 0;
+    std::atomic<size_t> detached = 0;
+
+private:
+    int readChunk(char * to) override
+    {
+        if (fail_at && offset >= *fail_at)
+            throw std::runtime_error("broken stream");
+        size_t count = std::min(buffer_size, data.size() - offset);
+        memcpy(to, data.data() + offset, count);
+        offset += count;
+        return static_cast<int>(count);
+    }
+
+    void attachReadAheadThread() override { ++attached; }
+    void detachReadAheadThread() override { ++detached; }
+
+    const String data;
+    const std::optional<size_t> fail_at;
+    size_t offset = 0;
+};
+
+String makeData(size_t size)
+{
+    String data(size, '\0');
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<char>(i * 31 % 251);
+    return data;
+}
+
+String readAll(ReadBuffer & in)
+{
+    String out;
+    readStringUntilEOF(out, in);
+    return out;
+}
+}
+
+TEST(ShuffleReadAhead, SwapsBuffers)
+{
+    auto data = makeData(10000);
+    for (bool read_ahead : {false, true})
+    {
+        /// 10000 is not a multiple of the buffer size, the last chunk is shorter.
+        StringReadAheadBuffer in(data, 333, read_ahead);
+        EXPECT_EQ(readAll(in), data);
+        EXPECT_TRUE(in.eof());
+        /// 31 chunks and the read at the end.
+        EXPECT_EQ(in.getReadCalls(), 32);
+        EXPECT_EQ(in.getReadBytes(), data.size());
+    }
+}
+
+TEST(ShuffleReadAhead, AttachesHelperThreadOnce)
+{
+    StringReadAheadBuffer in(makeData(1000), 100, true);
+    readAll(in);
+    EXPECT_EQ(in.attached, 1);
+    /// The helper thread ends with the stream.
+    for (size_t i = 0; i < 100 && !in.detached; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(in.detached, 1);
+}
+
+TEST(ShuffleReadAhead, EmptyStream)
+{
+    for (bool read_ahead : {false, true})
+    {
+        StringReadAheadBuffer in("", 100, read_ahead);
+        EXPECT_TRUE(in.eof());
+        EXPECT_TRUE(in.eof());
+        EXPECT_EQ(readAll(in), "");
+        EXPECT_EQ(in.getReadBytes(), 0);
+    }
+}
+
+TEST(ShuffleReadAhead, NeverRead)
+{
+    /// The helper thread isn't started, nothing is read.
+    StringReadAheadBuffer in(makeData(1000), 100, true);
+    EXPECT_EQ(in.getReadCalls(), 0);
+    EXPECT_EQ(in.attached, 0);
+}
+
+TEST(ShuffleReadAhead, DestroyedBeforeEnd)
+{
+    /// The helper thread waits with a chunk read ahead, the destructor stops and joins it.
+    auto in = std::make_unique<StringReadAheadBuffer>(makeData(100000), 100, true);
+    char c;
+    in->readStrict(&c, 1);
+    in.reset();
+}
+
+TEST(ShuffleReadAhead, RethrowsError)
+{
+    auto data = makeData(1000);
+    for (bool read_ahead : {false, true})
+    {
+        StringReadAheadBuffer in(data, 100, read_ahead, 500);
+        String prefix(500, '\0');
+        in.readStrict(prefix.data(), prefix.size());
+        EXPECT_EQ(prefix, data.substr(0, 500));
+        try
+        {
+            in.eof();
+            FAIL() << "the error of the stream is not rethrown";
+        }
+        catch (const std::runtime_error & e)
+        {
+            EXPECT_STREQ(e.what(), "broken stream");
+        }
+        /// It stays failed.
+        EXPECT_THROW(in.eof(), std::runtime_error);
+    }
+}
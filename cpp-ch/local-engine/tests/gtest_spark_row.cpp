@@ -452,3 +452,112 @@ TEST(SparkRow, NullableComplexTypes)
     assertReadConsistentWithWritten(*spark_row_info, *block, type_and_fields);
     EXPECT_TRUE(spark_row_info->getTotalBytes() == 8 + 3 * 8);
 }
+
+TEST(SparkRow, MultipleRows)
+{
+    const auto int_type = std::make_shared<DataTypeNullable>(std::make_shared<DataTypeInt32>());
+    const auto string_type = std::make_shared<DataTypeString>();
+    const auto nullable_string_type = std::make_shared<DataTypeNullable>(std::make_shared<DataTypeString>());
+    const auto double_type = std::make_shared<DataTypeFloat64>();
+    Block in({
+        {int_type, "a"},
+        {string_type, "b"},
+        {nullable_string_type, "c"},
+        {double_type, "d"},
+    });
+
+    const std::vector<std::vector<Field>> rows = {
+        {1, "", Null{}, 0.5},
+        {Null{}, "Hello World", "spark", -1.0},
+        {3, "a longer string that spans several words", "", 2.25},
+        {Null{}, "x", Null{}, 100.0},
+    };
+    auto columns = in.mutateColumns();
+    for (const auto & row : rows)
+        for (size_t i = 0; i < row.size(); ++i)
+            columns[i]->insert(row[i]);
+    in.setColumns(std::move(columns));
+
+    auto spark_row_info = CHColumnToSparkRow().convertCHColumnToSparkRow(in);
+    EXPECT_TRUE(spark_row_info->getNumRows() == static_cast<int64_t>(rows.size()));
+
+    auto out = SparkRowToCHColumn::convertSparkRowInfoToCHColumn(*spark_row_info, in.cloneEmpty());
+    EXPECT_TRUE(out->rows() == rows.size());
+    for (size_t col_idx = 0; col_idx < in.columns(); ++col_idx)
+        for (size_t row_idx = 0; row_idx < rows.size(); ++row_idx)
+            EXPECT_TRUE((*out->getByPosition(col_idx).column)[row_idx] == rows[row_idx][col_idx]);
+}
+
+TEST(SparkRow, MultipleRowsColumnWise)
+{
+    /// Each type is decoded both as a nullable column, with a null every third row, and as a not nullable one.
+    const DataTypes types = {
+        std::make_shared<DataTypeInt8>(),
+        std::make_shared<DataTypeDate>(),
+        std::make_shared<DataTypeFloat32>(),
+        std::make_shared<DataTypeDecimal32>(9, 2),
+        std::make_shared<DataTypeDecimal64>(18, 4),
+        std::make_shared<DataTypeDateTime64>(6),
+        std::make_shared<DataTypeString>(),
+    };
+    auto value = [](const DataTypePtr & type, size_t row) -> Field
+    {
+        Int64 signed_row = static_cast<Int64>(row) - 50;
+        switch (WhichDataType(type).idx)
+        {
+            case TypeIndex::Int8:
+                return Int8(signed_row * 2);
+            case TypeIndex::Date:
+                return UInt16(row * 300);
+            case TypeIndex::Float32:
+                return Float32(signed_row * 0.25f);
+            case TypeIndex::Decimal32:
+                return DecimalField<Decimal32>(signed_row * 1000003, 2);
+            case TypeIndex::Decimal64:
+                return DecimalField<Decimal64>(signed_row * 100000000007L, 4);
+            case TypeIndex::DateTime64:
+                return DecimalField<DateTime64>(signed_row * 86400000001L, 6);
+            default:
+                /// Empty, short and long strings, so that the rows have different lengths.
+                return String(row % 17 * 3, static_cast<char>('a' + row % 26));
+        }
+    };
+
+    ColumnsWithTypeAndName columns;
+    for (const auto & type : types)
+    {
+        columns.emplace_back(type, "a" + std::to_string(columns.size()));
+        columns.emplace_back(makeNullable(type), "a" + std::to_string(columns.size()));
+    }
+    Block in(columns);
+
+    constexpr size_t num_rows = 100;
+    std::vector<std::vector<Field>> rows(num_rows);
+    for (size_t row = 0; row < num_rows; ++row)
+    {
+        for (const auto & type : types)
+        {
+            rows[row].push_back(value(type, row));
+            rows[row].push_back(row % 3 == 1 ? Field(Null{}) : value(type, row));
+        }
+    }
+    auto in_columns = in.mutateColumns();
+    for (const auto & row : rows)
+        for (size_t i = 0; i < row.size(); ++i)
+            in_columns[i]->insert(row[i]);
+    in.setColumns(std::move(in_columns));
+
+    auto spark_row_info = CHColumnToSparkRow().convertCHColumnToSparkRow(in);
+    EXPECT_TRUE(spark_row_info->getNumRows() == static_cast<int64_t>(num_rows));
+
+    auto out = SparkRowToCHColumn::convertSparkRowInfoToCHColumn(*spark_row_info, in.cloneEmpty());
+    ASSERT_TRUE(out->rows() == num_rows);
+    for (size_t col_idx = 0; col_idx < in.columns(); ++col_idx)
+    {
+        const auto & out_col = out->getByPosition(col_idx);
+        EXPECT_TRUE(out_col.type->equals(*in.getByPosition(col_idx).type));
+        for (size_t row_idx = 0; row_idx < num_rows; ++row_idx)
+            EXPECT_TRUE((*out_col.column)[row_idx] == rows[row_idx][col_idx])
+                << out_col.type->getName() << " row " << row_idx << ": " << toString((*out_col.column)[row_idx]);
+    }
+}
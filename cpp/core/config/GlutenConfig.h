@@ -46,6 +46,11 @@ const std::string kUGITokens = "spark.gluten.ugi.tokens";
 
 const std::string kShuffleCompressionCodec = "spark.gluten.sql.columnar.shuffle.codec";
 const std::string kShuffleCompressionCodecBackend = "spark.gluten.sql.columnar.shuffle.codecBackend";
+const std::string kShuffleReaderPrefetchBatches = "spark.gluten.sql.columnar.shuffle.reader.prefetchBatches";
+const std::string kShuffleReaderCoalesceBatchRows = "spark.gluten.sql.columnar.shuffle.reader.coalesceBatchRows";
+const std::string kShuffleReaderCoalesceBatchBytes = "spark.gluten.sql.columnar.shuffle.reader.coalesceBatchBytes";
+const std::string kShufflePipelineThreads = "spark.gluten.sql.columnar.shuffle.pipelineThreads";
+const std::string kShufflePipelineMaxPendingBytes = "spark.gluten.sql.columnar.shuffle.pipelineMaxPendingBytes";
 const std::string kQatBackendName = "qat";
 const std::string kIaaBackendName = "iaa";
 
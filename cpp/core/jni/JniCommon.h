@@ -123,16 +123,8 @@ static inline void checkException(JNIEnv* env) {
 
 class SparkAllocationListener final : public gluten::AllocationListener {
  public:
-  SparkAllocationListener(
-      JavaVM* vm,
-      jobject javaListener,
-      jmethodID javaReserveMethod,
-      jmethodID javaUnreserveMethod,
-      int64_t blockSize)
-      : vm_(vm),
-        javaReserveMethod_(javaReserveMethod),
-        javaUnreserveMethod_(javaUnreserveMethod),
-        blockSize_(blockSize) {
+  SparkAllocationListener(JavaVM* vm, jobject javaListener, jmethodID javaReserveMethod, jmethodID javaUnreserveMethod)
+      : vm_(vm), javaReserveMethod_(javaReserveMethod), javaUnreserveMethod_(javaUnreserveMethod) {
     JNIEnv* env;
     attachCurrentThreadAsDaemonOrThrow(vm_, &env);
     javaListener_ = env->NewGlobalRef(javaListener);
@@ -148,54 +140,27 @@ class SparkAllocationListener final : public gluten::AllocationListener {
     env->DeleteGlobalRef(javaListener_);
   }
 
+  // Reserves or unreserves the exact size in Spark. Wrap it into a gluten::BlockAllocationListener to batch the calls.
   void allocationChanged(int64_t size) override {
-    updateReservation(size);
-  };
-
- private:
-  int64_t reserve(int64_t diff) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    bytesReserved_ += diff;
-    int64_t newBlockCount;
-    if (bytesReserved_ == 0) {
-      newBlockCount = 0;
-    } else {
-      // ceil to get the required block number
-      newBlockCount = (bytesReserved_ - 1) / blockSize_ + 1;
-    }
-    int64_t bytesGranted = (newBlockCount - blocksReserved_) * blockSize_;
-    blocksReserved_ = newBlockCount;
-    if (bytesReserved_ > maxBytesReserved_) {
-      maxBytesReserved_ = bytesReserved_;
+    if (size == 0) {
+      return;
     }
-    return bytesGranted;
-  }
-
-  void updateReservation(int64_t diff) {
     JNIEnv* env;
     attachCurrentThreadAsDaemonOrThrow(vm_, &env);
-    int64_t granted = reserve(diff);
-    if (granted == 0) {
-      return;
-    }
-    if (granted < 0) {
-      env->CallObjectMethod(javaListener_, javaUnreserveMethod_, -granted);
+    if (size < 0) {
+      env->CallObjectMethod(javaListener_, javaUnreserveMethod_, -size);
       checkException(env);
       return;
     }
-    env->CallObjectMethod(javaListener_, javaReserveMethod_, granted);
+    env->CallObjectMethod(javaListener_, javaReserveMethod_, size);
     checkException(env);
-  }
+  };
 
+ private:
   JavaVM* vm_;
   jobject javaListener_;
   jmethodID javaReserveMethod_;
   jmethodID javaUnreserveMethod_;
-  int64_t blockSize_;
-  int64_t blocksReserved_ = 0L;
-  int64_t bytesReserved_ = 0L;
-  int64_t maxBytesReserved_ = 0L;
-  std::mutex mutex_;
 };
 
 class RssClient {
@@ -29,6 +29,7 @@
 #include "operators/writer/Datasource.h"
 
 #include <arrow/c/bridge.h>
+#include <arrow/util/logging.h>
 #include "operators/serializer/ColumnarBatchSerializer.h"
 #include "shuffle/LocalPartitionWriter.h"
 #include "shuffle/PartitionWriterCreator.h"
@@ -78,6 +79,7 @@ static jmethodID veloxColumnarbatchScannerNext;
 
 static jclass shuffleReaderMetricsClass;
 static jmethodID shuffleReaderMetricsSetDecompressTime;
+static jmethodID shuffleReaderMetricsSetConsumerWaitTime;
 
 static ConcurrentMap<std::shared_ptr<ColumnarToRowConverter>> columnarToRowConverterHolder;
 
@@ -281,7 +283,7 @@ jint JNI_OnLoad(JavaVM* vm, void* reserved) {
   jniByteInputStreamClose = getMethodIdOrError(env, jniByteInputStreamClass, "close", "()V");
 
   splitResultClass = createGlobalClassReferenceOrError(env, "Lio/glutenproject/vectorized/SplitResult;");
-  splitResultConstructor = getMethodIdOrError(env, splitResultClass, "<init>", "(JJJJJJ[J[J)V");
+  splitResultConstructor = getMethodIdOrError(env, splitResultClass, "<init>", "(JJJJJJJJ[J[J)V");
 
   columnarBatchSerializeResultClass =
       createGlobalClassReferenceOrError(env, "Lio/glutenproject/vectorized/ColumnarBatchSerializeResult;");
@@ -324,6 +326,8 @@ jint JNI_OnLoad(JavaVM* vm, void* reserved) {
       createGlobalClassReferenceOrError(env, "Lio/glutenproject/vectorized/ShuffleReaderMetrics;");
   shuffleReaderMetricsSetDecompressTime =
       getMethodIdOrError(env, shuffleReaderMetricsClass, "setDecompressTime", "(J)V");
+  shuffleReaderMetricsSetConsumerWaitTime =
+      getMethodIdOrError(env, shuffleReaderMetricsClass, "setConsumerWaitTime", "(J)V");
 
   return jniVersion;
 }
@@ -778,7 +782,9 @@ JNIEXPORT jlong JNICALL Java_io_glutenproject_vectorized_ShuffleWriterJniWrapper
     jlong taskAttemptId,
     jint pushBufferMaxSize,
     jobject partitionPusher,
-    jstring partitionWriterTypeJstr) {
+    jstring partitionWriterTypeJstr,
+    jint sortBasedShuffleThreshold,
+    jboolean pipelinedWrite) {
   JNI_METHOD_START
   if (partitioningNameJstr == nullptr) {
     throw gluten::GlutenException(std::string("Short partitioning name can't be null"));
@@ -794,6 +800,9 @@ JNIEXPORT jlong JNICALL Java_io_glutenproject_vectorized_ShuffleWriterJniWrapper
     shuffleWriterOptions.buffer_size = bufferSize;
   }
   shuffleWriterOptions.offheap_per_task = offheapPerTask;
+  if (sortBasedShuffleThreshold > 0) {
+    shuffleWriterOptions.sort_based_shuffle_threshold = sortBasedShuffleThreshold;
+  }
 
   if (codecJstr != NULL) {
     shuffleWriterOptions.compression_type = getCompressionType(env, codecJstr, codecBackendJstr);
@@ -837,6 +846,20 @@ JNIEXPORT jlong JNICALL Java_io_glutenproject_vectorized_ShuffleWriterJniWrapper
 
     shuffleWriterOptions.write_schema = writeSchema;
     shuffleWriterOptions.prefer_evict = preferEvict;
+    if (numPartitions >= shuffleWriterOptions.sort_based_shuffle_threshold) {
+      // Per-partition buffers grow linearly with the partition number, sort rows in one buffer instead.
+      shuffleWriterOptions.shuffle_writer_type = "sort";
+      if (preferEvict) {
+        ARROW_LOG(WARNING) << "Sort based shuffle is used for " << numPartitions
+                           << " partitions, prefer evict is ignored";
+      }
+      shuffleWriterOptions.prefer_evict = false;
+    }
+    // the pipeline evicts through the prefer-evict partition writer only
+    shuffleWriterOptions.pipelined_write = pipelinedWrite && shuffleWriterOptions.prefer_evict;
+    if (pipelinedWrite && !shuffleWriterOptions.pipelined_write) {
+      ARROW_LOG(WARNING) << "Pipelined shuffle write requires prefer evict, it is disabled";
+    }
 
     if (numSubDirs > 0) {
       shuffleWriterOptions.num_sub_dirs = numSubDirs;
@@ -849,7 +872,7 @@ JNIEXPORT jlong JNICALL Java_io_glutenproject_vectorized_ShuffleWriterJniWrapper
     auto localDirs = env->GetStringUTFChars(localDirsJstr, JNI_FALSE);
     setenv("NATIVESQL_SPARK_LOCAL_DIRS", localDirs, 1);
     env->ReleaseStringUTFChars(localDirsJstr, localDirs);
-    partitionWriterCreator = std::make_shared<LocalPartitionWriterCreator>(preferEvict);
+    partitionWriterCreator = std::make_shared<LocalPartitionWriterCreator>(shuffleWriterOptions.prefer_evict);
   } else if (partitionWriterType == "celeborn") {
     shuffleWriterOptions.partition_writer_type = "celeborn";
     jclass celebornPartitionPusherClass =
@@ -946,6 +969,8 @@ Java_io_glutenproject_vectorized_ShuffleWriterJniWrapper_stop(JNIEnv* env, jobje
       shuffleWriter->totalWriteTime(),
       shuffleWriter->totalEvictTime(),
       shuffleWriter->totalCompressTime(),
+      shuffleWriter->totalCompressWallTime(),
+      shuffleWriter->totalWriteWallTime(),
       shuffleWriter->totalBytesWritten(),
       shuffleWriter->totalBytesEvicted(),
       partitionLengthArr,
@@ -991,10 +1016,29 @@ JNIEXPORT jlong JNICALL Java_io_glutenproject_vectorized_ShuffleReaderJniWrapper
   ReaderOptions options = ReaderOptions::defaults();
   options.ipc_read_options.memory_pool = pool.get();
   options.ipc_read_options.use_threads = false;
+  JavaVM* vm;
+  if (env->GetJavaVM(&vm) != JNI_OK) {
+    throw gluten::GlutenException("Unable to get JavaVM instance");
+  }
+  // the input stream attaches the prefetch thread to the JVM on its first read
+  options.prefetch_thread_exit = [vm] { vm->DetachCurrentThread(); };
   std::shared_ptr<arrow::Schema> schema =
       gluten::arrowGetOrThrow(arrow::ImportSchema(reinterpret_cast<struct ArrowSchema*>(cSchema)));
 
   auto backend = gluten::createBackend();
+  auto conf = backend->getConfMap();
+  auto got = conf.find(kShuffleReaderPrefetchBatches);
+  if (got != conf.end()) {
+    options.prefetch_batches = std::stoi(got->second);
+  }
+  got = conf.find(kShuffleReaderCoalesceBatchRows);
+  if (got != conf.end()) {
+    options.coalesce_batch_rows = std::stoi(got->second);
+  }
+  got = conf.find(kShuffleReaderCoalesceBatchBytes);
+  if (got != conf.end()) {
+    options.coalesce_batch_bytes = std::stol(got->second);
+  }
   auto reader = backend->getShuffleReader(in, schema, options, pool, (*allocator).get());
   return shuffleReaderHolder.insert(reader);
   JNI_METHOD_END(-1L)
@@ -1021,6 +1065,7 @@ JNIEXPORT void JNICALL Java_io_glutenproject_vectorized_ShuffleReaderJniWrapper_
   JNI_METHOD_START
   auto reader = shuffleReaderHolder.lookup(handle);
   env->CallVoidMethod(metrics, shuffleReaderMetricsSetDecompressTime, reader->getDecompressTime());
+  env->CallVoidMethod(metrics, shuffleReaderMetricsSetConsumerWaitTime, reader->getConsumerWaitTime());
   checkException(env);
   JNI_METHOD_END()
 }
@@ -1032,6 +1077,14 @@ JNIEXPORT void JNICALL Java_io_glutenproject_vectorized_ShuffleReaderJniWrapper_
   JNI_METHOD_START
   auto reader = shuffleReaderHolder.lookup(handle);
   GLUTEN_THROW_NOT_OK(reader->close());
+  JNI_METHOD_END()
+}
+
+JNIEXPORT void JNICALL Java_io_glutenproject_vectorized_ShuffleReaderJniWrapper_release(
+    JNIEnv* env,
+    jobject,
+    jlong handle) { // NOLINT
+  JNI_METHOD_START
   shuffleReaderHolder.erase(handle);
   JNI_METHOD_END()
 }
@@ -1125,7 +1178,8 @@ JNIEXPORT jlong JNICALL Java_io_glutenproject_memory_alloc_NativeMemoryAllocator
     JNIEnv* env,
     jclass,
     jobject jlistener,
-    jlong delegatedAllocatorId) {
+    jlong delegatedAllocatorId,
+    jlong reservationBlockSize) {
   JNI_METHOD_START
   JavaVM* vm;
   if (env->GetJavaVM(&vm) != JNI_OK) {
@@ -1135,8 +1189,9 @@ JNIEXPORT jlong JNICALL Java_io_glutenproject_memory_alloc_NativeMemoryAllocator
   if (delegatedAllocator == nullptr) {
     throw gluten::GlutenException("Allocator does not exist or has been closed");
   }
-  std::shared_ptr<AllocationListener> listener = std::make_shared<SparkAllocationListener>(
-      vm, jlistener, reserveMemoryMethod, unreserveMemoryMethod, 8L << 10 << 10);
+  std::shared_ptr<AllocationListener> listener = std::make_shared<BlockAllocationListener>(
+      std::make_shared<SparkAllocationListener>(vm, jlistener, reserveMemoryMethod, unreserveMemoryMethod),
+      reservationBlockSize > 0 ? reservationBlockSize : kDefaultReservationBlockSize);
   std::shared_ptr<MemoryAllocator>* allocator = new std::shared_ptr<MemoryAllocator>;
   *allocator = std::make_shared<ListenableMemoryAllocator>((*delegatedAllocator).get(), listener);
   return reinterpret_cast<jlong>(allocator);
@@ -21,6 +21,38 @@
 
 namespace gluten {
 
+void BlockAllocationListener::allocationChanged(int64_t diff) {
+  if (diff == 0) {
+    return;
+  }
+  int64_t used = usedBytes_.fetch_add(diff);
+  int64_t granted = blocksFor(used + diff) - blocksFor(used);
+  if (granted == 0) {
+    return;
+  }
+  try {
+    delegated_->allocationChanged(granted);
+  } catch (...) {
+    // Undo the change. If racing changes crossed block boundaries meanwhile, undoing it doesn't release exactly the
+    // blocks that failed to be reserved, settle the difference with the delegated listener.
+    used = usedBytes_.fetch_sub(diff);
+    int64_t settle = blocksFor(used - diff) - blocksFor(used) + granted;
+    if (settle != 0) {
+      delegated_->allocationChanged(settle);
+      reservedBytes_ += settle;
+    }
+    throw;
+  }
+  reservedBytes_ += granted;
+}
+
+int64_t BlockAllocationListener::blocksFor(int64_t usedBytes) const {
+  if (usedBytes <= 0) {
+    return 0;
+  }
+  return ((usedBytes - 1) / blockSize_ + 1) * blockSize_;
+}
+
 bool ListenableMemoryAllocator::allocate(int64_t size, void** out) {
   listener_->allocationChanged(size);
   bool succeed = delegated_->allocate(size, out);
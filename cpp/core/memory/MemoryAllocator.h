@@ -57,6 +57,38 @@ class AllocationListener {
   AllocationListener() = default;
 };
 
+// 8M
+static constexpr int64_t kDefaultReservationBlockSize = 8L << 10 << 10;
+
+// Reserves memory from the delegated listener in blocks of blockSize bytes. Each change is applied with one atomic
+// fetch_add and reserves the difference between the blocks needed before and after it, so changes that stay within a
+// block never reach the delegated listener, and the reservations of racing changes add up to the blocks needed by the
+// final usage.
+class BlockAllocationListener final : public AllocationListener {
+ public:
+  BlockAllocationListener(std::shared_ptr<AllocationListener> delegated, int64_t blockSize)
+      : delegated_(std::move(delegated)), blockSize_(blockSize) {}
+
+  void allocationChanged(int64_t diff) override;
+
+  int64_t usedBytes() const {
+    return usedBytes_;
+  }
+
+  int64_t reservedBytes() const {
+    return reservedBytes_;
+  }
+
+ private:
+  // bytes of the blocks covering usedBytes
+  int64_t blocksFor(int64_t usedBytes) const;
+
+  std::shared_ptr<AllocationListener> delegated_;
+  const int64_t blockSize_;
+  std::atomic_int64_t usedBytes_{0};
+  std::atomic_int64_t reservedBytes_{0};
+};
+
 class ListenableMemoryAllocator final : public MemoryAllocator {
  public:
   explicit ListenableMemoryAllocator(MemoryAllocator* delegated, std::shared_ptr<AllocationListener> listener)
@@ -19,10 +19,11 @@
 #include "shuffle/FallbackRangePartitioner.h"
 
 namespace gluten {
-arrow::Status gluten::FallbackRangePartitioner::compute(
+template <typename PidType>
+arrow::Status FallbackRangePartitioner::doCompute(
     const int32_t* pidArr,
     const int64_t numRows,
-    std::vector<uint16_t>& partitionId,
+    std::vector<PidType>& partitionId,
     std::vector<uint32_t>& partitionIdCnt) {
   partitionId.resize(numRows);
   std::fill(std::begin(partitionIdCnt), std::end(partitionIdCnt), 0);
@@ -38,4 +39,20 @@ arrow::Status gluten::FallbackRangePartitioner::compute(
   return arrow::Status::OK();
 }
 
+arrow::Status gluten::FallbackRangePartitioner::compute(
+    const int32_t* pidArr,
+    const int64_t numRows,
+    std::vector<uint16_t>& partitionId,
+    std::vector<uint32_t>& partitionIdCnt) {
+  return doCompute(pidArr, numRows, partitionId, partitionIdCnt);
+}
+
+arrow::Status gluten::FallbackRangePartitioner::compute(
+    const int32_t* pidArr,
+    const int64_t numRows,
+    std::vector<uint32_t>& partitionId,
+    std::vector<uint32_t>& partitionIdCnt) {
+  return doCompute(pidArr, numRows, partitionId, partitionIdCnt);
+}
+
 } // namespace gluten
@@ -17,35 +17,131 @@
 
 #include "shuffle/HashPartitioner.h"
 
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace gluten {
 
-arrow::Status gluten::HashPartitioner::compute(
+namespace {
+
+constexpr uint32_t kNumHistograms = 4;
+
+// Lemire's fast modulo: a % d == (((m * a) mod 2^64) * d) >> 64, with m = (2^64 - 1) / d + 1.
+inline uint32_t fastMod(uint32_t a, uint64_t m, uint32_t d) {
+  uint64_t lowBits = m * a;
+  return static_cast<uint32_t>((static_cast<__uint128_t>(lowBits) * d) >> 64);
+}
+
+// Spark's pmod(hash, d).
+inline uint32_t pmod(int32_t hash, uint64_t m, uint32_t d) {
+  uint32_t abs = hash < 0 ? 0u - static_cast<uint32_t>(hash) : static_cast<uint32_t>(hash);
+  auto mod = fastMod(abs, m, d);
+  return hash < 0 && mod != 0 ? d - mod : mod;
+}
+
+#if defined(__AVX2__)
+// fastMod of the low 32 bits of each 64-bit lane, the 64-bit products built from 32x32 multiplies.
+inline __m256i fastMod4(__m256i a, __m256i mLo, __m256i mHi, __m256i d) {
+  auto lowBits = _mm256_add_epi64(_mm256_mul_epu32(a, mLo), _mm256_slli_epi64(_mm256_mul_epu32(a, mHi), 32));
+  auto lowProduct = _mm256_mul_epu32(lowBits, d);
+  auto highProduct = _mm256_mul_epu32(_mm256_srli_epi64(lowBits, 32), d);
+  return _mm256_srli_epi64(_mm256_add_epi64(highProduct, _mm256_srli_epi64(lowProduct, 32)), 32);
+}
+
+inline __m256i pmod8(__m256i hash, __m256i mLo, __m256i mHi, __m256i d) {
+  auto abs = _mm256_abs_epi32(hash);
+  auto even = fastMod4(abs, mLo, mHi, d);
+  auto odd = fastMod4(_mm256_srli_epi64(abs, 32), mLo, mHi, d);
+  auto mod = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xaa);
+  auto zero = _mm256_setzero_si256();
+  auto negate = _mm256_andnot_si256(_mm256_cmpeq_epi32(mod, zero), _mm256_cmpgt_epi32(zero, hash));
+  return _mm256_blendv_epi8(mod, _mm256_sub_epi32(d, mod), negate);
+}
+#endif
+
+template <typename PidType>
+void computePartitionIds(const int32_t* hashes, int64_t numRows, uint64_t m, uint32_t d, PidType* partitionIds) {
+  int64_t i = 0;
+#if defined(__AVX2__)
+  auto mLo = _mm256_set1_epi32(static_cast<uint32_t>(m));
+  auto mHi = _mm256_set1_epi32(static_cast<uint32_t>(m >> 32));
+  auto dx = _mm256_set1_epi32(d);
+  for (; i + 8 <= numRows; i += 8) {
+    auto pids = pmod8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hashes + i)), mLo, mHi, dx);
+    if constexpr (sizeof(PidType) == sizeof(uint16_t)) {
+      pids = _mm256_permute4x64_epi64(_mm256_packus_epi32(pids, pids), 0x08);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(partitionIds + i), _mm256_castsi256_si128(pids));
+    } else {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(partitionIds + i), pids);
+    }
+  }
+#endif
+  for (; i < numRows; ++i) {
+    partitionIds[i] = pmod(hashes[i], m, d);
+  }
+}
+
+} // namespace
+
+template <typename PidType>
+arrow::Status HashPartitioner::doCompute(
     const int32_t* pidArr,
     const int64_t numRows,
-    std::vector<uint16_t>& partitionId,
+    std::vector<PidType>& partitionId,
     std::vector<uint32_t>& partitionIdCnt) {
+  if (static_cast<uint64_t>(numPartitions_) - 1 > std::numeric_limits<PidType>::max()) {
+    return arrow::Status::Invalid(
+        "Partition number ", std::to_string(numPartitions_), " exceeds the range of ", sizeof(PidType), "-byte ids");
+  }
   partitionId.resize(numRows);
-  std::fill(std::begin(partitionIdCnt), std::end(partitionIdCnt), 0);
+  computePartitionIds(pidArr, numRows, fastModMultiplier_, numPartitions_, partitionId.data());
 
-  for (auto i = 0; i < numRows; ++i) {
-    auto pid = pidArr[i] % numPartitions_;
-#if defined(__x86_64__)
-    // force to generate ASM
-    __asm__(
-        "lea (%[num_partitions],%[pid],1),%[tmp]\n"
-        "test %[pid],%[pid]\n"
-        "cmovs %[tmp],%[pid]\n"
-        : [pid] "+r"(pid)
-        : [num_partitions] "r"(numPartitions_), [tmp] "r"(0));
-#else
-    if (pid < 0) {
-      pid += numPartitions_;
+  std::fill(std::begin(partitionIdCnt), std::end(partitionIdCnt), 0);
+  if (numRows < static_cast<int64_t>(kNumHistograms) * numPartitions_) {
+    for (auto i = 0; i < numRows; ++i) {
+      partitionIdCnt[partitionId[i]]++;
     }
-#endif
-    partitionId[i] = pid;
-    partitionIdCnt[pid]++;
+    return arrow::Status::OK();
+  }
+
+  // Consecutive rows of the same partition increment the same counter, each increment waiting for the previous store.
+  // Spread the rows over interleaved histograms so that neighbouring rows update different counters.
+  histograms_.assign(kNumHistograms * numPartitions_, 0);
+  auto histograms = histograms_.data();
+  int64_t i = 0;
+  for (; i + kNumHistograms <= numRows; i += kNumHistograms) {
+    histograms[partitionId[i] * kNumHistograms]++;
+    histograms[partitionId[i + 1] * kNumHistograms + 1]++;
+    histograms[partitionId[i + 2] * kNumHistograms + 2]++;
+    histograms[partitionId[i + 3] * kNumHistograms + 3]++;
+  }
+  for (; i < numRows; ++i) {
+    histograms[partitionId[i] * kNumHistograms]++;
+  }
+  for (auto pid = 0; pid < numPartitions_; ++pid) {
+    auto counts = histograms + pid * kNumHistograms;
+    partitionIdCnt[pid] = counts[0] + counts[1] + counts[2] + counts[3];
   }
   return arrow::Status::OK();
 }
 
+arrow::Status gluten::HashPartitioner::compute(
+    const int32_t* pidArr,
+    const int64_t numRows,
+    std::vector<uint16_t>& partitionId,
+    std::vector<uint32_t>& partitionIdCnt) {
+  return doCompute(pidArr, numRows, partitionId, partitionIdCnt);
+}
+
+arrow::Status gluten::HashPartitioner::compute(
+    const int32_t* pidArr,
+    const int64_t numRows,
+    std::vector<uint32_t>& partitionId,
+    std::vector<uint32_t>& partitionIdCnt) {
+  return doCompute(pidArr, numRows, partitionId, partitionIdCnt);
+}
+
 } // namespace gluten
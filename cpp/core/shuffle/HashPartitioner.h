@@ -17,19 +17,43 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "shuffle/Partitioner.h"
 
 namespace gluten {
 
 class HashPartitioner final : public ShuffleWriter::Partitioner {
  public:
-  HashPartitioner(int32_t numPartitions, bool hasPid) : Partitioner(numPartitions, hasPid) {}
+  HashPartitioner(int32_t numPartitions, bool hasPid)
+      : Partitioner(numPartitions, hasPid),
+        fastModMultiplier_(UINT64_C(0xFFFFFFFFFFFFFFFF) / std::max(numPartitions, 1) + 1) {}
 
   arrow::Status compute(
       const int32_t* pidArr,
       const int64_t numRows,
       std::vector<uint16_t>& partitionId,
       std::vector<uint32_t>& partitionIdCnt) override;
+
+  arrow::Status compute(
+      const int32_t* pidArr,
+      const int64_t numRows,
+      std::vector<uint32_t>& partitionId,
+      std::vector<uint32_t>& partitionIdCnt) override;
+
+ private:
+  template <typename PidType>
+  arrow::Status doCompute(
+      const int32_t* pidArr,
+      const int64_t numRows,
+      std::vector<PidType>& partitionId,
+      std::vector<uint32_t>& partitionIdCnt);
+
+  // Lemire's fast modulo multiplier for numPartitions_.
+  const uint64_t fastModMultiplier_;
+
+  // Interleaved partial histograms, see doCompute.
+  std::vector<uint32_t> histograms_;
 };
 
 } // namespace gluten
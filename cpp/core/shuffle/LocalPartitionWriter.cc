@@ -17,8 +17,62 @@
 
 #include "shuffle/LocalPartitionWriter.h"
 
+#ifdef __linux__
+#include <sys/sendfile.h>
+#include <unistd.h>
+#endif
+
 namespace gluten {
 
+#ifdef __linux__
+namespace {
+
+// Copies up to 'length' bytes at 'offset' of 'inFd' to the current position of 'outFd' without passing them through
+// user space. Returns the number of bytes copied, less than 'length' only if the kernel can't copy between these
+// files. The caller writes the rest itself.
+arrow::Result<int64_t> kernelCopy(int inFd, int64_t offset, int outFd, int64_t length) {
+  int64_t copied = 0;
+  bool useCopyFileRange = true;
+  while (copied < length) {
+    ssize_t n;
+    if (useCopyFileRange) {
+      loff_t inOffset = offset + copied;
+      n = copy_file_range(inFd, &inOffset, outFd, nullptr, length - copied, 0);
+    } else {
+      off_t inOffset = offset + copied;
+      n = sendfile(outFd, inFd, &inOffset, length - copied);
+    }
+    if (n > 0) {
+      copied += n;
+      continue;
+    }
+    if (n == 0) {
+      return arrow::Status::IOError("Unexpected end of spilled file at offset ", offset + copied);
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    // Older kernels and some file systems don't support copy_file_range, or not across file systems.
+    if (useCopyFileRange && (errno == ENOSYS || errno == EXDEV || errno == EOPNOTSUPP || errno == EINVAL)) {
+      useCopyFileRange = false;
+      continue;
+    }
+    if (!useCopyFileRange && (errno == ENOSYS || errno == EINVAL)) {
+      break;
+    }
+    return arrow::internal::IOErrorFromErrno(errno, "Failed to copy spilled data to the data file");
+  }
+  return copied;
+}
+
+} // namespace
+#endif
+
+namespace {
+// Set in the write threads of PreferEvictPartitionWriter, which must not wait for their own writes.
+thread_local bool inPipelinedWrite = false;
+} // namespace
+
 std::string LocalPartitionWriterBase::nextSpilledFileDir() {
   auto spilledFileDir = getSpilledShuffleFileDir(configuredDirs_[dirSelection_], subDirSelection_[dirSelection_]);
   subDirSelection_[dirSelection_] = (subDirSelection_[dirSelection_] + 1) % shuffleWriter_->options().num_sub_dirs;
@@ -41,150 +95,66 @@ arrow::Status LocalPartitionWriterBase::setLocalDirs() {
 }
 
 arrow::Status LocalPartitionWriterBase::openDataFile() {
-  // open data file output stream
-  std::shared_ptr<arrow::io::FileOutputStream> fout;
-  ARROW_ASSIGN_OR_RAISE(fout, arrow::io::FileOutputStream::Open(shuffleWriter_->options().data_file, true));
+  // open data file output stream. Not in append mode, which copy_file_range and sendfile reject.
+  ARROW_ASSIGN_OR_RAISE(dataFile_, arrow::io::FileOutputStream::Open(shuffleWriter_->options().data_file, false));
   if (shuffleWriter_->options().buffered_write) {
     ARROW_ASSIGN_OR_RAISE(
-        dataFileOs_, arrow::io::BufferedOutputStream::Create(16384, shuffleWriter_->options().memory_pool.get(), fout));
+        dataFileOs_,
+        arrow::io::BufferedOutputStream::Create(16384, shuffleWriter_->options().memory_pool.get(), dataFile_));
   } else {
-    dataFileOs_ = fout;
+    dataFileOs_ = dataFile_;
   }
   return arrow::Status::OK();
 }
 
+arrow::Status
+LocalPartitionWriterBase::copySpilledRange(arrow::io::ReadableFile* spilledFile, int64_t start, int64_t length) {
+  int64_t copied = 0;
+#ifdef __linux__
+  // The kernel appends at the file position, so the bytes buffered in dataFileOs_ must be written out first.
+  RETURN_NOT_OK(dataFileOs_->Flush());
+  ARROW_ASSIGN_OR_RAISE(
+      copied, kernelCopy(spilledFile->file_descriptor(), start, dataFile_->file_descriptor(), length));
+  dataFileCopied_ = dataFileCopied_ || copied > 0;
+#endif
+  if (copied < length) {
+    ARROW_ASSIGN_OR_RAISE(auto raw, spilledFile->ReadAt(start + copied, length - copied));
+    RETURN_NOT_OK(dataFileOs_->Write(raw));
+  }
+  return arrow::Status::OK();
+}
+
+arrow::Result<int64_t> LocalPartitionWriterBase::dataFileTell() {
+  if (dataFileCopied_) {
+    RETURN_NOT_OK(dataFileOs_->Flush());
+    return dataFile_->Tell();
+  }
+  return dataFileOs_->Tell();
+}
+
 arrow::Status LocalPartitionWriterBase::clearResource() {
   RETURN_NOT_OK(dataFileOs_->Close());
+  dataFile_.reset();
+  dataFileCopied_ = false;
   schemaPayload_.reset();
   shuffleWriter_->pool()->reset();
   shuffleWriter_->partitionBuffer().clear();
   return arrow::Status::OK();
 }
 
-class PreferEvictPartitionWriter::LocalPartitionWriterInstance {
- public:
-  LocalPartitionWriterInstance(
-      PreferEvictPartitionWriter* partitionWriter,
-      ShuffleWriter* shuffleWriter,
-      uint32_t partitionId)
-      : partitionWriter_(partitionWriter), shuffleWriter_(shuffleWriter), partitionId_(partitionId) {}
-
-  arrow::Status spill() {
-#ifndef SKIPWRITE
-    RETURN_NOT_OK(ensureOpened());
-#endif
-    RETURN_NOT_OK(writeRecordBatchPayload(spilledFileOs_.get()));
-    clearCache();
-    return arrow::Status::OK();
-  }
-
-  arrow::Status writeCachedRecordBatchAndClose() {
-    const auto& dataFileOs = partitionWriter_->dataFileOs_;
-    ARROW_ASSIGN_OR_RAISE(auto before_write, dataFileOs->Tell());
-
-    if (shuffleWriter_->options().write_schema) {
-      RETURN_NOT_OK(writeSchemaPayload(dataFileOs.get()));
-    }
-
-    if (spilledFileOpened_) {
-      RETURN_NOT_OK(spilledFileOs_->Close());
-      RETURN_NOT_OK(mergeSpilled());
-    } else {
-      if (shuffleWriter_->partitionCachedRecordbatchSize()[partitionId_] == 0) {
-        return arrow::Status::Invalid("Partition writer got empty partition");
-      }
-    }
-
-    RETURN_NOT_OK(writeRecordBatchPayload(dataFileOs.get()));
-    RETURN_NOT_OK(writeEos(dataFileOs.get()));
-    clearCache();
-
-    ARROW_ASSIGN_OR_RAISE(auto after_write, dataFileOs->Tell());
-    partition_length = after_write - before_write;
-
-    return arrow::Status::OK();
-  }
-
-  // metrics
-  int64_t bytes_spilled = 0;
-  int64_t partition_length = 0;
-  int64_t compress_time = 0;
-
- private:
-  arrow::Status ensureOpened() {
-    if (!spilledFileOpened_) {
-      ARROW_ASSIGN_OR_RAISE(spilledFile_, createTempShuffleFile(partitionWriter_->nextSpilledFileDir()));
-      ARROW_ASSIGN_OR_RAISE(spilledFileOs_, arrow::io::FileOutputStream::Open(spilledFile_, true));
-      spilledFileOpened_ = true;
-    }
-    return arrow::Status::OK();
-  }
-
-  arrow::Status mergeSpilled() {
-    ARROW_ASSIGN_OR_RAISE(
-        auto spilled_file_is_, arrow::io::MemoryMappedFile::Open(spilledFile_, arrow::io::FileMode::READ));
-    // copy spilled data blocks
-    ARROW_ASSIGN_OR_RAISE(auto nbytes, spilled_file_is_->GetSize());
-    ARROW_ASSIGN_OR_RAISE(auto buffer, spilled_file_is_->Read(nbytes));
-    RETURN_NOT_OK(partitionWriter_->dataFileOs_->Write(buffer));
-
-    // close spilled file streams and delete the file
-    RETURN_NOT_OK(spilled_file_is_->Close());
-    auto fs = std::make_shared<arrow::fs::LocalFileSystem>();
-    RETURN_NOT_OK(fs->DeleteFile(spilledFile_));
-    bytes_spilled += nbytes;
-    return arrow::Status::OK();
-  }
-
-  arrow::Status writeSchemaPayload(arrow::io::OutputStream* os) {
-    ARROW_ASSIGN_OR_RAISE(auto payload, partitionWriter_->getSchemaPayload(shuffleWriter_->writeSchema()));
-    int32_t metadataLength = 0; // unused
-    RETURN_NOT_OK(
-        arrow::ipc::WriteIpcPayload(*payload, shuffleWriter_->options().ipc_write_options, os, &metadataLength));
-    return arrow::Status::OK();
-  }
-
-  arrow::Status writeRecordBatchPayload(arrow::io::OutputStream* os) {
-    int32_t metadataLength = 0; // unused
-#ifndef SKIPWRITE
-    for (auto& payload : shuffleWriter_->partitionCachedRecordbatch()[partitionId_]) {
-      RETURN_NOT_OK(
-          arrow::ipc::WriteIpcPayload(*payload, shuffleWriter_->options().ipc_write_options, os, &metadataLength));
-      payload = nullptr;
-    }
-#endif
-    return arrow::Status::OK();
-  }
-
-  arrow::Status writeEos(arrow::io::OutputStream* os) {
-    // This 0xFFFFFFFF value is the first 4 bytes of a valid IPC message
-    constexpr int32_t kIpcContinuationToken = -1;
-    constexpr int32_t kZeroLength = 0;
-    RETURN_NOT_OK(os->Write(&kIpcContinuationToken, sizeof(int32_t)));
-    RETURN_NOT_OK(os->Write(&kZeroLength, sizeof(int32_t)));
-    return arrow::Status::OK();
-  }
-
-  void clearCache() {
-    shuffleWriter_->partitionCachedRecordbatch()[partitionId_].clear();
-    shuffleWriter_->setPartitionCachedRecordbatchSize(partitionId_, 0);
-  }
-
-  PreferEvictPartitionWriter* partitionWriter_;
-  ShuffleWriter* shuffleWriter_;
-  uint32_t partitionId_;
-  std::string spilledFile_;
-  std::shared_ptr<arrow::io::FileOutputStream> spilledFileOs_;
-
-  bool spilledFileOpened_ = false;
-};
-
 arrow::Status PreferEvictPartitionWriter::init() {
-  partitionWriterInstances_.resize(shuffleWriter_->numPartitions());
   RETURN_NOT_OK(setLocalDirs());
   return arrow::Status::OK();
 }
 
+arrow::Status PreferEvictPartitionWriter::ensureSpilledFileOpened() {
+  if (spilledFileOs_ == nullptr) {
+    ARROW_ASSIGN_OR_RAISE(spill_.spilledFile, createTempShuffleFile(nextSpilledFileDir()));
+    ARROW_ASSIGN_OR_RAISE(spilledFileOs_, arrow::io::FileOutputStream::Open(spill_.spilledFile, true));
+  }
+  return arrow::Status::OK();
+}
+
 arrow::Result<std::shared_ptr<arrow::ipc::IpcPayload>> LocalPartitionWriterBase::getSchemaPayload(
     std::shared_ptr<arrow::Schema> schema) {
   if (schemaPayload_ != nullptr) {
@@ -197,47 +167,193 @@ arrow::Result<std::shared_ptr<arrow::ipc::IpcPayload>> LocalPartitionWriterBase:
   return schemaPayload_;
 }
 
+arrow::Status PreferEvictPartitionWriter::writePartitionPayloads(
+    int32_t partitionId,
+    std::vector<std::shared_ptr<arrow::ipc::IpcPayload>>& payloads) {
+#ifndef SKIPWRITE
+  // Append the cached batches to the shared spilled file, record their start and length.
+  ARROW_ASSIGN_OR_RAISE(auto start, spilledFileOs_->Tell());
+  RETURN_NOT_OK(flushCachedPayloads(spilledFileOs_.get(), payloads));
+  ARROW_ASSIGN_OR_RAISE(auto end, spilledFileOs_->Tell());
+  if (end > start) {
+    spill_.partitionSpillInfos.push_back({partitionId, start, end - start});
+  }
+#endif
+  return arrow::Status::OK();
+}
+
 arrow::Status PreferEvictPartitionWriter::evictPartition(int32_t partitionId) {
-  if (partitionWriterInstances_[partitionId] == nullptr) {
-    partitionWriterInstances_[partitionId] =
-        std::make_shared<LocalPartitionWriterInstance>(this, shuffleWriter_, partitionId);
+  // stop() closes the spilled file and merges it by its index, evictions from its allocations can't be appended.
+  if (inStop_) {
+    return arrow::Status::OutOfMemory("Cannot evict partition ", partitionId, " because writer is stopped.");
+  }
+  if (shuffleWriter_->options().pipelined_write) {
+    return evictPartitionAsync(partitionId);
+  }
+  int64_t evictTime = 0;
+  TIME_NANO_START(evictTime)
+#ifndef SKIPWRITE
+  RETURN_NOT_OK(ensureSpilledFileOpened());
+#endif
+  RETURN_NOT_OK(writePartitionPayloads(partitionId, shuffleWriter_->partitionCachedRecordbatch()[partitionId]));
+  shuffleWriter_->partitionCachedRecordbatch()[partitionId].clear();
+  shuffleWriter_->setPartitionCachedRecordbatchSize(partitionId, 0);
+  TIME_NANO_END(evictTime)
+  shuffleWriter_->setTotalEvictTime(shuffleWriter_->totalEvictTime() + evictTime);
+
+  return arrow::Status::OK();
+}
+
+arrow::Status PreferEvictPartitionWriter::evictPartitionAsync(int32_t partitionId) {
+  if (writeThreadPool_ == nullptr) {
+    ARROW_ASSIGN_OR_RAISE(writeThreadPool_, arrow::internal::ThreadPool::Make(1));
   }
-  int64_t tempTotalEvictTime = 0;
-  TIME_NANO_OR_RAISE(tempTotalEvictTime, partitionWriterInstances_[partitionId]->spill());
-  shuffleWriter_->setTotalEvictTime(shuffleWriter_->totalEvictTime() + tempTotalEvictTime);
+#ifndef SKIPWRITE
+  RETURN_NOT_OK(ensureSpilledFileOpened());
+#endif
+  auto payloads = std::move(shuffleWriter_->partitionCachedRecordbatch()[partitionId]);
+  auto bytes = shuffleWriter_->partitionCachedRecordbatchSize()[partitionId];
+  shuffleWriter_->partitionCachedRecordbatch()[partitionId].clear();
+  shuffleWriter_->setPartitionCachedRecordbatchSize(partitionId, 0);
+
+  // backpressure, the queued payloads share the pipeline memory budget with compression
+  RETURN_NOT_OK(waitPendingWrites(std::max<int64_t>(shuffleWriter_->pipelineMaxPendingBytes() - bytes, 0)));
+
+  ARROW_ASSIGN_OR_RAISE(
+      auto future, writeThreadPool_->Submit([this, partitionId, payloads = std::move(payloads)]() mutable {
+        inPipelinedWrite = true;
+        int64_t writeTime = 0;
+        TIME_NANO_OR_RAISE(writeTime, writePartitionPayloads(partitionId, payloads));
+        pipelinedWriteTime_ += writeTime;
+        return arrow::Status::OK();
+      }));
+  std::lock_guard<std::mutex> lock(pendingWritesMutex_);
+  pendingWriteBytes_ += bytes;
+  pendingWrites_.push_back({bytes, std::move(future)});
+  return arrow::Status::OK();
+}
 
+arrow::Status PreferEvictPartitionWriter::waitPendingWrites(int64_t maxPendingBytes) {
+  TIME_NANO_START(writeWallTime)
+  {
+    std::lock_guard<std::mutex> lock(pendingWritesMutex_);
+    while (!pendingWrites_.empty() && pendingWriteBytes_ > maxPendingBytes) {
+      auto& pending = pendingWrites_.front();
+      RETURN_NOT_OK(pending.future.status());
+      pendingWriteBytes_ -= pending.bytes;
+      pendingWrites_.pop_front();
+    }
+  }
+  TIME_NANO_END(writeWallTime)
+  writeWallTime_ += writeWallTime;
   return arrow::Status::OK();
 }
 
+arrow::Result<int64_t> PreferEvictPartitionWriter::releasePendingWrites() {
+  if (inPipelinedWrite) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(pendingWritesMutex_);
+  int64_t released = 0;
+  while (!pendingWrites_.empty()) {
+    auto& pending = pendingWrites_.front();
+    RETURN_NOT_OK(pending.future.status());
+    released += pending.bytes;
+    pendingWriteBytes_ -= pending.bytes;
+    pendingWrites_.pop_front();
+  }
+  return released;
+}
+
 arrow::Status PreferEvictPartitionWriter::stop() {
+  inStop_ = true;
+
+  int64_t mergeTime = 0;
+  int64_t totalBytesEvicted = 0;
+  auto numPartitions = shuffleWriter_->numPartitions();
+  auto writeSchema = shuffleWriter_->options().write_schema;
+
+  // 0. Wait for the pipelined writes and open final file.
+  RETURN_NOT_OK(waitPendingWrites(-1));
   RETURN_NOT_OK(openDataFile());
-  // stop PartitionWriter and collect metrics
-  for (auto pid = 0; pid < shuffleWriter_->numPartitions(); ++pid) {
+
+  // 1. Close and open the spilled file for read. Order its index by partition id, keeping the eviction order within
+  // one partition.
+  std::shared_ptr<arrow::io::ReadableFile> spilledFile;
+  auto& partitionSpillInfos = spill_.partitionSpillInfos;
+  if (spilledFileOs_ != nullptr) {
+    RETURN_NOT_OK(spilledFileOs_->Close());
+    ARROW_ASSIGN_OR_RAISE(spilledFile, arrow::io::ReadableFile::Open(spill_.spilledFile));
+    ARROW_ASSIGN_OR_RAISE(totalBytesEvicted, spilledFile->GetSize());
+    std::stable_sort(
+        partitionSpillInfos.begin(),
+        partitionSpillInfos.end(),
+        [](const PartitionSpillInfo& a, const PartitionSpillInfo& b) { return a.partitionId < b.partitionId; });
+  }
+
+  // 2. Merge the spilled data and the cached batches of each partition.
+  size_t spillInfoOffset = 0;
+  for (auto pid = 0; pid < numPartitions; ++pid) {
     RETURN_NOT_OK(shuffleWriter_->createRecordBatchFromBuffer(pid, true));
-    if (shuffleWriter_->partitionCachedRecordbatchSize()[pid] > 0) {
-      if (partitionWriterInstances_[pid] == nullptr) {
-        partitionWriterInstances_[pid] = std::make_shared<LocalPartitionWriterInstance>(this, shuffleWriter_, pid);
+
+    int64_t writeTime = 0;
+    TIME_NANO_START(writeTime)
+    ARROW_ASSIGN_OR_RAISE(auto startInFinalFile, dataFileTell());
+    auto spilledEnd = spillInfoOffset;
+    while (spilledEnd < partitionSpillInfos.size() && partitionSpillInfos[spilledEnd].partitionId == pid) {
+      ++spilledEnd;
+    }
+    auto hasCached = shuffleWriter_->partitionCachedRecordbatchSize()[pid] > 0;
+    if (spilledEnd > spillInfoOffset || hasCached) {
+      if (writeSchema) {
+        RETURN_NOT_OK(writeSchemaPayload(dataFileOs_.get()));
       }
+      for (; spillInfoOffset < spilledEnd; ++spillInfoOffset) {
+        const auto& partitionSpillInfo = partitionSpillInfos[spillInfoOffset];
+        RETURN_NOT_OK(copySpilledRange(spilledFile.get(), partitionSpillInfo.start, partitionSpillInfo.length));
+      }
+      RETURN_NOT_OK(flushCachedPayloads(dataFileOs_.get(), shuffleWriter_->partitionCachedRecordbatch()[pid]));
+      RETURN_NOT_OK(writeEos(dataFileOs_.get()));
+      shuffleWriter_->partitionCachedRecordbatch()[pid].clear();
+      shuffleWriter_->setPartitionCachedRecordbatchSize(pid, 0);
     }
-    if (partitionWriterInstances_[pid] != nullptr) {
-      const auto& writer = partitionWriterInstances_[pid];
-      int64_t tempTotalWriteTime = 0;
-      TIME_NANO_OR_RAISE(tempTotalWriteTime, writer->writeCachedRecordBatchAndClose());
-      shuffleWriter_->setTotalWriteTime(shuffleWriter_->totalWriteTime() + tempTotalWriteTime);
-      shuffleWriter_->setPartitionLengths(pid, writer->partition_length);
-      shuffleWriter_->setTotalBytesWritten(shuffleWriter_->totalBytesWritten() + writer->partition_length);
-      shuffleWriter_->setTotalBytesEvicted(shuffleWriter_->totalBytesEvicted() + writer->bytes_spilled);
-    } else {
-      shuffleWriter_->setPartitionLengths(pid, 0);
+    ARROW_ASSIGN_OR_RAISE(auto endInFinalFile, dataFileTell());
+    TIME_NANO_END(writeTime)
+    mergeTime += writeTime;
+
+    shuffleWriter_->setPartitionLengths(pid, endInFinalFile - startInFinalFile);
+    shuffleWriter_->setTotalBytesWritten(shuffleWriter_->totalBytesWritten() + endInFinalFile - startInFinalFile);
+  }
+
+  // 3. Close the spilled file and delete it.
+  if (spilledFile != nullptr) {
+    if (spillInfoOffset != partitionSpillInfos.size()) {
+      return arrow::Status::Invalid("Merging from spilled file is not exhausted.");
     }
+    RETURN_NOT_OK(spilledFile->Close());
+    auto fs = std::make_shared<arrow::fs::LocalFileSystem>();
+    RETURN_NOT_OK(fs->DeleteFile(spill_.spilledFile));
   }
+
+  shuffleWriter_->setTotalWriteTime(shuffleWriter_->totalWriteTime() + pipelinedWriteTime_.exchange(0) + mergeTime);
+  if (shuffleWriter_->options().pipelined_write) {
+    shuffleWriter_->setTotalWriteWallTime(shuffleWriter_->totalWriteWallTime() + writeWallTime_ + mergeTime);
+  }
+  shuffleWriter_->setTotalBytesEvicted(shuffleWriter_->totalBytesEvicted() + totalBytesEvicted);
+
   RETURN_NOT_OK(clearResource());
   return arrow::Status::OK();
 }
 
 arrow::Status PreferEvictPartitionWriter::clearResource() {
   RETURN_NOT_OK(LocalPartitionWriterBase::clearResource());
-  partitionWriterInstances_.clear();
+  spill_ = {};
+  spilledFileOs_.reset();
+  {
+    std::lock_guard<std::mutex> lock(pendingWritesMutex_);
+    pendingWrites_.clear();
+  }
+  writeThreadPool_.reset();
   return arrow::Status::OK();
 }
 
@@ -306,9 +422,9 @@ arrow::Status PreferCachePartitionWriter::stop() {
   RETURN_NOT_OK(openDataFile());
   // 1. Open all spilled files, update totalBytesEvicted.
   std::vector<int32_t> spillInfoOffsets(spills_.size(), 0);
-  std::vector<std::shared_ptr<arrow::io::MemoryMappedFile>> spilledFiles;
+  std::vector<std::shared_ptr<arrow::io::ReadableFile>> spilledFiles;
   for (const auto& spill : spills_) {
-    ARROW_ASSIGN_OR_RAISE(auto is, arrow::io::MemoryMappedFile::Open(spill.spilledFile, arrow::io::FileMode::READ));
+    ARROW_ASSIGN_OR_RAISE(auto is, arrow::io::ReadableFile::Open(spill.spilledFile));
     ARROW_ASSIGN_OR_RAISE(auto spilledSize, is->GetSize());
     totalBytesEvicted += spilledSize;
     spilledFiles.push_back(std::move(is));
@@ -317,7 +433,7 @@ arrow::Status PreferCachePartitionWriter::stop() {
   for (auto pid = 0; pid < numPartitions; ++pid) {
     bool firstWrite = true;
     // 3. Record start offset.
-    ARROW_ASSIGN_OR_RAISE(auto startInFinalFile, dataFileOs_->Tell());
+    ARROW_ASSIGN_OR_RAISE(auto startInFinalFile, dataFileTell());
     // 4. Iterator over all spilled files
     for (auto i = 0; i < spills_.size(); ++i) {
       auto partitionSpillInfo = spills_[i].partitionSpillInfos[spillInfoOffsets[i]];
@@ -330,8 +446,7 @@ arrow::Status PreferCachePartitionWriter::stop() {
           }
           firstWrite = false;
         }
-        ARROW_ASSIGN_OR_RAISE(auto raw, spilledFiles[i]->ReadAt(partitionSpillInfo.start, partitionSpillInfo.length));
-        RETURN_NOT_OK(dataFileOs_->Write(raw));
+        RETURN_NOT_OK(copySpilledRange(spilledFiles[i].get(), partitionSpillInfo.start, partitionSpillInfo.length));
         // Goto next partition in this spillInfo
         spillInfoOffsets[i]++;
       }
@@ -375,7 +490,7 @@ arrow::Status PreferCachePartitionWriter::stop() {
     if (!firstWrite) {
       RETURN_NOT_OK(writeEos(dataFileOs_.get()));
     }
-    ARROW_ASSIGN_OR_RAISE(auto endInFinalFile, dataFileOs_->Tell());
+    ARROW_ASSIGN_OR_RAISE(auto endInFinalFile, dataFileTell());
 
     shuffleWriter_->setPartitionLengths(pid, endInFinalFile - startInFinalFile);
   }
@@ -391,7 +506,7 @@ arrow::Status PreferCachePartitionWriter::stop() {
     RETURN_NOT_OK(fs->DeleteFile(spills_[i].spilledFile));
   }
 
-  ARROW_ASSIGN_OR_RAISE(totalBytesWritten, dataFileOs_->Tell());
+  ARROW_ASSIGN_OR_RAISE(totalBytesWritten, dataFileTell());
 
   TIME_NANO_END(totalWriteTime)
 
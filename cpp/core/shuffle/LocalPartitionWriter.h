@@ -18,6 +18,11 @@
 #pragma once
 
 #include <arrow/io/api.h>
+#include <arrow/util/future.h>
+#include <arrow/util/thread_pool.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
 
 #include "shuffle/PartitionWriter.h"
 #include "shuffle/ShuffleWriter.h"
@@ -40,50 +45,16 @@ class LocalPartitionWriterBase : public ShuffleWriter::PartitionWriter {
 
   arrow::Status openDataFile();
 
-  virtual arrow::Status clearResource();
-
-  // configured local dirs for spilled file
-  int32_t dirSelection_ = 0;
-  std::vector<int32_t> subDirSelection_;
-  std::vector<std::string> configuredDirs_;
-
-  // shared among all partitions
-  std::shared_ptr<arrow::ipc::IpcPayload> schemaPayload_;
-  std::shared_ptr<arrow::io::OutputStream> dataFileOs_;
-};
-
-class PreferEvictPartitionWriter : public LocalPartitionWriterBase {
- public:
-  explicit PreferEvictPartitionWriter(ShuffleWriter* shuffleWriter) : LocalPartitionWriterBase(shuffleWriter) {}
-
-  arrow::Status init() override;
-
-  arrow::Status evictPartition(int32_t partitionId) override;
-
-  arrow::Status stop() override;
-
-  class LocalPartitionWriterInstance;
+  // Appends [start, start + length) of a spilled file to the data file. On Linux the bytes are copied by the kernel
+  // with copy_file_range or sendfile, otherwise, or if neither supports these files, they are read and written back.
+  arrow::Status copySpilledRange(arrow::io::ReadableFile* spilledFile, int64_t start, int64_t length);
 
-  std::vector<std::shared_ptr<LocalPartitionWriterInstance>> partitionWriterInstances_;
+  // Position of the data file. Use this instead of dataFileOs_->Tell(), whose cached position doesn't account for the
+  // bytes copied by the kernel.
+  arrow::Result<int64_t> dataFileTell();
 
- private:
-  arrow::Status clearResource() override;
-};
-
-class PreferCachePartitionWriter : public LocalPartitionWriterBase {
- public:
-  explicit PreferCachePartitionWriter(ShuffleWriter* shuffleWriter) : LocalPartitionWriterBase(shuffleWriter) {}
-
-  arrow::Status init() override;
-
-  arrow::Status evictPartition(int32_t partitionId) override;
-
-  arrow::Status stop() override;
-
- private:
-  arrow::Status clearResource() override;
+  virtual arrow::Status clearResource();
 
-  // TODO: helper methods
   arrow::Status writeSchemaPayload(arrow::io::OutputStream* os) {
     ARROW_ASSIGN_OR_RAISE(auto payload, getSchemaPayload(shuffleWriter_->writeSchema()));
     int32_t metadataLength = 0; // unused
@@ -135,6 +106,78 @@ class PreferCachePartitionWriter : public LocalPartitionWriterBase {
     std::vector<PartitionSpillInfo> partitionSpillInfos;
   };
 
+  // configured local dirs for spilled file
+  int32_t dirSelection_ = 0;
+  std::vector<int32_t> subDirSelection_;
+  std::vector<std::string> configuredDirs_;
+
+  // shared among all partitions
+  std::shared_ptr<arrow::ipc::IpcPayload> schemaPayload_;
+  std::shared_ptr<arrow::io::OutputStream> dataFileOs_;
+  // The file under dataFileOs_, and whether copySpilledRange has written to it directly.
+  std::shared_ptr<arrow::io::FileOutputStream> dataFile_;
+  bool dataFileCopied_{false};
+};
+
+class PreferEvictPartitionWriter : public LocalPartitionWriterBase {
+ public:
+  explicit PreferEvictPartitionWriter(ShuffleWriter* shuffleWriter) : LocalPartitionWriterBase(shuffleWriter) {}
+
+  arrow::Status init() override;
+
+  arrow::Status evictPartition(int32_t partitionId) override;
+
+  arrow::Status stop() override;
+
+  arrow::Result<int64_t> releasePendingWrites() override;
+
+ private:
+  arrow::Status clearResource() override;
+
+  arrow::Status ensureSpilledFileOpened();
+
+  arrow::Status writePartitionPayloads(
+      int32_t partitionId,
+      std::vector<std::shared_ptr<arrow::ipc::IpcPayload>>& payloads);
+
+  // pipelined write, payloads are written to the spilled file from writeThreadPool_
+  arrow::Status evictPartitionAsync(int32_t partitionId);
+
+  arrow::Status waitPendingWrites(int64_t maxPendingBytes);
+
+  // All evicted partitions are appended to one spilled file, indexed by partitionSpillInfos in eviction order.
+  SpillInfo spill_;
+  std::shared_ptr<arrow::io::FileOutputStream> spilledFileOs_;
+
+  struct PendingWrite {
+    int64_t bytes;
+    arrow::Future<> future;
+  };
+
+  // guards pendingWrites_ and pendingWriteBytes_, which releasePendingWrites() drains from other threads
+  std::mutex pendingWritesMutex_;
+  std::deque<PendingWrite> pendingWrites_;
+  int64_t pendingWriteBytes_ = 0;
+  std::atomic<int64_t> pipelinedWriteTime_{0};
+  int64_t writeWallTime_ = 0;
+  bool inStop_{false};
+  // Declared last to join the write thread before the spilled file is released.
+  std::shared_ptr<arrow::internal::ThreadPool> writeThreadPool_;
+};
+
+class PreferCachePartitionWriter : public LocalPartitionWriterBase {
+ public:
+  explicit PreferCachePartitionWriter(ShuffleWriter* shuffleWriter) : LocalPartitionWriterBase(shuffleWriter) {}
+
+  arrow::Status init() override;
+
+  arrow::Status evictPartition(int32_t partitionId) override;
+
+  arrow::Status stop() override;
+
+ private:
+  arrow::Status clearResource() override;
+
   std::vector<SpillInfo> spills_;
   bool inStop_{false};
 };
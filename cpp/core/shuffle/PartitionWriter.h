@@ -32,6 +32,12 @@ class ShuffleWriter::PartitionWriter {
 
   virtual arrow::Status stop() = 0;
 
+  // Waits for the writes running in background threads and returns the bytes they held. Unlike the other methods,
+  // it may be called from threads other than the task thread, e.g. to spill for an allocation in a pipeline thread.
+  virtual arrow::Result<int64_t> releasePendingWrites() {
+    return 0;
+  }
+
   ShuffleWriter* shuffleWriter_;
 };
 
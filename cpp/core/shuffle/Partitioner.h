@@ -42,6 +42,13 @@ class ShuffleWriter::Partitioner {
       std::vector<uint16_t>& partitionId,
       std::vector<uint32_t>& partitionIdCnt) = 0;
 
+  // 32-bit partition ids, for more than 65535 partitions.
+  virtual arrow::Status compute(
+      const int32_t* pidArr,
+      const int64_t numRows,
+      std::vector<uint32_t>& partitionId,
+      std::vector<uint32_t>& partitionIdCnt) = 0;
+
  protected:
   Partitioner(int32_t numPartitions, bool hasPid) : numPartitions_(numPartitions), hasPid_(hasPid) {}
   virtual ~Partitioner() = default;
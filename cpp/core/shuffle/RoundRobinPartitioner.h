@@ -30,7 +30,20 @@ class RoundRobinPartitioner final : public ShuffleWriter::Partitioner {
       std::vector<uint16_t>& partitionId,
       std::vector<uint32_t>& partitionIdCnt) override;
 
+  arrow::Status compute(
+      const int32_t* pidArr,
+      const int64_t numRows,
+      std::vector<uint32_t>& partitionId,
+      std::vector<uint32_t>& partitionIdCnt) override;
+
  private:
+  template <typename PidType>
+  arrow::Status doCompute(
+      const int32_t* pidArr,
+      const int64_t numRows,
+      std::vector<PidType>& partitionId,
+      std::vector<uint32_t>& partitionIdCnt);
+
   int32_t pidSelection_ = 0;
 };
 
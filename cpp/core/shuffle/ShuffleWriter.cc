@@ -18,6 +18,9 @@
 #include "ShuffleWriter.h"
 
 #include <arrow/result.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 
 #include "ShuffleSchema.h"
 #include "utils/macros.h"
@@ -56,6 +59,38 @@ arrow::Status ShuffleBufferPool::allocateDirectly(std::shared_ptr<arrow::Buffer>
   return arrow::Status::OK();
 }
 
+namespace {
+std::atomic<int32_t> pipelineThreads{kDefaultPipelineThreads};
+std::atomic<int64_t> pipelineMaxPendingBytesLimit{kDefaultPipelineMaxPendingBytes};
+} // namespace
+
+void ShuffleWriter::setPipelineThreads(int32_t numThreads) {
+  if (numThreads > 0) {
+    pipelineThreads = numThreads;
+  }
+}
+
+void ShuffleWriter::setPipelineMaxPendingBytes(int64_t maxPendingBytes) {
+  if (maxPendingBytes > 0) {
+    pipelineMaxPendingBytesLimit = maxPendingBytes;
+  }
+}
+
+int64_t ShuffleWriter::pipelineMaxPendingBytes() const {
+  int64_t limit = pipelineMaxPendingBytesLimit;
+  return options_.offheap_per_task > 0 ? std::min(limit, options_.offheap_per_task >> 2) : limit;
+}
+
+arrow::Result<arrow::internal::ThreadPool*> ShuffleWriter::pipelineThreadPool() {
+  static std::shared_ptr<arrow::internal::ThreadPool> pool;
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+  if (pool == nullptr) {
+    ARROW_ASSIGN_OR_RAISE(pool, arrow::internal::ThreadPool::Make(pipelineThreads));
+  }
+  return pool.get();
+}
+
 std::shared_ptr<arrow::Schema> ShuffleWriter::writeSchema() {
   if (writeSchema_ != nullptr) {
     return writeSchema_;
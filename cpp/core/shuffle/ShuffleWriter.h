@@ -18,6 +18,7 @@
 #pragma once
 
 #include <arrow/ipc/writer.h>
+#include <arrow/util/thread_pool.h>
 #include <numeric>
 #include <utility>
 
@@ -31,6 +32,10 @@ static constexpr int32_t kDefaultShuffleWriterBufferSize = 4096;
 static constexpr int32_t kDefaultNumSubDirs = 64;
 static constexpr int32_t kDefaultBatchCompressThreshold = 256;
 static constexpr int32_t kDefaultBufferAlignment = 64;
+static constexpr int32_t kDefaultSortBasedShuffleThreshold = 10000;
+static constexpr int64_t kDefaultSortBufferMaxSize = 64 << 20;
+static constexpr int32_t kDefaultPipelineThreads = 2;
+static constexpr int64_t kDefaultPipelineMaxPendingBytes = 64 << 20;
 } // namespace
 
 struct ShuffleWriterOptions {
@@ -48,6 +53,18 @@ struct ShuffleWriterOptions {
   std::string data_file;
   std::string partition_writer_type = "local";
 
+  // "hash" keeps per-partition buffers, "sort" appends rows to one buffer tagged with partition ids and sorts them by
+  // partition id before caching. The sort mode only works with the prefer-cache local partition writer.
+  std::string shuffle_writer_type = "hash";
+  // switch to the sort mode when the number of partitions reaches this value
+  int32_t sort_based_shuffle_threshold = kDefaultSortBasedShuffleThreshold;
+  // max bytes of the sort buffer before its rows are sorted and cached
+  int64_t sort_buffer_max_size = kDefaultSortBufferMaxSize;
+
+  // Compress payloads on a shared thread pool and write evicted partitions from a background thread. Only works with
+  // the prefer-evict local partition writer.
+  bool pipelined_write = false;
+
   int64_t thread_id = -1;
   int64_t task_attempt_id = -1;
 
@@ -149,6 +166,20 @@ class ShuffleWriter {
     return totalCompressTime_;
   }
 
+  // Time the task thread spent on or waiting for compression and writes. Equals the total time unless
+  // pipelined_write is set, in which case the total time also includes the time overlapped in background threads.
+  int64_t totalCompressWallTime() const {
+    return options_.pipelined_write ? totalCompressWallTime_ : totalCompressTime_;
+  }
+
+  int64_t totalWriteWallTime() const {
+    return options_.pipelined_write ? totalWriteWallTime_ : totalWriteTime_;
+  }
+
+  // Max bytes in flight in the compression and write pipeline, the configured limit or a quarter of
+  // offheap_per_task, whichever is smaller.
+  int64_t pipelineMaxPendingBytes() const;
+
   const std::vector<int64_t>& partitionLengths() const {
     return partitionLengths_;
   }
@@ -197,6 +228,10 @@ class ShuffleWriter {
     totalBytesWritten_ = totalBytesWritten;
   }
 
+  void setTotalWriteWallTime(int64_t totalWriteWallTime) {
+    totalWriteWallTime_ = totalWriteWallTime;
+  }
+
   void setTotalEvictTime(int64_t totalEvictTime) {
     totalEvictTime_ = totalEvictTime;
   }
@@ -215,6 +250,15 @@ class ShuffleWriter {
 
   class PartitionWriterCreator;
 
+  // Shared by all shuffle writers in the process to compress payloads when pipelined_write is set.
+  static arrow::Result<arrow::internal::ThreadPool*> pipelineThreadPool();
+
+  // Number of threads of pipelineThreadPool(), set once at backend initialization before the pool is created.
+  static void setPipelineThreads(int32_t numThreads);
+
+  // Upper bound of pipelineMaxPendingBytes() for all shuffle writers in the process, set at backend initialization.
+  static void setPipelineMaxPendingBytes(int64_t maxPendingBytes);
+
  protected:
   ShuffleWriter(
       int32_t numPartitions,
@@ -237,6 +281,8 @@ class ShuffleWriter {
   int64_t totalWriteTime_ = 0;
   int64_t totalEvictTime_ = 0;
   int64_t totalCompressTime_ = 0;
+  int64_t totalCompressWallTime_ = 0;
+  int64_t totalWriteWallTime_ = 0;
   int64_t peakMemoryAllocated_ = 0;
 
   std::vector<int64_t> partitionLengths_;
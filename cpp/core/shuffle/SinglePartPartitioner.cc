@@ -27,4 +27,13 @@ arrow::Status gluten::SinglePartPartitioner::compute(
   // nothing is need do here
   return arrow::Status::OK();
 }
+
+arrow::Status gluten::SinglePartPartitioner::compute(
+    const int32_t* pidArr,
+    const int64_t numRows,
+    std::vector<uint32_t>& partitionId,
+    std::vector<uint32_t>& partitionIdCnt) {
+  // nothing is need do here
+  return arrow::Status::OK();
+}
 } // namespace gluten
@@ -48,28 +48,121 @@ Reader::Reader(
   }
 }
 
+Reader::~Reader() {
+  stopPrefetch();
+}
+
 arrow::Result<std::shared_ptr<ColumnarBatch>> Reader::next() {
+  std::shared_ptr<arrow::RecordBatch> arrowBatch;
+  if (options_.prefetch_batches > 0) {
+    if (!prefetchThread_.joinable() && !prefetchFinished_) {
+      prefetchThread_ = std::thread([this] { prefetchLoop(); });
+    }
+    TIME_NANO_START(consumerWaitTime_)
+    auto result = takePrefetchedBatch();
+    TIME_NANO_END(consumerWaitTime_)
+    ARROW_ASSIGN_OR_RAISE(arrowBatch, std::move(result));
+  } else {
+    ARROW_ASSIGN_OR_RAISE(arrowBatch, readNextBatch(consumerWaitTime_));
+  }
+  if (arrowBatch == nullptr) {
+    return nullptr;
+  }
+  std::shared_ptr<ColumnarBatch> glutenBatch = std::make_shared<ArrowColumnarBatch>(arrowBatch);
+  return glutenBatch;
+}
+
+arrow::Result<std::shared_ptr<arrow::RecordBatch>> Reader::readNextBatch(int64_t& readTime) {
   std::shared_ptr<arrow::RecordBatch> arrowBatch;
   std::unique_ptr<arrow::ipc::Message> messageToRead;
   if (!firstMessageConsumed_) {
     messageToRead = std::move(firstMessage_);
     firstMessageConsumed_ = true;
   } else {
-    GLUTEN_ASSIGN_OR_THROW(messageToRead, arrow::ipc::ReadMessage(in_.get()))
+    TIME_NANO_START(readTime)
+    auto message = arrow::ipc::ReadMessage(in_.get());
+    TIME_NANO_END(readTime)
+    ARROW_ASSIGN_OR_RAISE(messageToRead, std::move(message))
   }
   if (messageToRead == nullptr) {
     return nullptr;
   }
 
-  TIME_NANO_START(decompressTime_)
-  GLUTEN_ASSIGN_OR_THROW(
+  TIME_NANO_START(decompressTime)
+  ARROW_ASSIGN_OR_RAISE(
       arrowBatch, arrow::ipc::ReadRecordBatch(*messageToRead, writeSchema_, nullptr, options_.ipc_read_options))
-  TIME_NANO_END(decompressTime_)
-  std::shared_ptr<ColumnarBatch> glutenBatch = std::make_shared<ArrowColumnarBatch>(arrowBatch);
-  return glutenBatch;
+  TIME_NANO_END(decompressTime)
+  decompressTime_ += decompressTime;
+  return arrowBatch;
+}
+
+arrow::Result<std::shared_ptr<arrow::RecordBatch>> Reader::takePrefetchedBatch() {
+  std::unique_lock<std::mutex> lock(prefetchMutex_);
+  prefetchNotEmpty_.wait(lock, [this] { return !prefetchedBatches_.empty() || prefetchFinished_; });
+  if (prefetchedBatches_.empty()) {
+    // The end of stream or the error has already been returned.
+    return nullptr;
+  }
+  auto result = std::move(prefetchedBatches_.front());
+  prefetchedBatches_.pop_front();
+  prefetchNotFull_.notify_one();
+  return result;
+}
+
+void Reader::prefetchLoop() {
+  struct ExitGuard {
+    const std::function<void()>& onExit;
+    ~ExitGuard() {
+      if (onExit) {
+        onExit();
+      }
+    }
+  } exitGuard{options_.prefetch_thread_exit};
+
+  int64_t readTime = 0; // the consumer doesn't wait for the reads of this thread
+  while (true) {
+    arrow::Result<std::shared_ptr<arrow::RecordBatch>> result;
+    try {
+      result = readNextBatch(readTime);
+    } catch (const std::exception& e) {
+      // Surface exceptions from the input stream to the consumer thread.
+      result = arrow::Status::IOError("Failed to prefetch shuffle batch: ", e.what());
+    }
+    bool last = !result.ok() || *result == nullptr;
+    std::unique_lock<std::mutex> lock(prefetchMutex_);
+    prefetchNotFull_.wait(lock, [this] {
+      return prefetchStopped_ || prefetchedBatches_.size() < static_cast<size_t>(options_.prefetch_batches);
+    });
+    if (prefetchStopped_) {
+      return;
+    }
+    prefetchedBatches_.push_back(std::move(result));
+    if (last) {
+      prefetchFinished_ = true;
+    }
+    prefetchNotEmpty_.notify_one();
+    if (last) {
+      return;
+    }
+  }
+}
+
+void Reader::stopPrefetch() {
+  {
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    prefetchStopped_ = true;
+    prefetchFinished_ = true;
+    prefetchedBatches_.clear();
+  }
+  prefetchNotFull_.notify_all();
+  prefetchNotEmpty_.notify_all();
+  if (prefetchThread_.joinable()) {
+    prefetchThread_.join();
+  }
 }
 
 arrow::Status Reader::close() {
+  stopPrefetch();
   return arrow::Status::OK();
 }
 
@@ -77,4 +170,8 @@ int64_t Reader::getDecompressTime() {
   return decompressTime_;
 }
 
+int64_t Reader::getConsumerWaitTime() {
+  return consumerWaitTime_;
+}
+
 } // namespace gluten
@@ -22,10 +22,24 @@
 #include <arrow/ipc/message.h>
 #include <arrow/ipc/options.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
 namespace gluten {
 
 struct ReaderOptions {
   arrow::ipc::IpcReadOptions ipc_read_options = arrow::ipc::IpcReadOptions::Defaults();
+  // Number of decompressed batches to read ahead in a background thread. 0 disables prefetching.
+  int32_t prefetch_batches = 0;
+  // Concatenate consecutive small batches until the row count or byte size reaches the target. 0 disables the limit.
+  int32_t coalesce_batch_rows = 0;
+  int64_t coalesce_batch_bytes = 0;
+  // Called by the prefetch thread before it exits, e.g. to detach it from the JVM the input stream attached it to.
+  std::function<void()> prefetch_thread_exit;
 
   static ReaderOptions defaults();
 };
@@ -38,20 +52,39 @@ class Reader {
       ReaderOptions options,
       std::shared_ptr<arrow::MemoryPool> pool);
 
-  virtual ~Reader() = default;
+  virtual ~Reader();
 
   virtual arrow::Result<std::shared_ptr<ColumnarBatch>> next();
   arrow::Status close();
   int64_t getDecompressTime();
+  // Time the consumer of next() spent blocked on the input, excluding decompression. With prefetching it's the time
+  // waiting for the prefetch queue, otherwise the time reading messages from the input stream.
+  int64_t getConsumerWaitTime();
 
  private:
+  // Adds the time reading the message from the input stream to readTime.
+  arrow::Result<std::shared_ptr<arrow::RecordBatch>> readNextBatch(int64_t& readTime);
+  arrow::Result<std::shared_ptr<arrow::RecordBatch>> takePrefetchedBatch();
+  void prefetchLoop();
+  void stopPrefetch();
+
   std::shared_ptr<arrow::MemoryPool> pool_;
   std::shared_ptr<arrow::io::InputStream> in_;
   ReaderOptions options_;
   std::shared_ptr<arrow::Schema> writeSchema_;
   std::unique_ptr<arrow::ipc::Message> firstMessage_;
   bool firstMessageConsumed_ = false;
-  int64_t decompressTime_ = 0;
+  std::atomic<int64_t> decompressTime_{0};
+  int64_t consumerWaitTime_ = 0;
+
+  // Prefetch queue filled by prefetchThread_. Ends with a nullptr batch or an error.
+  std::mutex prefetchMutex_;
+  std::condition_variable prefetchNotFull_;
+  std::condition_variable prefetchNotEmpty_;
+  std::deque<arrow::Result<std::shared_ptr<arrow::RecordBatch>>> prefetchedBatches_;
+  bool prefetchStopped_ = false;
+  bool prefetchFinished_ = false;
+  std::thread prefetchThread_;
 };
 
 } // namespace gluten
@@ -0,0 +1,102 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "memory/MemoryAllocator.h"
+
+#include <thread>
+#include <vector>
+
+namespace gluten {
+
+class CountingAllocationListener final : public AllocationListener {
+ public:
+  void allocationChanged(int64_t diff) override {
+    bytes_ += diff;
+    calls_++;
+  }
+
+  std::atomic<int64_t> bytes_{0};
+  std::atomic<int32_t> calls_{0};
+};
+
+TEST(BlockAllocationListenerTest, reserveInBlocks) {
+  auto counting = std::make_shared<CountingAllocationListener>();
+  BlockAllocationListener listener(counting, 100);
+
+  listener.allocationChanged(10);
+  ASSERT_EQ(counting->bytes_, 100);
+  ASSERT_EQ(counting->calls_, 1);
+
+  // Served from the reserved block.
+  for (int32_t i = 0; i < 9; ++i) {
+    listener.allocationChanged(10);
+  }
+  ASSERT_EQ(listener.usedBytes(), 100);
+  ASSERT_EQ(counting->calls_, 1);
+
+  listener.allocationChanged(250);
+  ASSERT_EQ(counting->bytes_, 400);
+  ASSERT_EQ(counting->calls_, 2);
+}
+
+TEST(BlockAllocationListenerTest, releaseFreeBlocks) {
+  auto counting = std::make_shared<CountingAllocationListener>();
+  BlockAllocationListener listener(counting, 100);
+
+  listener.allocationChanged(350);
+  ASSERT_EQ(counting->bytes_, 400);
+
+  // Within the last block.
+  listener.allocationChanged(-40);
+  ASSERT_EQ(counting->bytes_, 400);
+  ASSERT_EQ(counting->calls_, 1);
+
+  listener.allocationChanged(-260);
+  ASSERT_EQ(listener.usedBytes(), 50);
+  ASSERT_EQ(counting->bytes_, 100);
+
+  listener.allocationChanged(-50);
+  ASSERT_EQ(counting->bytes_, 0);
+  ASSERT_EQ(listener.reservedBytes(), 0);
+}
+
+TEST(BlockAllocationListenerTest, concurrentChanges) {
+  auto counting = std::make_shared<CountingAllocationListener>();
+  BlockAllocationListener listener(counting, 100);
+
+  // Every thread crosses block boundaries back and forth, the reservation must cover the usage at the end.
+  std::vector<std::thread> threads;
+  for (int32_t t = 0; t < 8; ++t) {
+    threads.emplace_back([&listener, t]() {
+      for (int32_t i = 0; i < 10000; ++i) {
+        listener.allocationChanged(30 + t);
+        listener.allocationChanged(-(30 + t));
+      }
+      listener.allocationChanged(70);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(listener.usedBytes(), 560);
+  ASSERT_EQ(listener.reservedBytes(), 600);
+  ASSERT_EQ(counting->bytes_, 600);
+}
+
+} // namespace gluten
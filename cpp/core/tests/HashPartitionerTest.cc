@@ -0,0 +1,82 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+
+#include "shuffle/Partitioner.h"
+#include "utils/exception.h"
+
+namespace gluten {
+
+namespace {
+
+std::vector<int32_t> makeHashes(int64_t numRows) {
+  std::mt19937 rng(7);
+  std::vector<int32_t> hashes(numRows);
+  for (auto& hash : hashes) {
+    hash = rng();
+  }
+  hashes[0] = std::numeric_limits<int32_t>::min();
+  hashes[1] = std::numeric_limits<int32_t>::max();
+  hashes[2] = 0;
+  hashes[3] = -1;
+  return hashes;
+}
+
+template <typename PidType>
+void checkHashPartition(int32_t numPartitions, int64_t numRows) {
+  auto hashes = makeHashes(numRows);
+  GLUTEN_ASSIGN_OR_THROW(auto partitioner, ShuffleWriter::Partitioner::make("hash", numPartitions));
+
+  std::vector<PidType> partitionId;
+  std::vector<uint32_t> partitionIdCnt(numPartitions);
+  ASSERT_TRUE(partitioner->compute(hashes.data(), numRows, partitionId, partitionIdCnt).ok());
+
+  std::vector<uint32_t> expectedCnt(numPartitions, 0);
+  for (auto i = 0; i < numRows; ++i) {
+    auto expected = ((static_cast<int64_t>(hashes[i]) % numPartitions) + numPartitions) % numPartitions;
+    ASSERT_EQ(partitionId[i], expected) << "row " << i << ", hash " << hashes[i];
+    expectedCnt[expected]++;
+  }
+  ASSERT_EQ(partitionIdCnt, expectedCnt);
+}
+
+} // namespace
+
+TEST(HashPartitionerTest, pmod) {
+  for (auto numPartitions : {1, 3, 200, 4096, 65536}) {
+    // Few rows per partition and many rows per partition take different counting paths.
+    for (auto numRows : {5, 4096, 100000}) {
+      checkHashPartition<uint16_t>(numPartitions, numRows);
+      checkHashPartition<uint32_t>(numPartitions, numRows);
+    }
+  }
+}
+
+TEST(HashPartitionerTest, moreThan64kPartitions) {
+  checkHashPartition<uint32_t>(100000, 4096);
+
+  GLUTEN_ASSIGN_OR_THROW(auto partitioner, ShuffleWriter::Partitioner::make("hash", 100000));
+  auto hashes = makeHashes(16);
+  std::vector<uint16_t> partitionId;
+  std::vector<uint32_t> partitionIdCnt(100000);
+  ASSERT_TRUE(partitioner->compute(hashes.data(), 16, partitionId, partitionIdCnt).IsInvalid());
+}
+
+} // namespace gluten
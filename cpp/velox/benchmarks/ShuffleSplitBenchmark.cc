@@ -27,10 +27,12 @@
 #include <sched.h>
 
 #include <chrono>
+#include <random>
 
 #include "benchmarks/BenchmarkUtils.h"
 #include "memory/ColumnarBatch.h"
 #include "shuffle/LocalPartitionWriter.h"
+#include "shuffle/SplitKernels.h"
 #include "shuffle/VeloxShuffleWriter.h"
 #include "utils/TestUtils.h"
 #include "utils/VeloxArrowUtils.h"
@@ -355,14 +357,78 @@ class BenchmarkShuffleSplitIterateScanBenchmark : public BenchmarkShuffleSplit {
   }
 };
 
+// The split kernels alone on one batch, with row ids grouped by partition as VeloxShuffleWriter lays them out.
+// Args: element width in bytes (0 gathers validity bits), number of partitions, SimdLevel.
+void splitKernelBenchmark(benchmark::State& state) {
+  const auto width = static_cast<uint32_t>(state.range(0));
+  const auto numPartitions = static_cast<uint32_t>(state.range(1));
+  const auto level = static_cast<SimdLevel>(state.range(2));
+  const uint32_t numRows = kBatchBufferSize;
+
+  std::mt19937 rng(0);
+  std::vector<uint8_t> src(numRows * std::max(width, 1u));
+  for (auto& byte : src) {
+    byte = rng();
+  }
+
+  std::vector<uint32_t> partitionIds(numRows);
+  std::vector<uint32_t> partition2RowOffset(numPartitions + 1, 0);
+  for (auto& pid : partitionIds) {
+    pid = rng() % numPartitions;
+    partition2RowOffset[pid + 1]++;
+  }
+  for (uint32_t pid = 0; pid < numPartitions; ++pid) {
+    partition2RowOffset[pid + 1] += partition2RowOffset[pid];
+  }
+  std::vector<uint32_t> rowOffset2RowId(numRows);
+  auto offsets = partition2RowOffset;
+  for (uint32_t row = 0; row < numRows; ++row) {
+    rowOffset2RowId[offsets[partitionIds[row]]++] = row;
+  }
+
+  std::vector<uint8_t> dst(src.size());
+  for (auto _ : state) {
+    auto out = dst.data();
+    for (uint32_t pid = 0; pid < numPartitions; ++pid) {
+      auto begin = partition2RowOffset[pid];
+      auto size = partition2RowOffset[pid + 1] - begin;
+      if (width == 0) {
+        gatherBits(level, src.data(), numRows, rowOffset2RowId.data() + begin, size / 8, out);
+        out += size / 8;
+      } else {
+        gatherFixedWidth(level, width, src.data(), numRows, rowOffset2RowId.data() + begin, size, out);
+        out += size * width;
+      }
+    }
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * numRows);
+  state.SetLabel(simdLevelName(level));
+}
+
 } // namespace gluten
 
 int main(int argc, char** argv) {
   benchmark::Initialize(&argc, argv);
   gflags::ParseCommandLineFlags(&argc, &argv, true);
 
+  auto kernelBm = benchmark::RegisterBenchmark("BenchmarkShuffleSplit::Kernel", gluten::splitKernelBenchmark)
+                      ->ArgNames({"width", "partitions", "simd"});
+  auto maxLevel = static_cast<int64_t>(gluten::detectSimdLevel());
+  for (int64_t width : {0, 1, 2, 4, 8, 16}) {
+    for (int64_t partitions : {1, 16, 256, 1024, 4096}) {
+      for (int64_t level = 0; level <= maxLevel; ++level) {
+        kernelBm->Args({width, partitions, level});
+      }
+    }
+  }
+
   if (FLAGS_file.size() == 0) {
-    std::cerr << "No input data file. Please specify via argument --file" << std::endl;
+    std::cerr << "No input data file. Please specify via argument --file to run the split benchmark" << std::endl;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
   }
 
   if (FLAGS_partitions == -1) {
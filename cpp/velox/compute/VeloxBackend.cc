@@ -21,6 +21,7 @@
 #include "arrow/c/bridge.h"
 #include "compute/Backend.h"
 #include "compute/ResultIterator.h"
+#include "compute/VeloxPlanCache.h"
 #include "compute/VeloxPlanConverter.h"
 #include "config/GlutenConfig.h"
 #include "operators/serializer/VeloxRowToColumnarConverter.h"
@@ -71,8 +72,25 @@ std::shared_ptr<ResultIterator> VeloxBackend::getResultIterator(
 
   auto veloxPool = asAggregateVeloxMemoryPool(allocator);
   auto ctxPool = veloxPool->addAggregateChild("result_iterator", facebook::velox::memory::MemoryReclaimer::create());
-  auto veloxPlanConverter = std::make_unique<VeloxPlanConverter>(inputIters_);
-  veloxPlan_ = veloxPlanConverter->toVeloxPlan(substraitPlan_);
+
+  // Plans reading from input iterators hold the iterators in their nodes and cannot be shared between tasks.
+  auto& planCache = VeloxPlanCache::get();
+  bool cachePlan = inputIters_.empty() && planCache.enabled();
+  SplitInfoMap splitInfos;
+  VeloxPlanCache::Key cacheKey;
+  veloxPlan_ = nullptr;
+  if (cachePlan) {
+    cacheKey = VeloxPlanCache::makeKey(substraitPlan_);
+    veloxPlan_ = planCache.lookup(cacheKey, splitInfos);
+  }
+  if (veloxPlan_ == nullptr) {
+    auto veloxPlanConverter = std::make_unique<VeloxPlanConverter>(inputIters_);
+    veloxPlan_ = veloxPlanConverter->toVeloxPlan(substraitPlan_);
+    splitInfos = veloxPlanConverter->splitInfos();
+    if (cachePlan) {
+      planCache.insert(cacheKey, veloxPlan_, splitInfos);
+    }
+  }
 
   // Scan node can be required.
   std::vector<std::shared_ptr<velox::substrait::SplitInfo>> scanInfos;
@@ -80,7 +98,7 @@ std::shared_ptr<ResultIterator> VeloxBackend::getResultIterator(
   std::vector<velox::core::PlanNodeId> streamIds;
 
   // Separate the scan ids and stream ids, and get the scan infos.
-  getInfoAndIds(veloxPlanConverter->splitInfos(), veloxPlan_->leafPlanNodeIds(), scanInfos, scanIds, streamIds);
+  getInfoAndIds(splitInfos, veloxPlan_->leafPlanNodeIds(), scanInfos, scanIds, streamIds);
 
   if (scanInfos.size() == 0) {
     // Source node is not required.
@@ -23,6 +23,7 @@
 #include "config/GlutenConfig.h"
 #include "operators/functions/RegistrationAllFunctions.h"
 #include "operators/plannodes/RowVectorStream.h"
+#include "shuffle/ShuffleWriter.h"
 #ifdef GLUTEN_ENABLE_QAT
 #include "utils/qat/QatCodec.h"
 #endif
@@ -74,6 +75,14 @@ const std::string kVeloxIOThreadsDefault = "0";
 const std::string kVeloxSplitPreloadPerDriver = "spark.gluten.sql.columnar.backend.velox.SplitPreloadPerDriver";
 const std::string kVeloxSplitPreloadPerDriverDefault = "2";
 
+// plan cache
+const std::string kVeloxPlanCacheSize = "spark.gluten.sql.columnar.backend.velox.planCacheSize";
+const std::string kVeloxPlanCacheSizeDefault = "0";
+
+// multi-threaded task execution
+const std::string kVeloxDriverThreads = "spark.gluten.sql.columnar.backend.velox.driverThreads";
+const std::string kVeloxDriverThreadsDefault = "0";
+
 // spill, mem ratios and thresholds
 const std::string kSpillStrategy = "spark.gluten.sql.columnar.backend.velox.spillStrategy";
 const std::string kMemoryCapRatio = "spark.gluten.sql.columnar.backend.velox.memoryCapRatio";
@@ -207,7 +216,10 @@ void VeloxInitializer::init(const std::unordered_map<std::string, std::string>&
 
   initCache(conf);
   initIOExecutor(conf);
+  initDriverExecutor(conf);
+  initPlanCache(conf);
   initHWAccelerators(conf);
+  initShuffle(conf);
 
 #ifdef GLUTEN_PRINT_DEBUG
   printConf(conf);
@@ -314,6 +326,41 @@ void VeloxInitializer::initIOExecutor(const std::unordered_map<std::string, std:
   }
 }
 
+void VeloxInitializer::initPlanCache(const std::unordered_map<std::string, std::string>& conf) {
+  int32_t planCacheSize = std::stoi(kVeloxPlanCacheSizeDefault);
+  auto got = conf.find(kVeloxPlanCacheSize);
+  if (got != conf.end()) {
+    planCacheSize = std::stoi(got->second);
+  }
+  if (planCacheSize > 0) {
+    VeloxPlanCache::get().setCapacity(planCacheSize);
+    LOG(INFO) << "STARTUP: Using plan cache, size: " << planCacheSize;
+  }
+}
+
+void VeloxInitializer::initDriverExecutor(const std::unordered_map<std::string, std::string>& conf) {
+  int32_t driverThreads = std::stoi(kVeloxDriverThreadsDefault);
+  auto got = conf.find(kVeloxDriverThreads);
+  if (got != conf.end()) {
+    driverThreads = std::stoi(got->second);
+  }
+  if (driverThreads > 0) {
+    driverExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(driverThreads);
+    LOG(INFO) << "STARTUP: Using multi-threaded task execution, driver threads: " << driverThreads;
+  }
+}
+
+void VeloxInitializer::initShuffle(const std::unordered_map<std::string, std::string>& conf) {
+  auto got = conf.find(kShufflePipelineThreads);
+  if (got != conf.end()) {
+    ShuffleWriter::setPipelineThreads(std::stoi(got->second));
+  }
+  got = conf.find(kShufflePipelineMaxPendingBytes);
+  if (got != conf.end()) {
+    ShuffleWriter::setPipelineMaxPendingBytes(std::stoll(got->second));
+  }
+}
+
 void VeloxInitializer::initHWAccelerators(const std::unordered_map<std::string, std::string>& conf) {
   auto got = conf.find(kShuffleCompressionCodecBackend);
   if (got != conf.end() && !got->second.empty()) {
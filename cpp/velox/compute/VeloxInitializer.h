@@ -21,9 +21,11 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <filesystem>
 
+#include "compute/VeloxPlanCache.h"
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/MemoryPool.h"
 
@@ -33,6 +35,10 @@ namespace gluten {
 class VeloxInitializer {
  public:
   ~VeloxInitializer() {
+    if (VeloxPlanCache::get().enabled()) {
+      LOG(INFO) << "Plan cache hits: " << VeloxPlanCache::get().hits()
+                << ", misses: " << VeloxPlanCache::get().misses();
+    }
     if (dynamic_cast<facebook::velox::cache::AsyncDataCache*>(asyncDataCache_.get())) {
       LOG(INFO) << asyncDataCache_->toString();
       for (const auto& entry : std::filesystem::directory_iterator(cachePathPrefix_)) {
@@ -58,6 +64,11 @@ class VeloxInitializer {
     return spillThreshold_;
   }
 
+  /// Executor shared by the tasks running with more than one driver. Null if disabled.
+  folly::Executor* getDriverExecutor() const {
+    return driverExecutor_.get();
+  }
+
  private:
   explicit VeloxInitializer(const std::unordered_map<std::string, std::string>& conf) {
     init(conf);
@@ -66,7 +77,10 @@ class VeloxInitializer {
   void init(const std::unordered_map<std::string, std::string>& conf);
   void initCache(const std::unordered_map<std::string, std::string>& conf);
   void initIOExecutor(const std::unordered_map<std::string, std::string>& conf);
+  void initDriverExecutor(const std::unordered_map<std::string, std::string>& conf);
+  void initPlanCache(const std::unordered_map<std::string, std::string>& conf);
   void initHWAccelerators(const std::unordered_map<std::string, std::string>& conf);
+  void initShuffle(const std::unordered_map<std::string, std::string>& conf);
 
   void printConf(const std::unordered_map<std::string, std::string>& conf);
 
@@ -87,6 +101,7 @@ class VeloxInitializer {
 
   std::unique_ptr<folly::IOThreadPoolExecutor> ssdCacheExecutor_;
   std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> driverExecutor_;
 
   std::string cachePathPrefix_;
   std::string cacheFilePrefix_;
@@ -0,0 +1,172 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VeloxPlanCache.h"
+
+using namespace facebook;
+
+namespace gluten {
+
+namespace {
+
+using SubstraitFileFormatCase = ::substrait::ReadRel_LocalFiles_FileOrFiles::FileFormatCase;
+
+std::shared_ptr<velox::substrait::SplitInfo> toSplitInfo(const ::substrait::ReadRel::LocalFiles& localFiles) {
+  auto splitInfo = std::make_shared<velox::substrait::SplitInfo>();
+  const auto& fileList = localFiles.items();
+  splitInfo->paths.reserve(fileList.size());
+  splitInfo->starts.reserve(fileList.size());
+  splitInfo->lengths.reserve(fileList.size());
+  for (const auto& file : fileList) {
+    splitInfo->partitionIndex = file.partition_index();
+    splitInfo->paths.emplace_back(file.uri_file());
+    splitInfo->starts.emplace_back(file.start());
+    splitInfo->lengths.emplace_back(file.length());
+    switch (file.file_format_case()) {
+      case SubstraitFileFormatCase::kOrc:
+        splitInfo->format = velox::dwio::common::FileFormat::ORC;
+        break;
+      case SubstraitFileFormatCase::kDwrf:
+        splitInfo->format = velox::dwio::common::FileFormat::DWRF;
+        break;
+      case SubstraitFileFormatCase::kParquet:
+        splitInfo->format = velox::dwio::common::FileFormat::PARQUET;
+        break;
+      default:
+        splitInfo->format = velox::dwio::common::FileFormat::UNKNOWN;
+    }
+  }
+  return splitInfo;
+}
+
+bool sameSplits(const velox::substrait::SplitInfo& a, const velox::substrait::SplitInfo& b) {
+  return a.isStream == b.isStream && a.format == b.format && a.paths == b.paths && a.starts == b.starts &&
+      a.lengths == b.lengths;
+}
+
+// Moves the local files of all read relations under rel into splitInfos, visiting inputs in the same order as
+// VeloxPlanConverter.
+void extractSplits(::substrait::Rel& rel, std::vector<std::shared_ptr<velox::substrait::SplitInfo>>& splitInfos) {
+  if (rel.has_aggregate()) {
+    extractSplits(*rel.mutable_aggregate()->mutable_input(), splitInfos);
+  } else if (rel.has_project()) {
+    extractSplits(*rel.mutable_project()->mutable_input(), splitInfos);
+  } else if (rel.has_filter()) {
+    extractSplits(*rel.mutable_filter()->mutable_input(), splitInfos);
+  } else if (rel.has_join()) {
+    extractSplits(*rel.mutable_join()->mutable_left(), splitInfos);
+    extractSplits(*rel.mutable_join()->mutable_right(), splitInfos);
+  } else if (rel.has_sort()) {
+    extractSplits(*rel.mutable_sort()->mutable_input(), splitInfos);
+  } else if (rel.has_expand()) {
+    extractSplits(*rel.mutable_expand()->mutable_input(), splitInfos);
+  } else if (rel.has_fetch()) {
+    extractSplits(*rel.mutable_fetch()->mutable_input(), splitInfos);
+  } else if (rel.has_window()) {
+    extractSplits(*rel.mutable_window()->mutable_input(), splitInfos);
+  } else if (rel.has_read() && rel.read().has_local_files()) {
+    splitInfos.emplace_back(toSplitInfo(rel.read().local_files()));
+    rel.mutable_read()->clear_local_files();
+  }
+}
+
+} // namespace
+
+VeloxPlanCache& VeloxPlanCache::get() {
+  static VeloxPlanCache cache;
+  return cache;
+}
+
+void VeloxPlanCache::setCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  while (entries_.size() > capacity) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
+
+VeloxPlanCache::Key VeloxPlanCache::makeKey(const ::substrait::Plan& plan) {
+  Key key;
+  ::substrait::Plan planWithoutSplits = plan;
+  for (auto& srel : *planWithoutSplits.mutable_relations()) {
+    if (srel.has_root()) {
+      extractSplits(*srel.mutable_root()->mutable_input(), key.splitInfos);
+    }
+    if (srel.has_rel()) {
+      extractSplits(*srel.mutable_rel(), key.splitInfos);
+    }
+  }
+  planWithoutSplits.SerializeToString(&key.bytes);
+  return key;
+}
+
+std::shared_ptr<const velox::core::PlanNode> VeloxPlanCache::lookup(const Key& key, SplitInfoMap& splitInfos) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key.bytes);
+  if (it == index_.end() || it->second->scanNodeIds.size() != key.splitInfos.size()) {
+    misses_++;
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  const auto& entry = *it->second;
+  for (size_t i = 0; i < entry.scanNodeIds.size(); ++i) {
+    splitInfos[entry.scanNodeIds[i]] = key.splitInfos[i];
+  }
+  hits_++;
+  return entry.plan;
+}
+
+void VeloxPlanCache::insert(
+    const Key& key,
+    std::shared_ptr<const velox::core::PlanNode> plan,
+    const SplitInfoMap& splitInfos) {
+  if (splitInfos.size() != key.splitInfos.size()) {
+    return;
+  }
+  // Match each read relation to the scan node that got the same files.
+  std::vector<velox::core::PlanNodeId> scanNodeIds;
+  scanNodeIds.reserve(key.splitInfos.size());
+  for (const auto& splitInfo : key.splitInfos) {
+    const velox::core::PlanNodeId* match = nullptr;
+    for (const auto& [id, converted] : splitInfos) {
+      if (sameSplits(*splitInfo, *converted)) {
+        if (match != nullptr) {
+          return;
+        }
+        match = &id;
+      }
+    }
+    if (match == nullptr) {
+      return;
+    }
+    scanNodeIds.emplace_back(*match);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (capacity_ == 0 || index_.find(key.bytes) != index_.end()) {
+    return;
+  }
+  entries_.push_front({key.bytes, std::move(plan), std::move(scanNodeIds)});
+  index_[entries_.front().key] = entries_.begin();
+  while (entries_.size() > capacity_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
+
+} // namespace gluten
@@ -0,0 +1,96 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include "substrait/plan.pb.h"
+#include "velox/core/PlanNode.h"
+#include "velox/substrait/SubstraitToVeloxPlan.h"
+
+namespace gluten {
+
+using SplitInfoMap =
+    std::unordered_map<facebook::velox::core::PlanNodeId, std::shared_ptr<facebook::velox::substrait::SplitInfo>>;
+
+/// Process-wide LRU cache of Velox plans converted from Substrait plans. The tasks of a stage send the same plan
+/// except for the files they read, so a plan is keyed by its serialized bytes with the local files of its read
+/// relations removed. On a hit, the cached Velox plan is reused and only the split infos are rebuilt from the local
+/// files of the task's plan.
+class VeloxPlanCache {
+ public:
+  /// A key along with the split infos of the read relations of the plan it was made from.
+  struct Key {
+    std::string bytes;
+    /// In the order the read relations are visited.
+    std::vector<std::shared_ptr<facebook::velox::substrait::SplitInfo>> splitInfos;
+  };
+
+  static VeloxPlanCache& get();
+
+  /// 0 disables the cache.
+  void setCapacity(size_t capacity);
+
+  bool enabled() const {
+    return capacity_ > 0;
+  }
+
+  static Key makeKey(const ::substrait::Plan& plan);
+
+  /// Returns the cached Velox plan and fills the split infos of the task, or nullptr on a miss.
+  std::shared_ptr<const facebook::velox::core::PlanNode> lookup(const Key& key, SplitInfoMap& splitInfos);
+
+  /// Caches a Velox plan along with the split infos produced by converting it. The plan is not cached if the scan
+  /// nodes cannot be matched to the read relations unambiguously.
+  void insert(
+      const Key& key,
+      std::shared_ptr<const facebook::velox::core::PlanNode> plan,
+      const SplitInfoMap& splitInfos);
+
+  int64_t hits() const {
+    return hits_;
+  }
+
+  int64_t misses() const {
+    return misses_;
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const facebook::velox::core::PlanNode> plan;
+    /// Ids of the scan nodes, in the order of Key::splitInfos.
+    std::vector<facebook::velox::core::PlanNodeId> scanNodeIds;
+  };
+
+  VeloxPlanCache() = default;
+
+  std::atomic<size_t> capacity_{0};
+  std::mutex mutex_;
+  std::list<Entry> entries_;
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> index_;
+
+  std::atomic<int64_t> hits_{0};
+  std::atomic<int64_t> misses_{0};
+};
+
+} // namespace gluten
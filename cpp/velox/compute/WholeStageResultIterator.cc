@@ -38,6 +38,11 @@ const std::string kSpillPartitionBits = "spark.gluten.sql.columnar.backend.velox
 const std::string kSpillableReservationGrowthPct =
     "spark.gluten.sql.columnar.backend.velox.spillableReservationGrowthPct";
 
+// multi-threaded execution
+const std::string kMaxDrivers = "spark.gluten.sql.columnar.backend.velox.maxDrivers";
+// Number of pending output vectors per driver before the drivers block.
+const size_t kResultQueueSizePerDriver = 2;
+
 // metrics
 const std::string kDynamicFiltersProduced = "dynamicFiltersProduced";
 const std::string kDynamicFiltersAccepted = "dynamicFiltersAccepted";
@@ -66,11 +71,11 @@ WholeStageResultIterator::WholeStageResultIterator(
   getOrderedNodeIds(veloxPlan_, orderedNodeIds_);
 }
 
-std::shared_ptr<velox::core::QueryCtx> WholeStageResultIterator::createNewVeloxQueryCtx() {
+std::shared_ptr<velox::core::QueryCtx> WholeStageResultIterator::createNewVeloxQueryCtx(folly::Executor* executor) {
   std::unordered_map<std::string, std::shared_ptr<velox::Config>> connectorConfigs;
   connectorConfigs[kHiveConnectorId] = createConnectorConfig();
   std::shared_ptr<velox::core::QueryCtx> ctx = std::make_shared<velox::core::QueryCtx>(
-      nullptr,
+      executor,
       getQueryContextConf(),
       connectorConfigs,
       gluten::VeloxInitializer::get()->getAsyncDataCache(),
@@ -82,10 +87,19 @@ std::shared_ptr<velox::core::QueryCtx> WholeStageResultIterator::createNewVeloxQ
 
 std::shared_ptr<ColumnarBatch> WholeStageResultIterator::next() {
   addSplits_(task_.get());
-  if (task_->isFinished()) {
-    return nullptr;
+  velox::RowVectorPtr vector;
+  if (resultQueue_ != nullptr) {
+    if (!taskStarted_) {
+      velox::exec::Task::start(task_, maxDrivers_);
+      taskStarted_ = true;
+    }
+    vector = resultQueue_->dequeue(*task_);
+  } else {
+    if (task_->isFinished()) {
+      return nullptr;
+    }
+    vector = task_->next();
   }
-  velox::RowVectorPtr vector = task_->next();
   if (vector == nullptr) {
     return nullptr;
   }
@@ -100,6 +114,78 @@ std::shared_ptr<ColumnarBatch> WholeStageResultIterator::next() {
   return std::make_shared<VeloxColumnarBatch>(vector);
 }
 
+velox::exec::BlockingReason WholeStageResultIterator::ResultQueue::enqueue(
+    velox::RowVectorPtr vector,
+    velox::ContinueFuture* future) {
+  if (vector == nullptr) {
+    // One of the drivers has finished.
+    return velox::exec::BlockingReason::kNotBlocked;
+  }
+  // Load lazy vectors on the driver thread.
+  for (auto& child : vector->children()) {
+    child->loadedVector();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (closed_) {
+    return velox::exec::BlockingReason::kNotBlocked;
+  }
+  vectors_.emplace_back(std::move(vector));
+  notEmpty_.notify_one();
+  if (vectors_.size() < maxSize_) {
+    return velox::exec::BlockingReason::kNotBlocked;
+  }
+  auto [promise, semiFuture] = velox::makeVeloxContinuePromiseContract("WholeStageResultIterator::ResultQueue");
+  producerPromises_.emplace_back(std::move(promise));
+  *future = std::move(semiFuture);
+  return velox::exec::BlockingReason::kWaitForConsumer;
+}
+
+void WholeStageResultIterator::ResultQueue::finishWith(velox::exec::Task& task, folly::Executor* executor) {
+  // The drivers enqueue all their output before the task leaves the running state. A failed task doesn't enqueue any
+  // end marker, so the consumer is woken up by the state change rather than by the drivers.
+  task.stateChangeFuture(0).via(executor).thenTry([queue = shared_from_this()](folly::Try<folly::Unit>&&) {
+    std::lock_guard<std::mutex> lock(queue->mutex_);
+    queue->finished_ = true;
+    queue->notEmpty_.notify_all();
+  });
+}
+
+velox::RowVectorPtr WholeStageResultIterator::ResultQueue::dequeue(velox::exec::Task& task) {
+  std::vector<velox::ContinuePromise> promises;
+  velox::RowVectorPtr vector;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notEmpty_.wait(lock, [this] { return !vectors_.empty() || finished_ || closed_; });
+    if (vectors_.empty()) {
+      if (auto error = task.error()) {
+        std::rethrow_exception(error);
+      }
+      return nullptr;
+    }
+    vector = std::move(vectors_.front());
+    vectors_.pop_front();
+    promises.swap(producerPromises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  return vector;
+}
+
+void WholeStageResultIterator::ResultQueue::close() {
+  std::vector<velox::ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    vectors_.clear();
+    promises.swap(producerPromises_);
+    notEmpty_.notify_all();
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
 int64_t WholeStageResultIterator::spillFixedSize(int64_t size) {
   if (spillStrategy_ == "auto") {
     return pool_->reclaim(size);
@@ -354,16 +440,32 @@ WholeStageResultIteratorFirstStage::WholeStageResultIteratorFirstStage(
   // Set task parameters.
   std::unordered_set<velox::core::PlanNodeId> emptySet;
   velox::core::PlanFragment planFragment{planNode, velox::core::ExecutionStrategy::kUngrouped, 1, emptySet};
-  std::shared_ptr<velox::core::QueryCtx> queryCtx = createNewVeloxQueryCtx();
 
-  task_ = velox::exec::Task::create(
-      fmt::format("Gluten stage-{} task-{}", taskInfo.stageId, taskInfo.taskId),
-      std::move(planFragment),
-      0,
-      std::move(queryCtx));
-
-  if (!task_->supportsSingleThreadedExecution()) {
-    throw std::runtime_error("Task doesn't support single thread execution: " + planNode->toString());
+  // Run with multiple drivers only when opted in and there is no input iterator, which can only be pulled by one
+  // thread.
+  maxDrivers_ = std::stoul(getConfigValue(kMaxDrivers, "1"));
+  auto* driverExecutor = VeloxInitializer::get()->getDriverExecutor();
+  if (maxDrivers_ > 1 && driverExecutor != nullptr && streamIds.empty()) {
+    resultQueue_ = std::make_shared<ResultQueue>(maxDrivers_ * kResultQueueSizePerDriver);
+    task_ = velox::exec::Task::create(
+        fmt::format("Gluten stage-{} task-{}", taskInfo.stageId, taskInfo.taskId),
+        std::move(planFragment),
+        0,
+        createNewVeloxQueryCtx(driverExecutor),
+        [queue = resultQueue_](velox::RowVectorPtr vector, velox::ContinueFuture* future) {
+          return queue->enqueue(std::move(vector), future);
+        });
+    resultQueue_->finishWith(*task_, driverExecutor);
+  } else {
+    task_ = velox::exec::Task::create(
+        fmt::format("Gluten stage-{} task-{}", taskInfo.stageId, taskInfo.taskId),
+        std::move(planFragment),
+        0,
+        createNewVeloxQueryCtx());
+
+    if (!task_->supportsSingleThreadedExecution()) {
+      throw std::runtime_error("Task doesn't support single thread execution: " + planNode->toString());
+    }
   }
   task_->setSpillDirectory(spillDir);
   addSplits_ = [&](velox::exec::Task* task) {
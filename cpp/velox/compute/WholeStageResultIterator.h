@@ -9,6 +9,10 @@
 #include "velox/exec/Task.h"
 #include "velox/substrait/SubstraitToVeloxPlan.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 namespace gluten {
 
 class WholeStageResultIterator : public ColumnarBatchIterator {
@@ -19,6 +23,9 @@ class WholeStageResultIterator : public ColumnarBatchIterator {
       const std::unordered_map<std::string, std::string>& confMap);
 
   virtual ~WholeStageResultIterator() {
+    if (resultQueue_ != nullptr) {
+      resultQueue_->close();
+    }
     if (task_ != nullptr && task_->isRunning()) {
       // calling .wait() may take no effect in single thread execution mode
       task_->requestCancel().wait();
@@ -43,11 +50,47 @@ class WholeStageResultIterator : public ColumnarBatchIterator {
 
   std::shared_ptr<const facebook::velox::core::PlanNode> veloxPlan_;
 
+  /// Output of a task running with multiple drivers. The drivers push vectors through the task consumer and block
+  /// once maxSize vectors are pending.
+  class ResultQueue : public std::enable_shared_from_this<ResultQueue> {
+   public:
+    explicit ResultQueue(size_t maxSize) : maxSize_(maxSize) {}
+
+    facebook::velox::exec::BlockingReason enqueue(
+        facebook::velox::RowVectorPtr vector,
+        facebook::velox::ContinueFuture* future);
+
+    /// Wakes up the consumer once the task leaves the running state, whether it finished or failed. Call it once the
+    /// task has been created.
+    void finishWith(facebook::velox::exec::Task& task, folly::Executor* executor);
+
+    /// Waits for the next vector. Returns nullptr once the task is no longer running and the queue is drained, or
+    /// rethrows the error of the task.
+    facebook::velox::RowVectorPtr dequeue(facebook::velox::exec::Task& task);
+
+    /// Drops pending vectors and unblocks the producers.
+    void close();
+
+   private:
+    const size_t maxSize_;
+    std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::deque<facebook::velox::RowVectorPtr> vectors_;
+    std::vector<facebook::velox::ContinuePromise> producerPromises_;
+    bool finished_ = false;
+    bool closed_ = false;
+  };
+
  protected:
   /// Get config value by key.
   std::string getConfigValue(const std::string& key, const std::optional<std::string>& fallbackValue = std::nullopt);
 
-  std::shared_ptr<facebook::velox::core::QueryCtx> createNewVeloxQueryCtx();
+  std::shared_ptr<facebook::velox::core::QueryCtx> createNewVeloxQueryCtx(folly::Executor* executor = nullptr);
+
+  /// Set when the task runs with multiple drivers on the shared driver executor.
+  std::shared_ptr<ResultQueue> resultQueue_;
+  uint32_t maxDrivers_ = 1;
+  bool taskStarted_ = false;
 
  private:
   /// Get the Spark confs to Velox query context.
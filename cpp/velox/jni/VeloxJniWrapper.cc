@@ -23,6 +23,7 @@
 #include <exception>
 #include "compute/VeloxBackend.h"
 #include "compute/VeloxInitializer.h"
+#include "compute/VeloxPlanCache.h"
 #include "config/GlutenConfig.h"
 #include "jni/JniErrors.h"
 #include "memory/VeloxMemoryPool.h"
@@ -145,6 +146,18 @@ Java_io_glutenproject_vectorized_PlanEvaluatorJniWrapper_nativeDoValidateWithFal
   JNI_METHOD_END(nullptr)
 }
 
+JNIEXPORT jlong JNICALL Java_io_glutenproject_vectorized_PlanCacheJniWrapper_hits( // NOLINT
+    JNIEnv* env,
+    jclass clazz) {
+  return gluten::VeloxPlanCache::get().hits();
+}
+
+JNIEXPORT jlong JNICALL Java_io_glutenproject_vectorized_PlanCacheJniWrapper_misses( // NOLINT
+    JNIEnv* env,
+    jclass clazz) {
+  return gluten::VeloxPlanCache::get().misses();
+}
+
 #ifdef __cplusplus
 }
 #endif
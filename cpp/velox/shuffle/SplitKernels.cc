@@ -0,0 +1,359 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shuffle/SplitKernels.h"
+
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// The AVX-512 intrinsics in gcc's headers start from self-initialized undefined vectors, which -Wmaybe-uninitialized
+// reports once they are inlined into target("avx512f") functions.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace gluten {
+
+namespace {
+
+// 16-byte element without the 16-byte alignment requirement of int128_t, so that gcc doesn't emit movdqa.
+struct Bytes16 {
+  uint64_t lo;
+  uint64_t hi;
+};
+
+template <typename T>
+void gatherScalar(const uint8_t* src, const uint32_t* rowIds, uint32_t begin, uint32_t size, uint8_t* dst) {
+  auto typedSrc = reinterpret_cast<const T*>(src);
+  auto typedDst = reinterpret_cast<T*>(dst);
+  for (auto i = begin; i < size; ++i) {
+    typedDst[i] = typedSrc[rowIds[i]];
+  }
+}
+
+void gatherBitsScalar(const uint8_t* src, const uint32_t* rowIds, uint32_t begin, uint32_t numBytes, uint8_t* dst) {
+  for (auto byte = begin; byte < numBytes; ++byte) {
+    auto ids = rowIds + byte * 8;
+    uint8_t value = 0;
+    for (auto bit = 0; bit < 8; ++bit) {
+      value |= ((src[ids[bit] >> 3] >> (ids[bit] & 7)) & 1) << bit;
+    }
+    dst[byte] = value;
+  }
+}
+
+#if defined(__x86_64__)
+
+inline bool isWordAligned(const uint8_t* src) {
+  return (reinterpret_cast<uintptr_t>(src) & 3) == 0;
+}
+
+// Number of leading elements of 'width' bytes whose aligned 32-bit word lies entirely inside a buffer of 'numBytes'.
+// Row ids from this bound on are in the last, partial word and are gathered by the scalar loop.
+inline uint32_t rowsInWholeWords(uint64_t numBytes, uint32_t width) {
+  return static_cast<uint32_t>(numBytes / 4 * 4 / width);
+}
+
+// Each function returns the number of elements (or bitmap bytes) it gathered; the scalar loop finishes the rest.
+
+__attribute__((target("avx2"))) uint32_t
+gatherAvx2(
+    uint32_t width,
+    const uint8_t* src,
+    uint32_t numRows,
+    const uint32_t* rowIds,
+    uint32_t size,
+    uint8_t* dst) {
+  uint32_t i = 0;
+  switch (width) {
+    case 1: {
+      if (!isWordAligned(src)) {
+        return 0;
+      }
+      const auto lastSafe = _mm256_set1_epi32(static_cast<int>(rowsInWholeWords(numRows, 1)) - 1);
+      // Low byte of every 32-bit lane, then the two 128-bit lanes joined in the low 8 bytes.
+      const auto pick = _mm256_setr_epi8(
+          0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+          0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+      const auto join = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+      for (; i + 8 <= size; i += 8) {
+        auto ids = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rowIds + i));
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(ids, lastSafe))) {
+          gatherScalar<uint8_t>(src, rowIds, i, i + 8, dst);
+          continue;
+        }
+        auto words = _mm256_i32gather_epi32(reinterpret_cast<const int*>(src), _mm256_srli_epi32(ids, 2), 4);
+        auto values = _mm256_srlv_epi32(words, _mm256_slli_epi32(_mm256_and_si256(ids, _mm256_set1_epi32(3)), 3));
+        values = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(values, pick), join);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm256_castsi256_si128(values));
+      }
+      break;
+    }
+    case 2: {
+      if (!isWordAligned(src)) {
+        return 0;
+      }
+      const auto lastSafe = _mm256_set1_epi32(static_cast<int>(rowsInWholeWords(uint64_t(numRows) * 2, 2)) - 1);
+      const auto pick = _mm256_setr_epi8(
+          0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1,
+          0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+      const auto join = _mm256_setr_epi32(0, 1, 4, 5, 0, 0, 0, 0);
+      for (; i + 8 <= size; i += 8) {
+        auto ids = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rowIds + i));
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(ids, lastSafe))) {
+          gatherScalar<uint16_t>(src, rowIds, i, i + 8, dst);
+          continue;
+        }
+        auto words = _mm256_i32gather_epi32(reinterpret_cast<const int*>(src), _mm256_srli_epi32(ids, 1), 4);
+        auto values = _mm256_srlv_epi32(words, _mm256_slli_epi32(_mm256_and_si256(ids, _mm256_set1_epi32(1)), 4));
+        values = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(values, pick), join);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm256_castsi256_si128(values));
+      }
+      break;
+    }
+    case 4:
+      for (; i + 8 <= size; i += 8) {
+        auto ids = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rowIds + i));
+        auto values = _mm256_i32gather_epi32(reinterpret_cast<const int*>(src), ids, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), values);
+      }
+      break;
+    case 8:
+      for (; i + 4 <= size; i += 4) {
+        auto ids = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rowIds + i));
+        auto values = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(src), ids, 8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 8), values);
+      }
+      break;
+    case 16:
+      // Gather each row as two 64-bit halves: [2a, 2a + 1, 2b, 2b + 1].
+      for (; i + 2 <= size; i += 2) {
+        auto ids = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(rowIds + i));
+        ids = _mm_unpacklo_epi32(ids, ids);
+        ids = _mm_add_epi32(_mm_slli_epi32(ids, 1), _mm_setr_epi32(0, 1, 0, 1));
+        auto values = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(src), ids, 8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 16), values);
+      }
+      break;
+    default:
+      return 0;
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) uint32_t
+gatherBitsAvx2(const uint8_t* src, uint32_t numRows, const uint32_t* rowIds, uint32_t numBytes, uint8_t* dst) {
+  if (!isWordAligned(src)) {
+    return 0;
+  }
+  const auto lastSafe = _mm256_set1_epi32(static_cast<int>(rowsInWholeWords((numRows + 7) / 8, 1) * 8) - 1);
+  for (uint32_t byte = 0; byte < numBytes; ++byte) {
+    auto ids = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rowIds + byte * 8));
+    if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(ids, lastSafe))) {
+      gatherBitsScalar(src, rowIds, byte, byte + 1, dst);
+      continue;
+    }
+    auto words = _mm256_i32gather_epi32(reinterpret_cast<const int*>(src), _mm256_srli_epi32(ids, 5), 4);
+    // Move the wanted bit to the sign bit of each lane and collect the signs.
+    auto bits = _mm256_slli_epi32(_mm256_srlv_epi32(words, _mm256_and_si256(ids, _mm256_set1_epi32(31))), 31);
+    dst[byte] = static_cast<uint8_t>(_mm256_movemask_ps(_mm256_castsi256_ps(bits)));
+  }
+  return numBytes;
+}
+
+__attribute__((target("avx512f"))) uint32_t
+gatherAvx512(
+    uint32_t width,
+    const uint8_t* src,
+    uint32_t numRows,
+    const uint32_t* rowIds,
+    uint32_t size,
+    uint8_t* dst) {
+  uint32_t i = 0;
+  switch (width) {
+    case 1: {
+      if (!isWordAligned(src)) {
+        return 0;
+      }
+      const auto safeRows = _mm512_set1_epi32(static_cast<int>(rowsInWholeWords(numRows, 1)));
+      for (; i + 16 <= size; i += 16) {
+        auto ids = _mm512_loadu_si512(rowIds + i);
+        if (_mm512_cmpge_epu32_mask(ids, safeRows)) {
+          gatherScalar<uint8_t>(src, rowIds, i, i + 16, dst);
+          continue;
+        }
+        auto words = _mm512_i32gather_epi32(_mm512_srli_epi32(ids, 2), src, 4);
+        auto values = _mm512_srlv_epi32(words, _mm512_slli_epi32(_mm512_and_si512(ids, _mm512_set1_epi32(3)), 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm512_cvtepi32_epi8(values));
+      }
+      break;
+    }
+    case 2: {
+      if (!isWordAligned(src)) {
+        return 0;
+      }
+      const auto safeRows = _mm512_set1_epi32(static_cast<int>(rowsInWholeWords(uint64_t(numRows) * 2, 2)));
+      for (; i + 16 <= size; i += 16) {
+        auto ids = _mm512_loadu_si512(rowIds + i);
+        if (_mm512_cmpge_epu32_mask(ids, safeRows)) {
+          gatherScalar<uint16_t>(src, rowIds, i, i + 16, dst);
+          continue;
+        }
+        auto words = _mm512_i32gather_epi32(_mm512_srli_epi32(ids, 1), src, 4);
+        auto values = _mm512_srlv_epi32(words, _mm512_slli_epi32(_mm512_and_si512(ids, _mm512_set1_epi32(1)), 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2), _mm512_cvtepi32_epi16(values));
+      }
+      break;
+    }
+    case 4:
+      for (; i + 16 <= size; i += 16) {
+        auto ids = _mm512_loadu_si512(rowIds + i);
+        _mm512_storeu_si512(dst + i * 4, _mm512_i32gather_epi32(ids, src, 4));
+      }
+      break;
+    case 8:
+      for (; i + 8 <= size; i += 8) {
+        auto ids = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rowIds + i));
+        _mm512_storeu_si512(dst + i * 8, _mm512_i32gather_epi64(ids, src, 8));
+      }
+      break;
+    case 16: {
+      const auto halves = _mm256_setr_epi32(0, 1, 0, 1, 0, 1, 0, 1);
+      for (; i + 4 <= size; i += 4) {
+        // Widen 4 row ids to 64-bit lanes holding [a, a], then to [2a, 2a + 1].
+        auto ids = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rowIds + i)));
+        ids = _mm256_or_si256(ids, _mm256_slli_epi64(ids, 32));
+        ids = _mm256_add_epi32(_mm256_slli_epi32(ids, 1), halves);
+        _mm512_storeu_si512(dst + i * 16, _mm512_i32gather_epi64(ids, src, 8));
+      }
+      break;
+    }
+    default:
+      return 0;
+  }
+  return i;
+}
+
+__attribute__((target("avx512f"))) uint32_t
+gatherBitsAvx512(const uint8_t* src, uint32_t numRows, const uint32_t* rowIds, uint32_t numBytes, uint8_t* dst) {
+  if (!isWordAligned(src)) {
+    return 0;
+  }
+  const auto one = _mm512_set1_epi32(1);
+  const auto safeRows = _mm512_set1_epi32(static_cast<int>(rowsInWholeWords((numRows + 7) / 8, 1) * 8));
+  uint32_t byte = 0;
+  for (; byte + 2 <= numBytes; byte += 2) {
+    auto ids = _mm512_loadu_si512(rowIds + byte * 8);
+    if (_mm512_cmpge_epu32_mask(ids, safeRows)) {
+      gatherBitsScalar(src, rowIds, byte, byte + 2, dst);
+      continue;
+    }
+    auto words = _mm512_i32gather_epi32(_mm512_srli_epi32(ids, 5), src, 4);
+    auto bits = _mm512_srlv_epi32(words, _mm512_and_si512(ids, _mm512_set1_epi32(31)));
+    uint16_t mask = _mm512_test_epi32_mask(bits, one);
+    std::memcpy(dst + byte, &mask, sizeof(mask));
+  }
+  return byte;
+}
+
+#endif
+
+} // namespace
+
+SimdLevel detectSimdLevel() {
+#if defined(__x86_64__)
+  if (__builtin_cpu_supports("avx512f")) {
+    return SimdLevel::kAvx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::kAvx2;
+  }
+#endif
+  return SimdLevel::kScalar;
+}
+
+const char* simdLevelName(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::kAvx512:
+      return "avx512";
+    case SimdLevel::kAvx2:
+      return "avx2";
+    default:
+      return "scalar";
+  }
+}
+
+void gatherFixedWidth(
+    SimdLevel level,
+    uint32_t width,
+    const uint8_t* src,
+    uint32_t numRows,
+    const uint32_t* rowIds,
+    uint32_t size,
+    uint8_t* dst) {
+  uint32_t done = 0;
+#if defined(__x86_64__)
+  // Partitions with fewer rows than one vector are common with many reducers, keep them off the SIMD path.
+  if (level == SimdLevel::kAvx512 && size >= 16) {
+    done = gatherAvx512(width, src, numRows, rowIds, size, dst);
+  } else if (level != SimdLevel::kScalar && size >= 8) {
+    done = gatherAvx2(width, src, numRows, rowIds, size, dst);
+  }
+#endif
+  switch (width) {
+    case 1:
+      gatherScalar<uint8_t>(src, rowIds, done, size, dst);
+      break;
+    case 2:
+      gatherScalar<uint16_t>(src, rowIds, done, size, dst);
+      break;
+    case 4:
+      gatherScalar<uint32_t>(src, rowIds, done, size, dst);
+      break;
+    case 8:
+      gatherScalar<uint64_t>(src, rowIds, done, size, dst);
+      break;
+    case 16:
+      gatherScalar<Bytes16>(src, rowIds, done, size, dst);
+      break;
+    default:
+      break;
+  }
+}
+
+void gatherBits(
+    SimdLevel level,
+    const uint8_t* src,
+    uint32_t numRows,
+    const uint32_t* rowIds,
+    uint32_t numBytes,
+    uint8_t* dst) {
+  uint32_t done = 0;
+#if defined(__x86_64__)
+  if (level == SimdLevel::kAvx512 && numBytes >= 2) {
+    done = gatherBitsAvx512(src, numRows, rowIds, numBytes, dst);
+  } else if (level != SimdLevel::kScalar && numBytes >= 1) {
+    done = gatherBitsAvx2(src, numRows, rowIds, numBytes, dst);
+  }
+#endif
+  gatherBitsScalar(src, rowIds, done, numBytes, dst);
+}
+
+} // namespace gluten
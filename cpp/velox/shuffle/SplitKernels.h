@@ -0,0 +1,57 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace gluten {
+
+// Gather kernels used by the shuffle writer to split fixed-width and bitmap buffers into partitions. The SIMD
+// variants are compiled with function-level target attributes and selected at runtime, so the library still runs on
+// CPUs without AVX2.
+enum class SimdLevel { kScalar, kAvx2, kAvx512 };
+
+// The widest instruction set supported by the running CPU.
+SimdLevel detectSimdLevel();
+
+const char* simdLevelName(SimdLevel level);
+
+// dst[i] = src[rowIds[i]] for i in [0, size), elements of 'width' bytes (1, 2, 4, 8 or 16) out of the 'numRows'
+// elements of 'src'. Row ids must be less than 'numRows' and 2^30. The SIMD paths gather elements narrower than 4
+// bytes from the aligned 32-bit word holding them; row ids in the last word, which may extend past the end of 'src',
+// are gathered one by one, so no byte outside of 'src' is read.
+void gatherFixedWidth(
+    SimdLevel level,
+    uint32_t width,
+    const uint8_t* src,
+    uint32_t numRows,
+    const uint32_t* rowIds,
+    uint32_t size,
+    uint8_t* dst);
+
+// Gathers bits rowIds[0 .. numBytes * 8) of the bitmap 'src' of 'numRows' bits into 'numBytes' whole bytes of 'dst'.
+// Like gatherFixedWidth, bits in the last partial word of 'src' are gathered one by one.
+void gatherBits(
+    SimdLevel level,
+    const uint8_t* src,
+    uint32_t numRows,
+    const uint32_t* rowIds,
+    uint32_t numBytes,
+    uint8_t* dst);
+
+} // namespace gluten
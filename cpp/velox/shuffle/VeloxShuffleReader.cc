@@ -25,6 +25,7 @@
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/arrow/Bridge.h"
 
+#include <algorithm>
 #include <iostream>
 
 // using namespace facebook;
@@ -257,6 +258,41 @@ RowVectorPtr readRowVectorInternal(const arrow::RecordBatch& batch, RowTypePtr r
   }
   return deserialize(rowType, length, buffers, pool);
 }
+
+template <TypeKind kind>
+void appendFlatValues(const BaseVector& source, BaseVector& target, vector_size_t offset) {
+  using T = typename TypeTraits<kind>::NativeType;
+  auto numRows = source.size();
+  auto* src = source.asUnchecked<FlatVector<T>>();
+  auto* dst = target.asUnchecked<FlatVector<T>>();
+  if constexpr (std::is_same_v<T, bool>) {
+    bits::copyBits(
+        reinterpret_cast<const uint64_t*>(src->rawValues()),
+        0,
+        reinterpret_cast<uint64_t*>(dst->mutableRawValues()),
+        offset,
+        numRows);
+  } else {
+    memcpy(dst->mutableRawValues() + offset, src->rawValues(), numRows * sizeof(T));
+    if constexpr (std::is_same_v<T, StringView>) {
+      // The copied views point into the source string buffers, share them instead of copying the chars.
+      dst->acquireSharedStringBuffers(src);
+    }
+  }
+}
+
+void appendNulls(const BaseVector& source, BaseVector& target, vector_size_t offset) {
+  auto* targetNulls = target.mutableRawNulls();
+  if (source.rawNulls() != nullptr) {
+    bits::copyBits(source.rawNulls(), 0, targetNulls, offset, source.size());
+  } else {
+    bits::fillBits(targetNulls, offset, offset + source.size(), bits::kNotNull);
+  }
+}
+
+bool isMemcpyAppendable(const BaseVector& vector) {
+  return vector.isFlatEncoding() && vector.type()->isPrimitiveType() && vector.typeKind() != TypeKind::UNKNOWN;
+}
 } // namespace
 
 VeloxShuffleReader::VeloxShuffleReader(
@@ -265,20 +301,114 @@ VeloxShuffleReader::VeloxShuffleReader(
     ReaderOptions options,
     std::shared_ptr<arrow::MemoryPool> pool,
     std::shared_ptr<memory::MemoryPool> veloxPool)
-    : Reader(in, schema, options, pool), veloxPool_(std::move(veloxPool)) {
+    : Reader(in, schema, options, pool),
+      veloxPool_(std::move(veloxPool)),
+      coalesceBatchRows_(options.coalesce_batch_rows),
+      coalesceBatchBytes_(options.coalesce_batch_bytes) {
   ArrowSchema cSchema;
   GLUTEN_THROW_NOT_OK(arrow::ExportSchema(*schema, &cSchema));
   rowType_ = asRowType(importFromArrow(cSchema));
 }
 
 arrow::Result<std::shared_ptr<ColumnarBatch>> VeloxShuffleReader::next() {
+  if (coalesceBatchRows_ <= 0 && coalesceBatchBytes_ <= 0) {
+    ARROW_ASSIGN_OR_RAISE(auto vp, readNextVector());
+    if (vp == nullptr) {
+      return nullptr;
+    }
+    return std::make_shared<VeloxColumnarBatch>(vp);
+  }
+
+  std::vector<RowVectorPtr> vectors;
+  int64_t numRows = 0;
+  int64_t numBytes = 0;
+  while (!reachesCoalesceTarget(numRows, numBytes)) {
+    RowVectorPtr vector;
+    if (pendingVector_ != nullptr) {
+      vector = std::move(pendingVector_);
+    } else {
+      ARROW_ASSIGN_OR_RAISE(vector, readNextVector());
+    }
+    if (vector == nullptr) {
+      break;
+    }
+    auto vectorBytes = static_cast<int64_t>(vector->estimateFlatSize());
+    // Keep a batch that would overshoot the target for the next call, unless it is the first one.
+    if (!vectors.empty() &&
+        ((coalesceBatchRows_ > 0 && numRows + vector->size() > coalesceBatchRows_) ||
+         (coalesceBatchBytes_ > 0 && numBytes + vectorBytes > coalesceBatchBytes_))) {
+      pendingVector_ = std::move(vector);
+      break;
+    }
+    numRows += vector->size();
+    numBytes += vectorBytes;
+    vectors.emplace_back(std::move(vector));
+  }
+
+  if (vectors.empty()) {
+    return nullptr;
+  }
+  if (vectors.size() == 1) {
+    return std::make_shared<VeloxColumnarBatch>(std::move(vectors[0]));
+  }
+  return std::make_shared<VeloxColumnarBatch>(concatenate(vectors, numRows));
+}
+
+arrow::Result<RowVectorPtr> VeloxShuffleReader::readNextVector() {
   ARROW_ASSIGN_OR_RAISE(auto batch, Reader::next());
   if (batch == nullptr) {
     return nullptr;
   }
   auto rb = std::dynamic_pointer_cast<ArrowColumnarBatch>(batch)->getRecordBatch();
-  auto vp = readRowVectorInternal(*rb, rowType_, veloxPool_.get());
-  return std::make_shared<VeloxColumnarBatch>(vp);
+  return readRowVectorInternal(*rb, rowType_, veloxPool_.get());
+}
+
+bool VeloxShuffleReader::reachesCoalesceTarget(int64_t numRows, int64_t numBytes) const {
+  return (coalesceBatchRows_ > 0 && numRows >= coalesceBatchRows_) ||
+      (coalesceBatchBytes_ > 0 && numBytes >= coalesceBatchBytes_);
+}
+
+RowVectorPtr VeloxShuffleReader::concatenate(const std::vector<RowVectorPtr>& vectors, vector_size_t numRows) {
+  // Reuses the buffers of the previous output if the consumer has released it.
+  if (coalescedVector_ != nullptr) {
+    BaseVector::prepareForReuse(coalescedVector_, numRows);
+  } else {
+    coalescedVector_ = BaseVector::create(rowType_, numRows, veloxPool_.get());
+  }
+  auto* result = coalescedVector_->asUnchecked<RowVector>();
+
+  for (column_index_t col = 0; col < rowType_->size(); ++col) {
+    auto& target = result->childAt(col);
+    target->resize(numRows);
+    if (!isMemcpyAppendable(*target)) {
+      vector_size_t offset = 0;
+      for (auto& vector : vectors) {
+        target->copy(vector->childAt(col).get(), offset, 0, vector->size());
+        offset += vector->size();
+      }
+      continue;
+    }
+
+    bool mayHaveNulls = std::any_of(
+        vectors.begin(), vectors.end(), [col](const auto& vector) { return vector->childAt(col)->mayHaveNulls(); });
+    if (!mayHaveNulls) {
+      target->resetNulls();
+    }
+    vector_size_t offset = 0;
+    for (auto& vector : vectors) {
+      const auto& source = vector->childAt(col);
+      if (isMemcpyAppendable(*source)) {
+        if (mayHaveNulls) {
+          appendNulls(*source, *target, offset);
+        }
+        VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(appendFlatValues, source->typeKind(), *source, *target, offset);
+      } else {
+        target->copy(source.get(), offset, 0, source->size());
+      }
+      offset += source->size();
+    }
+  }
+  return std::dynamic_pointer_cast<RowVector>(coalescedVector_);
 }
 
 RowVectorPtr
@@ -40,8 +40,23 @@ class VeloxShuffleReader final : public Reader {
       facebook::velox::memory::MemoryPool* pool);
 
  private:
+  arrow::Result<facebook::velox::RowVectorPtr> readNextVector();
+
+  bool reachesCoalesceTarget(int64_t numRows, int64_t numBytes) const;
+
+  facebook::velox::RowVectorPtr concatenate(
+      const std::vector<facebook::velox::RowVectorPtr>& vectors,
+      facebook::velox::vector_size_t numRows);
+
   facebook::velox::RowTypePtr rowType_;
   std::shared_ptr<facebook::velox::memory::MemoryPool> veloxPool_;
+
+  int32_t coalesceBatchRows_;
+  int64_t coalesceBatchBytes_;
+  // Batch read ahead that did not fit into the previous coalesced batch.
+  facebook::velox::RowVectorPtr pendingVector_;
+  // Last coalesced output, reused once the consumer releases it.
+  facebook::velox::VectorPtr coalescedVector_;
 };
 
 } // namespace gluten
@@ -9,6 +9,7 @@
 #include "utils/macros.h"
 
 #include "arrow/c/bridge.h"
+#include "folly/ScopeGuard.h"
 #include "utils/VeloxArrowUtils.h"
 
 #if defined(__x86_64__)
@@ -200,19 +201,32 @@ arrow::Result<std::shared_ptr<VeloxShuffleWriter>> VeloxShuffleWriter::create(
   return res;
 }
 
-arrow::Status VeloxShuffleWriter::init() {
-#if defined(__x86_64__)
-  supportAvx512_ = __builtin_cpu_supports("avx512bw");
-#else
-  supportAvx512_ = false;
-#endif
+VeloxShuffleWriter::~VeloxShuffleWriter() {
+  // The compression tasks refer to the record batches held by pendingPayloads_.
+  for (auto& pending : pendingPayloads_) {
+    pending.payload.Wait();
+  }
+}
 
-  // partition number should be less than 64k
-  VELOX_CHECK_LE(numPartitions_, 64 * 1024);
+arrow::Status VeloxShuffleWriter::init() {
+  simdLevel_ = detectSimdLevel();
 
   // split record batch size should be less than 32k
   VELOX_CHECK_LE(options_.buffer_size, 32 * 1024);
 
+  sortBased_ = options_.shuffle_writer_type == "sort";
+  if (sortBased_ && options_.prefer_evict) {
+    return arrow::Status::Invalid("Sort-based shuffle writer requires prefer_evict to be false.");
+  }
+
+  if (options_.pipelined_write) {
+    if (!options_.prefer_evict || options_.partition_writer_type != "local") {
+      return arrow::Status::Invalid("Pipelined write requires the prefer-evict local partition writer.");
+    }
+    ARROW_ASSIGN_OR_RAISE(pipelineThreadPool_, pipelineThreadPool());
+    taskThreadId_ = std::this_thread::get_id();
+  }
+
   ARROW_ASSIGN_OR_RAISE(partitionWriter_, partitionWriterCreator_->make(this));
 
   ARROW_ASSIGN_OR_RAISE(partitioner_, Partitioner::make(options_.partitioning_name, numPartitions_));
@@ -228,6 +242,11 @@ arrow::Status VeloxShuffleWriter::init() {
 
   partitionBufferIdxBase_.resize(numPartitions_);
 
+  if (sortBased_) {
+    sortBufferPartition2RowCount_.resize(numPartitions_);
+    sortedPartitionRows_.resize(numPartitions_);
+  }
+
   partitionCachedRecordbatch_.resize(numPartitions_);
   partitionCachedRecordbatchSize_.resize(numPartitions_);
 
@@ -394,23 +413,7 @@ arrow::Status VeloxShuffleWriter::split(std::shared_ptr<ColumnarBatch> cb) {
     VELOX_DCHECK_NOT_NULL(veloxColumnBatch);
     auto& rv = *veloxColumnBatch->getFlattenedRowVector();
     RETURN_NOT_OK(initFromRowVector(rv));
-    std::vector<std::shared_ptr<arrow::Buffer>> buffers;
-    std::vector<VectorPtr> complexChildren;
-    for (auto& child : rv.children()) {
-      if (child->encoding() == VectorEncoding::Simple::FLAT) {
-        VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
-            collectFlatVectorBuffer, child->typeKind(), child.get(), buffers, pool_.get());
-      } else {
-        complexChildren.emplace_back(child);
-      }
-    }
-    if (complexChildren.size() > 0) {
-      auto rowVector = std::make_shared<RowVector>(
-          veloxPool_.get(), complexWriteType_, BufferPtr(nullptr), rv.size(), std::move(complexChildren));
-      buffers.emplace_back(generateComplexTypeBuffers(rowVector));
-    }
-
-    auto rb = makeRecordBatch(rv.size(), buffers, writeSchema(), pool_.get());
+    auto rb = makeRecordBatchFromRowVector(rv);
     RETURN_NOT_OK(cacheRecordBatch(0, *rb, false));
   } else if (options_.partitioning_name == "range") {
     auto compositeBatch = std::dynamic_pointer_cast<CompositeColumnarBatch>(cb);
@@ -423,7 +426,7 @@ arrow::Status VeloxShuffleWriter::split(std::shared_ptr<ColumnarBatch> cb) {
     auto rvBatch = std::dynamic_pointer_cast<VeloxColumnarBatch>(batches[1]);
     auto& rv = *rvBatch->getFlattenedRowVector();
     RETURN_NOT_OK(initFromRowVector(rv));
-    RETURN_NOT_OK(doSplit(rv));
+    RETURN_NOT_OK(sortBased_ ? appendToSortBuffer(rv) : doSplit(rv));
   } else {
     auto veloxColumnBatch = std::dynamic_pointer_cast<VeloxColumnarBatch>(cb);
     VELOX_DCHECK_NOT_NULL(veloxColumnBatch);
@@ -433,17 +436,136 @@ arrow::Status VeloxShuffleWriter::split(std::shared_ptr<ColumnarBatch> cb) {
       RETURN_NOT_OK(partitioner_->compute(pidArr, rv.size(), row2Partition_, partition2RowCount_));
       auto strippedRv = getStrippedRowVector(rv);
       RETURN_NOT_OK(initFromRowVector(*strippedRv));
-      RETURN_NOT_OK(doSplit(*strippedRv));
+      RETURN_NOT_OK(sortBased_ ? appendToSortBuffer(*strippedRv) : doSplit(*strippedRv));
     } else {
       RETURN_NOT_OK(initFromRowVector(rv));
       RETURN_NOT_OK(partitioner_->compute(nullptr, rv.size(), row2Partition_, partition2RowCount_));
-      RETURN_NOT_OK(doSplit(rv));
+      RETURN_NOT_OK(sortBased_ ? appendToSortBuffer(rv) : doSplit(rv));
     }
   }
   return arrow::Status::OK();
 }
 
+std::shared_ptr<arrow::RecordBatch> VeloxShuffleWriter::makeRecordBatchFromRowVector(const velox::RowVector& rv) {
+  std::vector<std::shared_ptr<arrow::Buffer>> buffers;
+  std::vector<VectorPtr> complexChildren;
+  for (auto& child : rv.children()) {
+    if (child->encoding() == VectorEncoding::Simple::FLAT) {
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
+          collectFlatVectorBuffer, child->typeKind(), child.get(), buffers, pool_.get());
+    } else {
+      complexChildren.emplace_back(child);
+    }
+  }
+  if (complexChildren.size() > 0) {
+    auto rowVector = std::make_shared<RowVector>(
+        veloxPool_.get(), complexWriteType_, BufferPtr(nullptr), rv.size(), std::move(complexChildren));
+    buffers.emplace_back(generateComplexTypeBuffers(rowVector));
+  }
+  return makeRecordBatch(rv.size(), buffers, writeSchema(), pool_.get());
+}
+
+arrow::Status VeloxShuffleWriter::appendToSortBuffer(const velox::RowVector& rv) {
+  if (sortBuffer_ == nullptr) {
+    sortBuffer_ = RowVector::createEmpty(rv.type(), veloxPool_.get());
+  }
+  sortBuffer_->append(&rv);
+  // the rows per partition are counted once per sort round, not for each batch over all the partitions
+  sortBufferRow2Partition_.insert(
+      sortBufferRow2Partition_.end(), row2Partition_.begin(), row2Partition_.begin() + rv.size());
+  sortBufferBytes_ = sortBuffer_->retainedSize();
+
+  if (sortBufferBytes_ >= options_.sort_buffer_max_size) {
+    RETURN_NOT_OK(sortAndCacheSortBuffer());
+  }
+  return arrow::Status::OK();
+}
+
+arrow::Status VeloxShuffleWriter::sortAndCacheSortBuffer() {
+  if (sortBuffer_ == nullptr || sortBuffer_->size() == 0) {
+    return arrow::Status::OK();
+  }
+  inSortAndCache_ = true;
+  SCOPE_EXIT {
+    inSortAndCache_ = false;
+  };
+  auto numRows = sortBuffer_->size();
+
+  // counting sort by partition id, rows of one partition keep their input order
+  for (auto pid : sortBufferRow2Partition_) {
+    sortBufferPartition2RowCount_[pid]++;
+  }
+  std::vector<uint32_t> partitionRowOffset(numPartitions_ + 1, 0);
+  for (auto pid = 0; pid < numPartitions_; ++pid) {
+    partitionRowOffset[pid + 1] = partitionRowOffset[pid] + sortBufferPartition2RowCount_[pid];
+  }
+  std::vector<vector_size_t> sortedRowIds(numRows);
+  std::vector<uint32_t> cursor(partitionRowOffset.begin(), std::prev(partitionRowOffset.end()));
+  for (auto row = 0; row < numRows; ++row) {
+    sortedRowIds[cursor[sortBufferRow2Partition_[row]]++] = row;
+  }
+
+  for (auto pid = 0; pid < numPartitions_; ++pid) {
+    auto partitionRows = sortBufferPartition2RowCount_[pid];
+    if (partitionRows == 0) {
+      continue;
+    }
+    auto partitionVector = std::static_pointer_cast<RowVector>(
+        BaseVector::create(sortBuffer_->type(), partitionRows, veloxPool_.get()));
+    SelectivityVector allRows(partitionRows);
+    partitionVector->copy(sortBuffer_.get(), allRows, sortedRowIds.data() + partitionRowOffset[pid]);
+
+    auto& sortedRows = sortedPartitionRows_[pid];
+    if (sortedRows == nullptr) {
+      sortedRows = std::move(partitionVector);
+    } else {
+      sortedPartitionBytes_ -= sortedRows->retainedSize();
+      sortedRows->append(partitionVector.get());
+    }
+    sortedPartitionBytes_ += sortedRows->retainedSize();
+    if (sortedRows->size() >= options_.buffer_size) {
+      RETURN_NOT_OK(cacheSortedPartition(pid));
+    }
+  }
+
+  sortBuffer_ = nullptr;
+  sortBufferRow2Partition_.clear();
+  std::fill(sortBufferPartition2RowCount_.begin(), sortBufferPartition2RowCount_.end(), 0);
+  sortBufferBytes_ = 0;
+
+  if (sortedPartitionBytes_ >= options_.sort_buffer_max_size) {
+    RETURN_NOT_OK(cacheSortedPartitions());
+  }
+  return arrow::Status::OK();
+}
+
+arrow::Status VeloxShuffleWriter::cacheSortedPartition(uint32_t partitionId) {
+  auto& sortedRows = sortedPartitionRows_[partitionId];
+  if (sortedRows == nullptr) {
+    return arrow::Status::OK();
+  }
+  sortedPartitionBytes_ -= sortedRows->retainedSize();
+  auto rb = makeRecordBatchFromRowVector(*sortedRows);
+  sortedRows = nullptr;
+  return cacheRecordBatch(partitionId, *rb, false);
+}
+
+arrow::Status VeloxShuffleWriter::cacheSortedPartitions() {
+  for (auto pid = 0; pid < numPartitions_; ++pid) {
+    RETURN_NOT_OK(cacheSortedPartition(pid));
+  }
+  return arrow::Status::OK();
+}
+
 arrow::Status VeloxShuffleWriter::stop() {
+  if (sortBased_) {
+    RETURN_NOT_OK(sortAndCacheSortBuffer());
+    RETURN_NOT_OK(cacheSortedPartitions());
+  }
+  if (options_.pipelined_write) {
+    // the last payloads stay cached, stop() writes them straight to the data file instead of through the spilled file
+    RETURN_NOT_OK(collectPendingPayloads(true, false));
+  }
   EVAL_START("write", options_.thread_id)
   RETURN_NOT_OK(partitionWriter_->stop());
   EVAL_END("write", options_.thread_id, options_.task_attempt_id)
@@ -513,7 +635,14 @@ arrow::Status VeloxShuffleWriter::doSplit(const velox::RowVector& rv) {
         auto newSize = std::max(calculatePartitionBufferSize(rv), partition2RowCount_[pid]);
         // if the size to be filled + allready filled > the buffer size, need to free current buffers and allocate new
         // buffer
-        if (newSize > partition2BufferSize_[pid]) {
+        if (options_.pipelined_write) {
+          // compress the filled buffers in background and split into new buffers meanwhile
+          ARROW_ASSIGN_OR_RAISE(auto rb, createArrowRecordBatchFromBuffer(pid, /*resetBuffers = */ true));
+          if (rb) {
+            RETURN_NOT_OK(compressRecordBatchAsync(pid, std::move(rb)));
+          }
+          RETURN_NOT_OK(allocatePartitionBuffersWithRetry(pid, newSize));
+        } else if (newSize > partition2BufferSize_[pid]) {
           // if the partition size after split is already larger than
           // allocated buffer size, need reallocate
           {
@@ -560,6 +689,10 @@ arrow::Status VeloxShuffleWriter::doSplit(const velox::RowVector& rv) {
 
   printPartitionBuffer();
 
+  if (options_.pipelined_write) {
+    RETURN_NOT_OK(collectPendingPayloads(false));
+  }
+
   return arrow::Status::OK();
 }
 
@@ -583,94 +716,36 @@ arrow::Status VeloxShuffleWriter::splitFixedWidthValueBuffer(const velox::RowVec
 
     switch (arrow::bit_width(arrowColumnTypes_[colIdx]->id())) {
       case 1: // arrow::BooleanType::type_id:
-        RETURN_NOT_OK(splitBoolType(srcAddr, dstAddrs));
+        RETURN_NOT_OK(splitBoolType(srcAddr, rv.size(), dstAddrs));
         break;
       case 8:
-        RETURN_NOT_OK(splitFixedType<uint8_t>(srcAddr, dstAddrs));
+        RETURN_NOT_OK(splitFixedType<uint8_t>(srcAddr, rv.size(), dstAddrs));
         break;
       case 16:
-        RETURN_NOT_OK(splitFixedType<uint16_t>(srcAddr, dstAddrs));
+        RETURN_NOT_OK(splitFixedType<uint16_t>(srcAddr, rv.size(), dstAddrs));
         break;
       case 32:
-        RETURN_NOT_OK(splitFixedType<uint32_t>(srcAddr, dstAddrs));
+        RETURN_NOT_OK(splitFixedType<uint32_t>(srcAddr, rv.size(), dstAddrs));
         break;
       case 64: {
         if (column->type()->kind() == velox::TypeKind::TIMESTAMP) {
-          RETURN_NOT_OK(splitFixedType<int128_t>(srcAddr, dstAddrs));
+          RETURN_NOT_OK(splitFixedType<int128_t>(srcAddr, rv.size(), dstAddrs));
           break;
         } else {
-#ifdef PROCESSAVX
-          std::transform(
-              dstAddrs.begin(),
-              dstAddrs.end(),
-              partitionBufferIdxBase_.begin(),
-              partitionBufferIdxOffset_.begin(),
-              [](uint8_t* x, row_offset_type y) { return x + y * sizeof(uint64_t); });
-          for (auto pid = 0; pid < numPartitions_; pid++) {
-            auto dstPidBase = reinterpret_cast<uint64_t*>(partitionBufferIdxOffset_[pid]); /*32k*/
-            auto r = partition2RowOffset_[pid]; /*8k*/
-            auto size = partition2RowOffset_[pid + 1];
-#if 1
-            for (r; r < size && (((uint64_t)dstPidBase & 0x1f) > 0); r++) {
-              auto srcOffset = rowOffset2RowId_[r]; /*16k*/
-              *dstPidBase = reinterpret_cast<uint64_t*>(srcAddr)[srcOffset]; /*64k*/
-              _mm_prefetch(&(srcAddr)[srcOffset * sizeof(uint64_t) + 64], _MM_HINT_T2);
-              dstPidBase += 1;
-            }
-#if 0
-          for (r; r+4<size; r+=4)                              
-          {                                                                                    
-            auto srcOffset = rowOffset2RowId_[r];                                 /*16k*/
-            __m128i srcLd = _mm_loadl_epi64((__m128i*)(&rowOffset2RowId_[r]));
-            __m128i srcOffset4x = _mm_cvtepu16_epi32(srcLd);
-            
-            __m256i src4x = _mm256_i32gather_epi64((const long long int*)srcAddr,srcOffset4x,8);
-            //_mm256_store_si256((__m256i*)dstPidBase,src4x);
-            _mm_stream_si128((__m128i*)dstPidBase,src2x);
-                                                         
-            _mm_prefetch(&(srcAddr)[(uint32_t)rowOffset2RowId_[r]*sizeof(uint64_t)+64], _MM_HINT_T2);
-            _mm_prefetch(&(srcAddr)[(uint32_t)rowOffset2RowId_[r+1]*sizeof(uint64_t)+64], _MM_HINT_T2);
-            _mm_prefetch(&(srcAddr)[(uint32_t)rowOffset2RowId_[r+2]*sizeof(uint64_t)+64], _MM_HINT_T2);
-            _mm_prefetch(&(srcAddr)[(uint32_t)rowOffset2RowId_[r+3]*sizeof(uint64_t)+64], _MM_HINT_T2);
-            dstPidBase+=4;
-          }
-#endif
-            for (r; r + 2 < size; r += 2) {
-              __m128i srcOffset2x = _mm_cvtsi32_si128(*((int32_t*)(rowOffset2RowId_.data() + r)));
-              srcOffset2x = _mm_shufflelo_epi16(srcOffset2x, 0x98);
-
-              __m128i src2x = _mm_i32gather_epi64((const long long int*)srcAddr, srcOffset2x, 8);
-              _mm_store_si128((__m128i*)dstPidBase, src2x);
-              //_mm_stream_si128((__m128i*)dstPidBase,src2x);
-
-              _mm_prefetch(&(srcAddr)[(uint32_t)rowOffset2RowId_[r] * sizeof(uint64_t) + 64], _MM_HINT_T2);
-              _mm_prefetch(&(srcAddr)[(uint32_t)rowOffset2RowId_[r + 1] * sizeof(uint64_t) + 64], _MM_HINT_T2);
-              dstPidBase += 2;
-            }
-#endif
-            for (r; r < size; r++) {
-              auto srcOffset = rowOffset2RowId_[r]; /*16k*/
-              *dstPidBase = reinterpret_cast<const uint64_t*>(srcAddr)[srcOffset]; /*64k*/
-              _mm_prefetch(&(srcAddr)[srcOffset * sizeof(uint64_t) + 64], _MM_HINT_T2);
-              dstPidBase += 1;
-            }
-            break;
-#else
-          RETURN_NOT_OK(splitFixedType<uint64_t>(srcAddr, dstAddrs));
-#endif
-            break;
-          }
+          RETURN_NOT_OK(splitFixedType<uint64_t>(srcAddr, rv.size(), dstAddrs));
+          break;
         }
+      }
 
         case 128: // arrow::Decimal128Type::type_id
           // too bad gcc generates movdqa even we use __m128i_u data type.
           // splitFixedType<__m128i_u>(srcAddr, dstAddrs);
           {
             if (column->type()->isShortDecimal()) {
-              RETURN_NOT_OK(splitFixedType<int64_t>(srcAddr, dstAddrs));
+              RETURN_NOT_OK(splitFixedType<int64_t>(srcAddr, rv.size(), dstAddrs));
             } else if (column->type()->isLongDecimal()) {
               // assume batch size = 32k; reducer# = 4K; row/reducer = 8
-              RETURN_NOT_OK(splitFixedType<int128_t>(srcAddr, dstAddrs));
+              RETURN_NOT_OK(splitFixedType<int128_t>(srcAddr, rv.size(), dstAddrs));
             } else {
               return arrow::Status::Invalid(
                   "Column type " + schema_->field(colIdx)->type()->ToString() + " is not supported.");
@@ -686,7 +761,10 @@ arrow::Status VeloxShuffleWriter::splitFixedWidthValueBuffer(const velox::RowVec
     return arrow::Status::OK();
   }
 
-  arrow::Status VeloxShuffleWriter::splitBoolType(const uint8_t* srcAddr, const std::vector<uint8_t*>& dstAddrs) {
+  arrow::Status VeloxShuffleWriter::splitBoolType(
+      const uint8_t* srcAddr,
+      uint32_t numRows,
+      const std::vector<uint8_t*>& dstAddrs) {
     // assume batch size = 32k; reducer# = 4K; row/reducer = 8
     for (auto pid = 0; pid < numPartitions_; ++pid) {
       // set the last byte
@@ -717,46 +795,12 @@ arrow::Status VeloxShuffleWriter::splitFixedWidthValueBuffer(const velox::RowVec
           continue;
         }
         dstOffset += dstOffsetInByte;
-        // now dst_offset is 8 aligned
-        for (; r + 8 < size; r += 8) {
-          uint8_t src = 0;
-          auto srcOffset = rowOffset2RowId_[r]; /*16k*/
-          src = srcAddr[srcOffset >> 3];
-          // PREFETCHT0((&(srcAddr)[(srcOffset >> 3) + 64]));
-          dst = src >> (srcOffset & 7) | 0xfe; // get the bit in bit 0, other bits set to 1
-
-          srcOffset = rowOffset2RowId_[r + 1]; /*16k*/
-          src = srcAddr[srcOffset >> 3];
-          dst &= src >> (srcOffset & 7) << 1 | 0xfd; // get the bit in bit 0, other bits set to 1
-
-          srcOffset = rowOffset2RowId_[r + 2]; /*16k*/
-          src = srcAddr[srcOffset >> 3];
-          dst &= src >> (srcOffset & 7) << 2 | 0xfb; // get the bit in bit 0, other bits set to 1
-
-          srcOffset = rowOffset2RowId_[r + 3]; /*16k*/
-          src = srcAddr[srcOffset >> 3];
-          dst &= src >> (srcOffset & 7) << 3 | 0xf7; // get the bit in bit 0, other bits set to 1
-
-          srcOffset = rowOffset2RowId_[r + 4]; /*16k*/
-          src = srcAddr[srcOffset >> 3];
-          dst &= src >> (srcOffset & 7) << 4 | 0xef; // get the bit in bit 0, other bits set to 1
-
-          srcOffset = rowOffset2RowId_[r + 5]; /*16k*/
-          src = srcAddr[srcOffset >> 3];
-          dst &= src >> (srcOffset & 7) << 5 | 0xdf; // get the bit in bit 0, other bits set to 1
-
-          srcOffset = rowOffset2RowId_[r + 6]; /*16k*/
-          src = srcAddr[srcOffset >> 3];
-          dst &= src >> (srcOffset & 7) << 6 | 0xbf; // get the bit in bit 0, other bits set to 1
-
-          srcOffset = rowOffset2RowId_[r + 7]; /*16k*/
-          src = srcAddr[srcOffset >> 3];
-          dst &= src >> (srcOffset & 7) << 7 | 0x7f; // get the bit in bit 0, other bits set to 1
-
-          dstaddr[dstOffset >> 3] = dst;
-          dstOffset += 8;
-          //_mm_prefetch(dstaddr + (dst_offset >> 3) + 64, _MM_HINT_T0);
-        }
+        // now dst_offset is 8 aligned, gather the whole bytes before the last one
+        auto numBytes = (size - r - 1) / 8;
+        gatherBits(
+            simdLevel_, srcAddr, numRows, rowOffset2RowId_.data() + r, numBytes, dstaddr + (dstOffset >> 3));
+        r += numBytes * 8;
+        dstOffset += numBytes * 8;
         // last byte, set it to 0xff is ok
         dst = 0xff;
         dstIdxByte = 0;
@@ -797,7 +841,7 @@ arrow::Status VeloxShuffleWriter::splitFixedWidthValueBuffer(const velox::RowVec
         }
 
         auto srcAddr = (const uint8_t*)(column->mutableRawNulls());
-        RETURN_NOT_OK(splitBoolType(srcAddr, dstAddrs));
+        RETURN_NOT_OK(splitBoolType(srcAddr, rv.size(), dstAddrs));
       } else {
         VsPrintLF(colIdx, " column hasn't null");
       }
@@ -971,7 +1015,9 @@ arrow::Status VeloxShuffleWriter::splitFixedWidthValueBuffer(const velox::RowVec
   arrow::Status VeloxShuffleWriter::initFromRowVector(const velox::RowVector& rv) {
     if (veloxColumnTypes_.empty()) {
       RETURN_NOT_OK(initColumnTypes(rv));
-      RETURN_NOT_OK(initPartitions());
+      if (!sortBased_) {
+        RETURN_NOT_OK(initPartitions());
+      }
     }
     return arrow::Status::OK();
   }
@@ -1128,6 +1174,15 @@ arrow::Status VeloxShuffleWriter::splitFixedWidthValueBuffer(const velox::RowVec
 
   arrow::Result<std::shared_ptr<arrow::ipc::IpcPayload>> VeloxShuffleWriter::createArrowIpcPayload(
       const arrow::RecordBatch& rb, bool reuseBuffers) {
+    int64_t compressTime = 0;
+    ARROW_ASSIGN_OR_RAISE(auto payload, createArrowIpcPayload(rb, reuseBuffers, compressTime));
+    totalCompressTime_ += compressTime;
+    totalCompressWallTime_ += compressTime;
+    return payload;
+  }
+
+  arrow::Result<std::shared_ptr<arrow::ipc::IpcPayload>> VeloxShuffleWriter::createArrowIpcPayload(
+      const arrow::RecordBatch& rb, bool reuseBuffers, int64_t& compressTime) {
     auto payload = std::make_shared<arrow::ipc::IpcPayload>();
 #ifndef SKIPCOMPRESS
     // Extract numRows from header column
@@ -1138,10 +1193,10 @@ arrow::Status VeloxShuffleWriter::splitFixedWidthValueBuffer(const velox::RowVec
 #endif
     if (isTinyBatch) {
       TIME_NANO_OR_RAISE(
-          totalCompressTime_, arrow::ipc::GetRecordBatchPayload(rb, tinyBatchWriteOptions_, payload.get()));
+          compressTime, arrow::ipc::GetRecordBatchPayload(rb, tinyBatchWriteOptions_, payload.get()));
     } else {
       TIME_NANO_OR_RAISE(
-          totalCompressTime_, arrow::ipc::GetRecordBatchPayload(rb, options_.ipc_write_options, payload.get()));
+          compressTime, arrow::ipc::GetRecordBatchPayload(rb, options_.ipc_write_options, payload.get()));
     }
     if (isTinyBatch || options_.ipc_write_options.codec == nullptr) {
       // Without compression, we need to perform a manual copy of the original buffers
@@ -1310,7 +1365,61 @@ arrow::Status VeloxShuffleWriter::splitFixedWidthValueBuffer(const velox::RowVec
     return arrow::Status::OK();
   }
 
+  arrow::Status VeloxShuffleWriter::compressRecordBatchAsync(
+      uint32_t partitionId, std::shared_ptr<arrow::RecordBatch> rb) {
+    auto rawSize = getBatchNbytes(*rb);
+    rawPartitionLengths_[partitionId] += rawSize;
+    partitionBufferIdxBase_[partitionId] = 0;
+
+    // backpressure, bound the bytes in flight by the memory budget of the task
+    while (!pendingPayloads_.empty() && pendingPayloadBytes_ + rawSize > pipelineMaxPendingBytes()) {
+      TIME_NANO(totalCompressWallTime_, pendingPayloads_.front().payload.Wait());
+      RETURN_NOT_OK(collectPendingPayloads(false));
+    }
+
+    auto rbPtr = rb.get();
+    ARROW_ASSIGN_OR_RAISE(
+        auto future,
+        pipelineThreadPool_->Submit([this, rbPtr]() -> arrow::Result<std::shared_ptr<arrow::ipc::IpcPayload>> {
+          int64_t compressTime = 0;
+          ARROW_ASSIGN_OR_RAISE(auto payload, createArrowIpcPayload(*rbPtr, false, compressTime));
+          pipelinedCompressTime_ += compressTime;
+          return payload;
+        }));
+    pendingPayloadBytes_ += rawSize;
+    pendingPayloads_.push_back({partitionId, std::move(rb), rawSize, std::move(future)});
+    return arrow::Status::OK();
+  }
+
+  arrow::Status VeloxShuffleWriter::collectPendingPayloads(bool wait, bool evict) {
+    while (!pendingPayloads_.empty()) {
+      auto& pending = pendingPayloads_.front();
+      if (!wait && !pending.payload.is_finished()) {
+        break;
+      }
+      TIME_NANO(totalCompressWallTime_, pending.payload.Wait());
+      ARROW_ASSIGN_OR_RAISE(auto payload, pending.payload.result());
+      auto partitionId = pending.partitionId;
+      pendingPayloadBytes_ -= pending.rawSize;
+      pendingPayloads_.pop_front();
+
+      partitionCachedRecordbatchSize_[partitionId] += payload->body_length;
+      partitionCachedRecordbatch_[partitionId].push_back(std::move(payload));
+      if (evict) {
+        RETURN_NOT_OK(evictPartition(partitionId));
+      }
+    }
+    totalCompressTime_ += pipelinedCompressTime_.exchange(0);
+    return arrow::Status::OK();
+  }
+
   arrow::Status VeloxShuffleWriter::evictFixedSize(int64_t size, int64_t * actual) {
+    if (options_.pipelined_write && std::this_thread::get_id() != taskThreadId_) {
+      // Spill requested from another thread, e.g. by an allocation in a pipeline thread. The split state belongs to
+      // the task thread, only the payloads being written can be released here once their writes finish.
+      ARROW_ASSIGN_OR_RAISE(*actual, partitionWriter_->releasePendingWrites());
+      return arrow::Status::OK();
+    }
     int64_t currentEvicted = 0L;
     auto tryCount = 0;
     while (currentEvicted < size && tryCount < 5) {
@@ -1327,7 +1436,22 @@ arrow::Status VeloxShuffleWriter::splitFixedWidthValueBuffer(const velox::RowVec
   }
 
   arrow::Status VeloxShuffleWriter::evictPartitionsOnDemand(int64_t * size) {
-    if (options_.prefer_evict) {
+    if (options_.pipelined_write) {
+      RETURN_NOT_OK(collectPendingPayloads(true));
+    }
+    if (sortBased_) {
+      // Sort and cache the buffered and the merged rows, then spill all cached partitions into one file.
+      int64_t sortBufferBytes = inSortAndCache_ ? 0 : sortBufferBytes_ + sortedPartitionBytes_;
+      if (!inSortAndCache_) {
+        RETURN_NOT_OK(sortAndCacheSortBuffer());
+        RETURN_NOT_OK(cacheSortedPartitions());
+      }
+      int64_t totalCachedSize = totalCachedPayloadSize();
+      if (totalCachedSize > 0) {
+        RETURN_NOT_OK(evictPartition(-1));
+      }
+      *size = sortBufferBytes + totalCachedSize;
+    } else if (options_.prefer_evict) {
       // evict the largest partition
       auto maxSize = 0;
       int32_t partitionToEvict = -1;
@@ -18,8 +18,11 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "velox/serializers/PrestoSerializer.h"
@@ -38,6 +41,7 @@
 #include <arrow/type_traits.h>
 #include <arrow/util/bit_util.h>
 #include <arrow/util/checked_cast.h>
+#include <arrow/util/future.h>
 #include "arrow/array/builder_base.h"
 
 #include "arrow/array/util.h"
@@ -47,6 +51,7 @@
 #include "shuffle/PartitionWriterCreator.h"
 #include "shuffle/Partitioner.h"
 #include "shuffle/ShuffleWriter.h"
+#include "shuffle/SplitKernels.h"
 #include "shuffle/utils.h"
 
 #include "utils/Print.h"
@@ -117,6 +122,8 @@ class VeloxShuffleWriter final : public ShuffleWriter {
       std::shared_ptr<PartitionWriterCreator> partitionWriterCreator,
       ShuffleWriterOptions options);
 
+  ~VeloxShuffleWriter() override;
+
   arrow::Status split(std::shared_ptr<ColumnarBatch> cb) override;
 
   arrow::Status stop() override;
@@ -228,9 +235,19 @@ class VeloxShuffleWriter final : public ShuffleWriter {
 
   arrow::Status cacheRecordBatch(uint32_t partitionId, const arrow::RecordBatch& rb, bool reuseBuffers);
 
+  arrow::Result<std::shared_ptr<arrow::ipc::IpcPayload>>
+  createArrowIpcPayload(const arrow::RecordBatch& rb, bool reuseBuffers, int64_t& compressTime);
+
+  // pipelined write
+  arrow::Status compressRecordBatchAsync(uint32_t partitionId, std::shared_ptr<arrow::RecordBatch> rb);
+
+  // Cache and evict the compressed payloads in submission order. If wait is false, stop at the first payload that is
+  // not compressed yet.
+  arrow::Status collectPendingPayloads(bool wait, bool evict = true);
+
   arrow::Status splitFixedWidthValueBuffer(const facebook::velox::RowVector& rv);
 
-  arrow::Status splitBoolType(const uint8_t* srcAddr, const std::vector<uint8_t*>& dstAddrs);
+  arrow::Status splitBoolType(const uint8_t* srcAddr, uint32_t numRows, const std::vector<uint8_t*>& dstAddrs);
 
   arrow::Status splitValidityBuffer(const facebook::velox::RowVector& rv);
 
@@ -239,7 +256,7 @@ class VeloxShuffleWriter final : public ShuffleWriter {
   arrow::Status splitComplexType(const facebook::velox::RowVector& rv);
 
   template <typename T>
-  arrow::Status splitFixedType(const uint8_t* srcAddr, const std::vector<uint8_t*>& dstAddrs) {
+  arrow::Status splitFixedType(const uint8_t* srcAddr, uint32_t numRows, const std::vector<uint8_t*>& dstAddrs) {
     std::transform(
         dstAddrs.begin(),
         dstAddrs.end(),
@@ -248,12 +265,17 @@ class VeloxShuffleWriter final : public ShuffleWriter {
         [](uint8_t* x, uint32_t y) { return x + y * sizeof(T); });
 
     for (uint32_t pid = 0; pid < numPartitions_; ++pid) {
-      auto dstPidBase = reinterpret_cast<T*>(partitionBufferIdxOffset_[pid]);
       auto pos = partition2RowOffset_[pid];
       auto end = partition2RowOffset_[pid + 1];
-      for (; pos < end; ++pos) {
-        auto rowId = rowOffset2RowId_[pos];
-        *dstPidBase++ = reinterpret_cast<const T*>(srcAddr)[rowId]; // copy
+      if (pos < end) {
+        gatherFixedWidth(
+            simdLevel_,
+            sizeof(T),
+            srcAddr,
+            numRows,
+            rowOffset2RowId_.data() + pos,
+            end - pos,
+            partitionBufferIdxOffset_[pid]);
       }
     }
     return arrow::Status::OK();
@@ -270,10 +292,21 @@ class VeloxShuffleWriter final : public ShuffleWriter {
 
   std::shared_ptr<arrow::Buffer> generateComplexTypeBuffers(facebook::velox::RowVectorPtr vector);
 
+  std::shared_ptr<arrow::RecordBatch> makeRecordBatchFromRowVector(const facebook::velox::RowVector& rv);
+
+  // sort-based shuffle
+  arrow::Status appendToSortBuffer(const facebook::velox::RowVector& rv);
+
+  arrow::Status sortAndCacheSortBuffer();
+
+  arrow::Status cacheSortedPartition(uint32_t partitionId);
+
+  arrow::Status cacheSortedPartitions();
+
  protected:
   arrow::Status resetValidityBuffers(uint32_t partitionId);
 
-  bool supportAvx512_ = false;
+  SimdLevel simdLevel_ = SimdLevel::kScalar;
 
   // store arrow column types
   std::vector<std::shared_ptr<arrow::DataType>> arrowColumnTypes_; // column_type_id_
@@ -287,8 +320,8 @@ class VeloxShuffleWriter final : public ShuffleWriter {
   // Row ID -> Partition ID
   // subscript: Row ID
   // value: Partition ID
-  // TODO: rethink, is uint16_t better?
-  std::vector<uint16_t> row2Partition_; // note: partition_id_
+  // 32-bit so that more than 65535 partitions are supported
+  std::vector<uint32_t> row2Partition_; // note: partition_id_
 
   // Partition ID -> Row Count
   // subscript: Partition ID
@@ -349,6 +382,42 @@ class VeloxShuffleWriter final : public ShuffleWriter {
   std::unique_ptr<facebook::velox::serializer::presto::PrestoVectorSerde> serde_ =
       std::make_unique<facebook::velox::serializer::presto::PrestoVectorSerde>();
 
+  bool sortBased_ = false;
+
+  // rows appended in the sort mode, moved to sortedPartitionRows_ after sorting by partition id
+  facebook::velox::RowVectorPtr sortBuffer_;
+
+  // sorted rows of each partition merged across sort rounds, cached as a record batch once they reach buffer_size
+  // rows, or when sortedPartitionBytes_ exceeds sort_buffer_max_size, so that partitions with few rows per round don't
+  // produce tiny batches
+  std::vector<facebook::velox::RowVectorPtr> sortedPartitionRows_;
+
+  int64_t sortedPartitionBytes_ = 0;
+
+  // Row ID in sortBuffer_ -> Partition ID
+  std::vector<uint32_t> sortBufferRow2Partition_;
+
+  // Partition ID -> Row Count in sortBuffer_
+  std::vector<uint32_t> sortBufferPartition2RowCount_;
+
+  int64_t sortBufferBytes_ = 0;
+
+  bool inSortAndCache_ = false;
+
+  struct PendingPayload {
+    uint32_t partitionId;
+    std::shared_ptr<arrow::RecordBatch> rb;
+    int64_t rawSize;
+    arrow::Future<std::shared_ptr<arrow::ipc::IpcPayload>> payload;
+  };
+
+  // record batches being compressed in pipelineThreadPool_, in submission order
+  std::deque<PendingPayload> pendingPayloads_;
+  int64_t pendingPayloadBytes_ = 0;
+  std::atomic<int64_t> pipelinedCompressTime_{0};
+  arrow::internal::ThreadPool* pipelineThreadPool_ = nullptr;
+  std::thread::id taskThreadId_;
+
 }; // class VeloxShuffleWriter
 
 } // namespace gluten
@@ -0,0 +1,111 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shuffle/SplitKernels.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace gluten {
+
+class SplitKernelsTest : public ::testing::Test {
+ protected:
+  // Source sizes that leave 0 to 3 bytes in the last 32-bit word of 1-byte, 2-byte and bitmap sources. The buffers
+  // are allocated with exactly the size of the source, so that ASan reports any read past their end.
+  static constexpr uint32_t kNumRows[] = {1000, 1001, 1002, 1003, 1025};
+
+  std::vector<SimdLevel> supportedLevels() {
+    std::vector<SimdLevel> levels{SimdLevel::kScalar};
+    auto detected = detectSimdLevel();
+    if (detected == SimdLevel::kAvx2 || detected == SimdLevel::kAvx512) {
+      levels.push_back(SimdLevel::kAvx2);
+    }
+    if (detected == SimdLevel::kAvx512) {
+      levels.push_back(SimdLevel::kAvx512);
+    }
+    return levels;
+  }
+
+  // Random row ids, with the last rows of the source at the start and the end to exercise the partial last word.
+  std::vector<uint32_t> randomRowIds(uint32_t numRows, uint32_t size) {
+    std::vector<uint32_t> rowIds(size);
+    for (auto& rowId : rowIds) {
+      rowId = rng_() % numRows;
+    }
+    for (uint32_t i = 0; i < std::min(size, 4u); ++i) {
+      rowIds[i] = numRows - 1 - i;
+      rowIds[size - 1 - i] = numRows - 1 - i;
+    }
+    return rowIds;
+  }
+
+  std::mt19937 rng_{42};
+};
+
+TEST_F(SplitKernelsTest, gatherFixedWidth) {
+  for (uint32_t numRows : kNumRows) {
+    for (uint32_t width : {1, 2, 4, 8, 16}) {
+      std::unique_ptr<uint8_t[]> src(new uint8_t[numRows * width]);
+      for (uint32_t i = 0; i < numRows * width; ++i) {
+        src[i] = rng_();
+      }
+      // Sizes around the vector lengths of every instruction set.
+      for (uint32_t size : {0, 1, 7, 8, 9, 15, 16, 17, 100, 1000}) {
+        auto rowIds = randomRowIds(numRows, size);
+        for (auto level : supportedLevels()) {
+          std::vector<uint8_t> dst(size * width);
+          gatherFixedWidth(level, width, src.get(), numRows, rowIds.data(), size, dst.data());
+          for (uint32_t i = 0; i < size; ++i) {
+            ASSERT_EQ(std::memcmp(dst.data() + i * width, src.get() + rowIds[i] * width, width), 0)
+                << "rows " << numRows << ", width " << width << ", size " << size << ", level "
+                << simdLevelName(level) << ", row " << i;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_F(SplitKernelsTest, gatherBits) {
+  for (uint32_t numRows : kNumRows) {
+    const uint32_t srcBytes = (numRows + 7) / 8;
+    std::unique_ptr<uint8_t[]> src(new uint8_t[srcBytes]);
+    for (uint32_t i = 0; i < srcBytes; ++i) {
+      src[i] = rng_();
+    }
+    for (uint32_t numBytes : {0, 1, 2, 3, 17}) {
+      auto rowIds = randomRowIds(numRows, numBytes * 8);
+      for (auto level : supportedLevels()) {
+        std::vector<uint8_t> dst(numBytes);
+        gatherBits(level, src.get(), numRows, rowIds.data(), numBytes, dst.data());
+        for (uint32_t i = 0; i < numBytes * 8; ++i) {
+          bool expected = (src[rowIds[i] >> 3] >> (rowIds[i] & 7)) & 1;
+          bool actual = (dst[i >> 3] >> (i & 7)) & 1;
+          ASSERT_EQ(actual, expected) << "rows " << numRows << ", bytes " << numBytes << ", level "
+                                      << simdLevelName(level) << ", row " << i;
+        }
+      }
+    }
+  }
+}
+
+} // namespace gluten
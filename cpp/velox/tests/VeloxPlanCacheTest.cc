@@ -0,0 +1,190 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "compute/VeloxPlanCache.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+namespace {
+
+// A plan reading the given files, filtered by a condition on column `filterColumn`.
+::substrait::Plan makePlan(const std::vector<std::string>& paths, int32_t filterColumn) {
+  ::substrait::Plan plan;
+  auto* filter = plan.add_relations()->mutable_root()->mutable_input()->mutable_filter();
+  filter->mutable_condition()->mutable_selection()->mutable_direct_reference()->mutable_struct_field()->set_field(
+      filterColumn);
+  auto* localFiles = filter->mutable_input()->mutable_read()->mutable_local_files();
+  for (size_t i = 0; i < paths.size(); ++i) {
+    auto* file = localFiles->add_items();
+    file->set_uri_file(paths[i]);
+    file->set_start(0);
+    file->set_length(100 * (i + 1));
+    file->mutable_parquet();
+  }
+  return plan;
+}
+
+// Stands in for a converted plan; the cache only looks at the plan node ids it was given along with the splits.
+std::shared_ptr<const core::PlanNode> makeVeloxPlan(const core::PlanNodeId& id) {
+  return std::make_shared<core::ValuesNode>(id, std::vector<RowVectorPtr>{});
+}
+
+// The split infos VeloxPlanConverter produces for the plan, with the scan node given the id `scanId`.
+SplitInfoMap convertedSplits(const VeloxPlanCache::Key& key, const core::PlanNodeId& scanId) {
+  SplitInfoMap splitInfos;
+  splitInfos[scanId] = std::make_shared<substrait::SplitInfo>(*key.splitInfos[0]);
+  return splitInfos;
+}
+
+} // namespace
+
+class VeloxPlanCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Clears any plan cached by an earlier test.
+    cache_.setCapacity(0);
+    cache_.setCapacity(2);
+    hits_ = cache_.hits();
+    misses_ = cache_.misses();
+  }
+
+  void TearDown() override {
+    cache_.setCapacity(0);
+  }
+
+  int64_t newHits() const {
+    return cache_.hits() - hits_;
+  }
+
+  int64_t newMisses() const {
+    return cache_.misses() - misses_;
+  }
+
+  VeloxPlanCache& cache_ = VeloxPlanCache::get();
+  int64_t hits_;
+  int64_t misses_;
+};
+
+TEST_F(VeloxPlanCacheTest, missThenHit) {
+  auto key = VeloxPlanCache::makeKey(makePlan({"file:///a.parquet"}, 0));
+  SplitInfoMap splitInfos;
+  ASSERT_EQ(cache_.lookup(key, splitInfos), nullptr);
+  ASSERT_TRUE(splitInfos.empty());
+  ASSERT_EQ(newMisses(), 1);
+  ASSERT_EQ(newHits(), 0);
+
+  auto plan = makeVeloxPlan("0");
+  cache_.insert(key, plan, convertedSplits(key, "1"));
+
+  ASSERT_EQ(cache_.lookup(key, splitInfos), plan);
+  ASSERT_EQ(splitInfos.size(), 1);
+  ASSERT_EQ(splitInfos["1"]->paths, std::vector<std::string>{"file:///a.parquet"});
+  ASSERT_EQ(newMisses(), 1);
+  ASSERT_EQ(newHits(), 1);
+}
+
+TEST_F(VeloxPlanCacheTest, hitGetsSplitsOfTask) {
+  auto key = VeloxPlanCache::makeKey(makePlan({"file:///a.parquet"}, 0));
+  auto plan = makeVeloxPlan("0");
+  cache_.insert(key, plan, convertedSplits(key, "1"));
+
+  // Another task of the stage reads different files with the same plan.
+  auto otherKey = VeloxPlanCache::makeKey(makePlan({"file:///b.parquet", "file:///c.parquet"}, 0));
+  ASSERT_EQ(otherKey.bytes, key.bytes);
+  SplitInfoMap splitInfos;
+  ASSERT_EQ(cache_.lookup(otherKey, splitInfos), plan);
+  ASSERT_EQ(newHits(), 1);
+  ASSERT_EQ(splitInfos.size(), 1);
+  const auto& splitInfo = *splitInfos["1"];
+  std::vector<std::string> expectedPaths{"file:///b.parquet", "file:///c.parquet"};
+  std::vector<uint64_t> expectedStarts{0, 0};
+  std::vector<uint64_t> expectedLengths{100, 200};
+  ASSERT_EQ(splitInfo.paths, expectedPaths);
+  ASSERT_EQ(splitInfo.starts, expectedStarts);
+  ASSERT_EQ(splitInfo.lengths, expectedLengths);
+  ASSERT_EQ(splitInfo.format, dwio::common::FileFormat::PARQUET);
+}
+
+TEST_F(VeloxPlanCacheTest, differentPlanMisses) {
+  auto key = VeloxPlanCache::makeKey(makePlan({"file:///a.parquet"}, 0));
+  cache_.insert(key, makeVeloxPlan("0"), convertedSplits(key, "1"));
+
+  auto otherKey = VeloxPlanCache::makeKey(makePlan({"file:///a.parquet"}, 1));
+  SplitInfoMap splitInfos;
+  ASSERT_EQ(cache_.lookup(otherKey, splitInfos), nullptr);
+  ASSERT_EQ(newMisses(), 1);
+  ASSERT_EQ(newHits(), 0);
+}
+
+TEST_F(VeloxPlanCacheTest, evictsLeastRecentlyUsed) {
+  std::vector<VeloxPlanCache::Key> keys;
+  std::vector<std::shared_ptr<const core::PlanNode>> plans;
+  for (int32_t i = 0; i < 3; ++i) {
+    keys.emplace_back(VeloxPlanCache::makeKey(makePlan({"file:///a.parquet"}, i)));
+    plans.emplace_back(makeVeloxPlan("0"));
+  }
+  SplitInfoMap splitInfos;
+  cache_.insert(keys[0], plans[0], convertedSplits(keys[0], "1"));
+  cache_.insert(keys[1], plans[1], convertedSplits(keys[1], "1"));
+  // Touch the first plan so that the second one is the least recently used.
+  ASSERT_EQ(cache_.lookup(keys[0], splitInfos), plans[0]);
+  cache_.insert(keys[2], plans[2], convertedSplits(keys[2], "1"));
+
+  ASSERT_EQ(cache_.lookup(keys[1], splitInfos), nullptr);
+  ASSERT_EQ(cache_.lookup(keys[0], splitInfos), plans[0]);
+  ASSERT_EQ(cache_.lookup(keys[2], splitInfos), plans[2]);
+  ASSERT_EQ(newHits(), 3);
+  ASSERT_EQ(newMisses(), 1);
+
+  // Shrinking the cache evicts from the least recently used end too.
+  cache_.setCapacity(1);
+  ASSERT_EQ(cache_.lookup(keys[0], splitInfos), nullptr);
+  ASSERT_EQ(cache_.lookup(keys[2], splitInfos), plans[2]);
+}
+
+TEST_F(VeloxPlanCacheTest, ambiguousScansNotCached) {
+  // Two read relations over the same files cannot be told apart by their splits.
+  ::substrait::Plan plan = makePlan({"file:///a.parquet"}, 0);
+  auto* join = plan.mutable_relations(0)->mutable_root()->mutable_input()->mutable_join();
+  *join->mutable_left() = makePlan({"file:///a.parquet"}, 0).relations(0).root().input();
+  *join->mutable_right() = makePlan({"file:///a.parquet"}, 1).relations(0).root().input();
+  auto key = VeloxPlanCache::makeKey(plan);
+  ASSERT_EQ(key.splitInfos.size(), 2);
+
+  SplitInfoMap converted;
+  converted["1"] = std::make_shared<substrait::SplitInfo>(*key.splitInfos[0]);
+  converted["3"] = std::make_shared<substrait::SplitInfo>(*key.splitInfos[1]);
+  cache_.insert(key, makeVeloxPlan("4"), converted);
+
+  SplitInfoMap splitInfos;
+  ASSERT_EQ(cache_.lookup(key, splitInfos), nullptr);
+}
+
+TEST_F(VeloxPlanCacheTest, disabled) {
+  cache_.setCapacity(0);
+  ASSERT_FALSE(cache_.enabled());
+  auto key = VeloxPlanCache::makeKey(makePlan({"file:///a.parquet"}, 0));
+  cache_.insert(key, makeVeloxPlan("0"), convertedSplits(key, "1"));
+  SplitInfoMap splitInfos;
+  ASSERT_EQ(cache_.lookup(key, splitInfos), nullptr);
+}
+
+} // namespace gluten
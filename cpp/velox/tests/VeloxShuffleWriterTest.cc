@@ -16,6 +16,7 @@
  */
 
 #include "shuffle/VeloxShuffleWriter.h"
+#include "memory/ArrowMemoryPool.h"
 #include "memory/VeloxColumnarBatch.h"
 #include "memory/VeloxMemoryPool.h"
 #include "utils/TestUtils.h"
@@ -33,8 +34,10 @@
 #include <arrow/record_batch.h>
 #include <arrow/util/io_util.h>
 #include <execinfo.h>
+#include <functional>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <thread>
 
 #include "shuffle/LocalPartitionWriter.h"
 #include "shuffle/VeloxShuffleReader.h"
@@ -46,6 +49,52 @@ using namespace arrow::ipc;
 
 namespace gluten {
 
+// Calls onAllocate on each allocation while it is set, like the spill callback of the memory manager.
+class SpillingMemoryPool final : public arrow::MemoryPool {
+ public:
+  void setOnAllocate(std::function<void()> onAllocate) {
+    onAllocate_ = std::move(onAllocate);
+  }
+
+  arrow::Status Allocate(int64_t size, int64_t alignment, uint8_t** out) override {
+    if (onAllocate_ && !inCallback_) {
+      inCallback_ = true;
+      onAllocate_();
+      inCallback_ = false;
+    }
+    return pool_->Allocate(size, alignment, out);
+  }
+
+  arrow::Status Reallocate(int64_t oldSize, int64_t newSize, int64_t alignment, uint8_t** ptr) override {
+    return pool_->Reallocate(oldSize, newSize, alignment, ptr);
+  }
+
+  void Free(uint8_t* buffer, int64_t size, int64_t alignment) override {
+    pool_->Free(buffer, size, alignment);
+  }
+
+  int64_t bytes_allocated() const override {
+    return pool_->bytes_allocated();
+  }
+
+  int64_t total_bytes_allocated() const override {
+    return pool_->total_bytes_allocated();
+  }
+
+  int64_t num_allocations() const override {
+    return pool_->num_allocations();
+  }
+
+  std::string backend_name() const override {
+    return pool_->backend_name();
+  }
+
+ private:
+  arrow::MemoryPool* pool_ = arrow::default_memory_pool();
+  std::function<void()> onAllocate_;
+  bool inCallback_ = false;
+};
+
 class VeloxShuffleWriterTest : public ::testing::TestWithParam<bool>, public velox::test::VectorTestBase {
  protected:
   void SetUp() override {
@@ -175,6 +224,17 @@ class VeloxShuffleWriterTest : public ::testing::TestWithParam<bool>, public vel
     }
   }
 
+  std::shared_ptr<VeloxShuffleReader>
+  makeShuffleReader(const std::string& fileName, const TypePtr& dataType, const ReaderOptions& options) {
+    std::shared_ptr<arrow::io::ReadableFile> in;
+    GLUTEN_ASSIGN_OR_THROW(in, arrow::io::ReadableFile::Open(fileName));
+    ArrowSchema cSchema;
+    velox::exportToArrow(BaseVector::create(dataType, 0, pool_.get()), cSchema);
+    std::shared_ptr<arrow::Schema> schema;
+    GLUTEN_ASSIGN_OR_THROW(schema, arrow::ImportSchema(&cSchema));
+    return std::make_shared<VeloxShuffleReader>(in, schema, options, defaultArrowMemoryPool(), pool_);
+  }
+
   void shuffleWriteReadMultiBlocks(
       VeloxShuffleWriter& shuffleWriter,
       int32_t expectPartitionLength,
@@ -279,6 +339,71 @@ TEST_P(VeloxShuffleWriterTest, singlePart3Vectors) {
   testShuffleWrite(*shuffleWriter, {inputVector1_, inputVector2_, inputVector1_});
 }
 
+TEST_P(VeloxShuffleWriterTest, singlePartPrefetchRead) {
+  shuffleWriterOptions_.buffer_size = 10;
+  shuffleWriterOptions_.partitioning_name = "single";
+
+  GLUTEN_ASSIGN_OR_THROW(
+      auto shuffleWriter, VeloxShuffleWriter::create(1, partitionWriterCreator_, shuffleWriterOptions_))
+
+  std::vector<velox::RowVectorPtr> vectors = {inputVector1_, inputVector2_, inputVector1_};
+  for (auto& vector : vectors) {
+    splitRowVector(*shuffleWriter, vector);
+  }
+  ASSERT_NOT_OK(shuffleWriter->stop());
+
+  auto readerOptions = ReaderOptions::defaults();
+  readerOptions.prefetch_batches = 2;
+  std::atomic<int32_t> prefetchThreadExits{0};
+  auto consumerThreadId = std::this_thread::get_id();
+  readerOptions.prefetch_thread_exit = [&]() {
+    ASSERT_NE(std::this_thread::get_id(), consumerThreadId);
+    ++prefetchThreadExits;
+  };
+  auto reader = makeShuffleReader(shuffleWriter->dataFile(), inputVector1_->type(), readerOptions);
+
+  for (auto& vector : vectors) {
+    GLUTEN_ASSIGN_OR_THROW(auto batch, reader->next());
+    ASSERT_NE(batch, nullptr);
+    velox::test::assertEqualVectors(vector, std::dynamic_pointer_cast<VeloxColumnarBatch>(batch)->getRowVector());
+  }
+  GLUTEN_ASSIGN_OR_THROW(auto eos, reader->next());
+  ASSERT_EQ(eos, nullptr);
+  ASSERT_GT(reader->getDecompressTime(), 0);
+  ASSERT_NOT_OK(reader->close());
+  ASSERT_EQ(prefetchThreadExits, 1);
+}
+
+TEST_P(VeloxShuffleWriterTest, singlePartCoalesceRead) {
+  shuffleWriterOptions_.buffer_size = 10;
+  shuffleWriterOptions_.partitioning_name = "single";
+
+  GLUTEN_ASSIGN_OR_THROW(
+      auto shuffleWriter, VeloxShuffleWriter::create(1, partitionWriterCreator_, shuffleWriterOptions_))
+
+  for (auto& vector : {inputVector1_, inputVector2_, inputVector1_, inputVector2_}) {
+    splitRowVector(*shuffleWriter, vector);
+  }
+  ASSERT_NOT_OK(shuffleWriter->stop());
+
+  // 10 + 2 rows fit into the first batch, the third input would overshoot and starts the second one.
+  auto readerOptions = ReaderOptions::defaults();
+  readerOptions.coalesce_batch_rows = 12;
+  auto reader = makeShuffleReader(shuffleWriter->dataFile(), inputVector1_->type(), readerOptions);
+
+  auto expected = RowVector::createEmpty(inputVector1_->type(), pool_.get());
+  expected->append(inputVector1_.get());
+  expected->append(inputVector2_.get());
+  // Read twice so that the second batch reuses the buffers released by the first one.
+  for (int32_t i = 0; i < 2; ++i) {
+    GLUTEN_ASSIGN_OR_THROW(auto batch, reader->next());
+    ASSERT_NE(batch, nullptr);
+    velox::test::assertEqualVectors(expected, std::dynamic_pointer_cast<VeloxColumnarBatch>(batch)->getRowVector());
+  }
+  GLUTEN_ASSIGN_OR_THROW(auto eos, reader->next());
+  ASSERT_EQ(eos, nullptr);
+}
+
 TEST_P(VeloxShuffleWriterTest, singlePartCompress) {
   shuffleWriterOptions_.buffer_size = 10;
   shuffleWriterOptions_.partitioning_name = "single";
@@ -478,6 +603,101 @@ TEST_P(VeloxShuffleWriterTest, hashPart3Vectors) {
       {{block1Pid2, block2Pid2, block1Pid2}, {block1Pid1, block1Pid1}});
 }
 
+TEST_P(VeloxShuffleWriterTest, pipelinedHashPart3Vectors) {
+  shuffleWriterOptions_.buffer_size = 4;
+  shuffleWriterOptions_.partitioning_name = "hash";
+  shuffleWriterOptions_.pipelined_write = true;
+  // pipelined write only works with the prefer-evict partition writer
+  shuffleWriterOptions_.prefer_evict = true;
+  partitionWriterCreator_ = std::make_shared<LocalPartitionWriterCreator>(true);
+
+  ARROW_ASSIGN_OR_THROW(shuffleWriter_, VeloxShuffleWriter::create(2, partitionWriterCreator_, shuffleWriterOptions_))
+
+  auto block1Pid1 = takeRows(inputVector1_, {0, 5, 6, 7, 9});
+  auto block1Pid2 = takeRows(inputVector1_, {1, 2, 3, 4, 8});
+  auto block2Pid2 = takeRows(inputVector2_, {0, 1});
+
+  testShuffleWriteMultiBlocks(
+      *shuffleWriter_,
+      {hashInputVector1_, hashInputVector2_, hashInputVector1_},
+      2,
+      inputVector1_->type(),
+      {{block1Pid2, block2Pid2, block1Pid2}, {block1Pid1, block1Pid1}});
+}
+
+TEST_P(VeloxShuffleWriterTest, pipelinedSpillFromOtherThread) {
+  shuffleWriterOptions_.buffer_size = 4;
+  shuffleWriterOptions_.partitioning_name = "rr";
+  shuffleWriterOptions_.pipelined_write = true;
+  shuffleWriterOptions_.prefer_evict = true;
+  partitionWriterCreator_ = std::make_shared<LocalPartitionWriterCreator>(true);
+
+  ARROW_ASSIGN_OR_THROW(shuffleWriter_, VeloxShuffleWriter::create(2, partitionWriterCreator_, shuffleWriterOptions_))
+
+  splitRowVector(*shuffleWriter_, inputVector1_);
+  splitRowVector(*shuffleWriter_, inputVector2_);
+
+  // the spill waits for the writes in flight instead of touching the split state of the task thread
+  arrow::Status status;
+  int64_t evicted = -1;
+  std::thread([&]() { status = shuffleWriter_->evictFixedSize(1 << 20, &evicted); }).join();
+  ASSERT_NOT_OK(status);
+  ASSERT_GE(evicted, 0);
+
+  auto block1Pid1 = takeRows(inputVector1_, {0, 2, 4, 6, 8});
+  auto block2Pid1 = takeRows(inputVector2_, {0});
+  auto block1Pid2 = takeRows(inputVector1_, {1, 3, 5, 7, 9});
+  auto block2Pid2 = takeRows(inputVector2_, {1});
+
+  shuffleWriteReadMultiBlocks(
+      *shuffleWriter_, 2, inputVector1_->type(), {{block1Pid1, block2Pid1}, {block1Pid2, block2Pid2}});
+}
+
+TEST_P(VeloxShuffleWriterTest, sortBasedHashPart3Vectors) {
+  shuffleWriterOptions_.buffer_size = 4;
+  shuffleWriterOptions_.partitioning_name = "hash";
+  shuffleWriterOptions_.shuffle_writer_type = "sort";
+  // sort mode always spills through the prefer-cache partition writer
+  shuffleWriterOptions_.prefer_evict = false;
+  partitionWriterCreator_ = std::make_shared<LocalPartitionWriterCreator>(false);
+
+  ARROW_ASSIGN_OR_THROW(shuffleWriter_, VeloxShuffleWriter::create(2, partitionWriterCreator_, shuffleWriterOptions_))
+
+  // all buffered rows of one partition are cached as a single block
+  auto blockPid1 = takeRows(inputVector1_, {0, 5, 6, 7, 9, 0, 5, 6, 7, 9});
+  auto blockPid2 = takeRows(inputVector1_, {1, 2, 3, 4, 8});
+  blockPid2->append(inputVector2_.get());
+  blockPid2->append(takeRows(inputVector1_, {1, 2, 3, 4, 8}).get());
+
+  testShuffleWriteMultiBlocks(
+      *shuffleWriter_,
+      {hashInputVector1_, hashInputVector2_, hashInputVector1_},
+      2,
+      inputVector1_->type(),
+      {{blockPid2}, {blockPid1}});
+}
+
+TEST_P(VeloxShuffleWriterTest, sortBasedSpill) {
+  shuffleWriterOptions_.buffer_size = 4;
+  shuffleWriterOptions_.partitioning_name = "rr";
+  shuffleWriterOptions_.shuffle_writer_type = "sort";
+  shuffleWriterOptions_.prefer_evict = false;
+  partitionWriterCreator_ = std::make_shared<LocalPartitionWriterCreator>(false);
+
+  ARROW_ASSIGN_OR_THROW(shuffleWriter_, VeloxShuffleWriter::create(2, partitionWriterCreator_, shuffleWriterOptions_))
+
+  splitRowVector(*shuffleWriter_, inputVector1_);
+  int64_t evicted = 0;
+  ASSERT_NOT_OK(shuffleWriter_->evictFixedSize(1, &evicted));
+  ASSERT_GT(evicted, 0);
+  splitRowVector(*shuffleWriter_, inputVector1_);
+
+  auto blockPid1 = takeRows(inputVector1_, {0, 2, 4, 6, 8});
+  auto blockPid2 = takeRows(inputVector1_, {1, 3, 5, 7, 9});
+  shuffleWriteReadMultiBlocks(
+      *shuffleWriter_, 2, inputVector1_->type(), {{blockPid1, blockPid1}, {blockPid2, blockPid2}});
+}
+
 TEST_P(VeloxShuffleWriterTest, roundRobin) {
   int32_t numPartitions = 2;
   shuffleWriterOptions_.buffer_size = 4;
@@ -531,6 +751,47 @@ TEST_P(VeloxShuffleWriterTest, rangePartition) {
       {{block1Pid1, block2Pid1, block1Pid1}, {block1Pid2, block2Pid2, block1Pid2}});
 }
 
+TEST_P(VeloxShuffleWriterTest, evictDuringStop) {
+  auto pool = std::make_shared<SpillingMemoryPool>();
+
+  int32_t numPartitions = 2;
+  shuffleWriterOptions_.buffer_size = 4;
+  shuffleWriterOptions_.memory_pool = pool;
+  shuffleWriterOptions_.partitioning_name = "rr";
+  ARROW_ASSIGN_OR_THROW(
+      shuffleWriter_, VeloxShuffleWriter::create(numPartitions, partitionWriterCreator_, shuffleWriterOptions_));
+
+  splitRowVector(*shuffleWriter_, inputVector1_);
+  splitRowVector(*shuffleWriter_, inputVector2_);
+  splitRowVector(*shuffleWriter_, inputVector1_);
+
+  // stop() allocates to compress the remaining buffers, ask the writer to spill on each of those allocations.
+  int32_t evictRequests = 0;
+  int64_t evictedDuringStop = 0;
+  pool->setOnAllocate([&]() {
+    int64_t evicted = 0;
+    if (shuffleWriter_->evictFixedSize(1 << 20, &evicted).ok()) {
+      evictedDuringStop += evicted;
+    }
+    ++evictRequests;
+  });
+
+  auto block1Pid1 = takeRows(inputVector1_, {0, 2, 4, 6, 8});
+  auto block2Pid1 = takeRows(inputVector2_, {0});
+
+  auto block1Pid2 = takeRows(inputVector1_, {1, 3, 5, 7, 9});
+  auto block2Pid2 = takeRows(inputVector2_, {1});
+
+  shuffleWriteReadMultiBlocks(
+      *shuffleWriter_,
+      2,
+      inputVector1_->type(),
+      {{block1Pid1, block2Pid1, block1Pid1}, {block1Pid2, block2Pid2, block1Pid2}});
+  pool->setOnAllocate(nullptr);
+  ASSERT_GT(evictRequests, 0);
+  ASSERT_EQ(evictedDuringStop, 0);
+}
+
 TEST_P(VeloxShuffleWriterTest, memoryLeak) {
   std::shared_ptr<arrow::MemoryPool> pool = std::make_shared<MyMemoryPool>(17 * 1024 * 1024);
 
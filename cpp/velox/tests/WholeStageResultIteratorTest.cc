@@ -0,0 +1,109 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+#include "compute/WholeStageResultIterator.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+class ResultQueueTest : public ::testing::Test, public test::VectorTestBase {
+ protected:
+  using ResultQueue = WholeStageResultIterator::ResultQueue;
+
+  static constexpr uint32_t kNumDrivers = 4;
+  static constexpr int32_t kNumVectors = 10;
+  static constexpr int32_t kRowsPerVector = 100;
+
+  // Each driver of the task produces all the values, consumed through a queue of two vectors per driver like in
+  // WholeStageResultIterator. If failAfter is set, the consumer fails the task once that many vectors went through.
+  std::shared_ptr<exec::Task> makeTask(std::shared_ptr<ResultQueue> queue, std::optional<int32_t> failAfter = {}) {
+    std::vector<RowVectorPtr> values;
+    for (int32_t i = 0; i < kNumVectors; ++i) {
+      values.push_back(makeRowVector({makeFlatVector<int64_t>(kRowsPerVector, [](auto row) { return row; })}));
+    }
+    auto plan = std::make_shared<core::ValuesNode>("0", std::move(values), true);
+    core::PlanFragment planFragment{plan, core::ExecutionStrategy::kUngrouped, 1, {}};
+
+    auto consumed = std::make_shared<std::atomic<int32_t>>(0);
+    auto task = exec::Task::create(
+        "result-queue-test",
+        std::move(planFragment),
+        0,
+        std::make_shared<core::QueryCtx>(executor_.get()),
+        [queue, consumed, failAfter](RowVectorPtr vector, ContinueFuture* future) {
+          if (vector != nullptr && failAfter.has_value() && ++*consumed > *failAfter) {
+            VELOX_FAIL("Injected failure");
+          }
+          return queue->enqueue(std::move(vector), future);
+        });
+    queue->finishWith(*task, executor_.get());
+    return task;
+  }
+
+  std::shared_ptr<folly::CPUThreadPoolExecutor> executor_ = std::make_shared<folly::CPUThreadPoolExecutor>(kNumDrivers);
+};
+
+TEST_F(ResultQueueTest, multipleDrivers) {
+  auto queue = std::make_shared<ResultQueue>(kNumDrivers * 2);
+  auto task = makeTask(queue);
+  exec::Task::start(task, kNumDrivers);
+
+  int64_t numRows = 0;
+  while (auto vector = queue->dequeue(*task)) {
+    numRows += vector->size();
+  }
+  ASSERT_EQ(numRows, kNumDrivers * kNumVectors * kRowsPerVector);
+  ASSERT_FALSE(task->isRunning());
+  // Drained and finished.
+  ASSERT_EQ(queue->dequeue(*task), nullptr);
+}
+
+TEST_F(ResultQueueTest, failingDriver) {
+  auto queue = std::make_shared<ResultQueue>(kNumDrivers * 2);
+  auto task = makeTask(queue, kNumVectors);
+  exec::Task::start(task, kNumDrivers);
+
+  int64_t numRows = 0;
+  try {
+    while (auto vector = queue->dequeue(*task)) {
+      numRows += vector->size();
+    }
+    FAIL() << "The error of the task is not rethrown";
+  } catch (const VeloxException& e) {
+    ASSERT_NE(e.message().find("Injected failure"), std::string::npos);
+  }
+  ASSERT_LE(numRows, kNumVectors * kRowsPerVector);
+  ASSERT_FALSE(task->isRunning());
+}
+
+TEST_F(ResultQueueTest, closeUnblocksDrivers) {
+  // One pending vector blocks all the drivers, closing the queue lets them run to the end.
+  auto queue = std::make_shared<ResultQueue>(1);
+  auto task = makeTask(queue);
+  exec::Task::start(task, kNumDrivers);
+  ASSERT_NE(queue->dequeue(*task), nullptr);
+  queue->close();
+  ASSERT_EQ(queue->dequeue(*task), nullptr);
+  task->requestCancel().wait();
+}
+
+} // namespace gluten
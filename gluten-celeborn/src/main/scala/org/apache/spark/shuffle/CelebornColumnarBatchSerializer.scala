@@ -78,8 +78,9 @@ private class CelebornColumnarBatchSerializerInstance(schema: StructType,
         // should keep alive before all buffers to finish consuming.
         TaskResources.addRecycler(50) {
           close()
-          ShuffleReaderJniWrapper.INSTANCE.close(handle)
+          ShuffleReaderJniWrapper.INSTANCE.release(handle)
         }
+        nativeReaderCreated = true
         handle
       }
 
@@ -90,6 +91,8 @@ private class CelebornColumnarBatchSerializerInstance(schema: StructType,
 
       private var isClosed: Boolean = false
 
+      private var nativeReaderCreated: Boolean = false
+
       private val isEmptyStream: Boolean = in.equals(RssInputStream.empty())
 
       override def asKeyValueIterator: Iterator[(Any, Any)] = new Iterator[(Any, Any)] {
@@ -178,6 +181,10 @@ private class CelebornColumnarBatchSerializerInstance(schema: StructType,
             readBatchNumRows.set(numRowsTotal.toDouble / numBatchesTotal)
           }
           numOutputRows += numRowsTotal
+          // The prefetch thread of the native reader may be reading the stream, stop it first.
+          if (nativeReaderCreated) {
+            ShuffleReaderJniWrapper.INSTANCE.close(shuffleReaderHandle)
+          }
           cSchema.close()
           jniByteInputStream.close()
           if (cb != null) cb.close()
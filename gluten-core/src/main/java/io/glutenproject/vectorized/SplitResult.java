@@ -25,6 +25,10 @@ public class SplitResult {
   private final long totalWriteTime;
   private final long totalEvictTime;
   private final long totalCompressTime; // overlaps with totalEvictTime and totalWriteTime
+  // time the task thread spent on or waiting for compression and writes, less than the totals
+  // above if they run in background threads
+  private final long totalCompressWallTime;
+  private final long totalWriteWallTime;
   private final long totalBytesWritten;
   private final long totalBytesEvicted;
   private final long[] partitionLengths;
@@ -39,10 +43,36 @@ public class SplitResult {
       long totalBytesEvicted,
       long[] partitionLengths,
       long[] rawPartitionLengths) {
+    this(
+        totalComputePidTime,
+        totalWriteTime,
+        totalEvictTime,
+        totalCompressTime,
+        totalCompressTime,
+        totalWriteTime,
+        totalBytesWritten,
+        totalBytesEvicted,
+        partitionLengths,
+        rawPartitionLengths);
+  }
+
+  public SplitResult(
+      long totalComputePidTime,
+      long totalWriteTime,
+      long totalEvictTime,
+      long totalCompressTime,
+      long totalCompressWallTime,
+      long totalWriteWallTime,
+      long totalBytesWritten,
+      long totalBytesEvicted,
+      long[] partitionLengths,
+      long[] rawPartitionLengths) {
     this.totalComputePidTime = totalComputePidTime;
     this.totalWriteTime = totalWriteTime;
     this.totalEvictTime = totalEvictTime;
     this.totalCompressTime = totalCompressTime;
+    this.totalCompressWallTime = totalCompressWallTime;
+    this.totalWriteWallTime = totalWriteWallTime;
     this.totalBytesWritten = totalBytesWritten;
     this.totalBytesEvicted = totalBytesEvicted;
     this.partitionLengths = partitionLengths;
@@ -65,6 +95,14 @@ public class SplitResult {
     return totalCompressTime;
   }
 
+  public long getTotalCompressWallTime() {
+    return totalCompressWallTime;
+  }
+
+  public long getTotalWriteWallTime() {
+    return totalWriteWallTime;
+  }
+
   public long getTotalBytesWritten() {
     return totalBytesWritten;
   }
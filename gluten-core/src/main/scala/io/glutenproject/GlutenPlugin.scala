@@ -192,6 +192,7 @@ private[glutenproject] class GlutenExecutorPlugin extends ExecutorPlugin {
     // TODO categorize the APIs by driver's or executor's
     BackendsApiManager.initialize()
     BackendsApiManager.getContextApiInstance.initialize(conf)
+    BackendsApiManager.getContextApiInstance.registerMetrics(ctx.metricRegistry())
 
     executorEndpoint = new GlutenExecutorEndpoint(ctx.executorID(), conf)
   }
@@ -17,6 +17,7 @@
 
 package io.glutenproject.backendsapi
 
+import com.codahale.metrics.MetricRegistry
 import org.apache.spark.SparkConf
 import org.apache.spark.util.TaskResource
 
@@ -29,6 +30,15 @@ trait ContextApi {
 
   def taskResourceFactories(): Seq[() => TaskResource] = Seq()
 
+  /**
+   * Should call by executor.
+   * Register the executor-wide metrics of the backend, reported under the Gluten plugin.
+   *
+   * @param registry
+   *   metric registry of the executor plugin
+   */
+  def registerMetrics(registry: MetricRegistry): Unit = {}
+
   /**
    * Should call by driver.
    * Collect Broadcast Hash Table Ids.
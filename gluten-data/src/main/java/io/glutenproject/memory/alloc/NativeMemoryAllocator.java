@@ -17,6 +17,9 @@
 
 package io.glutenproject.memory.alloc;
 
+import io.glutenproject.GlutenConfig;
+import org.apache.spark.SparkEnv;
+
 /**
  * This along with {@link NativeMemoryAllocators},
  * as built-in toolkit for managing native memory allocations.
@@ -44,7 +47,17 @@ public class NativeMemoryAllocator {
   public static NativeMemoryAllocator createListenable(
       ReservationListener listener, NativeMemoryAllocator delegated) {
     return new NativeMemoryAllocator(
-        createListenableAllocator(listener, delegated.nativeInstanceId), listener);
+        createListenableAllocator(listener, delegated.nativeInstanceId, reservationBlockSize()),
+        listener);
+  }
+
+  private static long reservationBlockSize() {
+    final SparkEnv env = SparkEnv.get();
+    if (env == null) {
+      // Use the native default
+      return -1L;
+    }
+    return env.conf().getSizeAsBytes(GlutenConfig.GLUTEN_RESERVATION_BLOCK_SIZE_KEY(), "8MB");
   }
 
   public ReservationListener listener() {
@@ -66,7 +79,7 @@ public class NativeMemoryAllocator {
   private static native long getAllocator(String typeName);
 
   private static native long createListenableAllocator(
-      ReservationListener listener, long delegatedAllocatorId);
+      ReservationListener listener, long delegatedAllocatorId, long reservationBlockSize);
 
   private static native void releaseAllocator(long allocatorId);
 
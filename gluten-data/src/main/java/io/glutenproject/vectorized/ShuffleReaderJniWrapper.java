@@ -30,6 +30,14 @@ public class ShuffleReaderJniWrapper extends JniInitialized {
   public native long next(long handle);
 
   public native void populateMetrics(long handle, ShuffleReaderMetrics metrics);
+
+  /**
+   * Stops reading from the input stream, joining the prefetch thread if any. Must be called
+   * before the input stream is closed.
+   */
   public native void close(long handle);
 
+  /** Releases the reader, the batches it returned must not be used afterwards. */
+  public native void release(long handle);
+
 }
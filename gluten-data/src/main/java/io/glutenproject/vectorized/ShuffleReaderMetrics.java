@@ -19,6 +19,7 @@ package io.glutenproject.vectorized;
 
 public class ShuffleReaderMetrics {
   private long decompressTime;
+  private long consumerWaitTime;
 
   public void setDecompressTime(long decompressTime) {
     this.decompressTime = decompressTime;
@@ -27,4 +28,12 @@ public class ShuffleReaderMetrics {
   public long getDecompressTime() {
     return decompressTime;
   }
+
+  public void setConsumerWaitTime(long consumerWaitTime) {
+    this.consumerWaitTime = consumerWaitTime;
+  }
+
+  public long getConsumerWaitTime() {
+    return consumerWaitTime;
+  }
 }
@@ -38,16 +38,22 @@ public class ShuffleWriterJniWrapper extends JniInitialized {
    * @param localDirs configured local directories where Spark can write files
    * @param preferEvict if true, write the partition buffer to disk once it is full
    * @param memoryPoolId
+   * @param sortBasedShuffleThreshold number of partitions from which rows are sorted by partition
+   *     id in one buffer instead of being split into per-partition buffers
+   * @param pipelinedWrite compress and write evicted partitions in background threads, only used
+   *     with preferEvict
    * @return native shuffle writer instance id if created successfully.
    */
   public long make(NativePartitioning part, long offheapPerTask, int bufferSize, String codec,
                    String codecBackend, int batchCompressThreshold, String dataFile,
                    int subDirsPerLocalDir, String localDirs, boolean preferEvict, long memoryPoolId,
-                   boolean writeSchema, long handle, long taskAttemptId) {
+                   boolean writeSchema, long handle, long taskAttemptId,
+                   int sortBasedShuffleThreshold, boolean pipelinedWrite) {
     return nativeMake(part.getShortName(), part.getNumPartitions(),
         offheapPerTask, bufferSize, codec, codecBackend, batchCompressThreshold, dataFile,
         subDirsPerLocalDir, localDirs, preferEvict, memoryPoolId,
-        writeSchema, handle, taskAttemptId, 0, null, "local");
+        writeSchema, handle, taskAttemptId, 0, null, "local", sortBasedShuffleThreshold,
+        pipelinedWrite);
   }
 
   /**
@@ -67,7 +73,8 @@ public class ShuffleWriterJniWrapper extends JniInitialized {
     return nativeMake(part.getShortName(), part.getNumPartitions(),
         offheapPerTask, bufferSize, codec, null, batchCompressThreshold, null,
         0, null, true, memoryPoolId,
-        false, handle, taskAttemptId, pushBufferMaxSize, pusher, partitionWriterType);
+        false, handle, taskAttemptId, pushBufferMaxSize, pusher, partitionWriterType, 0,
+        false);
   }
 
   public native long nativeMake(String shortName, int numPartitions,
@@ -76,7 +83,8 @@ public class ShuffleWriterJniWrapper extends JniInitialized {
                                 String dataFile, int subDirsPerLocalDir, String localDirs,
                                 boolean preferEvict, long memoryPoolId, boolean writeSchema,
                                 long handle, long taskAttemptId, int pushBufferMaxSize,
-                                Object pusher, String partitionWriterType);
+                                Object pusher, String partitionWriterType,
+                                int sortBasedShuffleThreshold, boolean pipelinedWrite);
 
   /**
    * Evict partition data.
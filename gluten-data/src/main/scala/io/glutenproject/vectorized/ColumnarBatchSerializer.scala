@@ -41,13 +41,19 @@ class ColumnarBatchSerializer(
     schema: StructType,
     readBatchNumRows: SQLMetric,
     numOutputRows: SQLMetric,
-    decompressTime: SQLMetric)
+    decompressTime: SQLMetric,
+    consumerWaitTime: SQLMetric)
   extends Serializer
   with Serializable {
 
   /** Creates a new [[SerializerInstance]]. */
   override def newInstance(): SerializerInstance = {
-    new ColumnarBatchSerializerInstance(schema, readBatchNumRows, numOutputRows, decompressTime)
+    new ColumnarBatchSerializerInstance(
+      schema,
+      readBatchNumRows,
+      numOutputRows,
+      decompressTime,
+      consumerWaitTime)
   }
 }
 
@@ -55,7 +61,8 @@ private class ColumnarBatchSerializerInstance(
     schema: StructType,
     readBatchNumRows: SQLMetric,
     numOutputRows: SQLMetric,
-    decompressTime: SQLMetric)
+    decompressTime: SQLMetric,
+    consumerWaitTime: SQLMetric)
   extends SerializerInstance
     with Logging {
 
@@ -84,7 +91,7 @@ private class ColumnarBatchSerializerInstance(
         // should keep alive before all buffers finish consuming.
         TaskResources.addRecycler(50) {
           close()
-          ShuffleReaderJniWrapper.INSTANCE.close(handle)
+          ShuffleReaderJniWrapper.INSTANCE.release(handle)
         }
         handle
       }
@@ -147,11 +154,14 @@ private class ColumnarBatchSerializerInstance(
           // Collect Metrics
           ShuffleReaderJniWrapper.INSTANCE.populateMetrics(shuffleReaderHandle, readerMetrics)
           decompressTime += readerMetrics.getDecompressTime
+          consumerWaitTime += readerMetrics.getConsumerWaitTime
           if (numBatchesTotal > 0) {
             readBatchNumRows.set(numRowsTotal.toDouble / numBatchesTotal)
           }
           numOutputRows += numRowsTotal
 
+          // The prefetch thread of the native reader may be reading the stream, stop it first.
+          ShuffleReaderJniWrapper.INSTANCE.close(shuffleReaderHandle)
           cSchema.close()
           jniByteInputStream.close()
           if (cb != null) cb.close()
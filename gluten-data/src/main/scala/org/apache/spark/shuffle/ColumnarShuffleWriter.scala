@@ -78,6 +78,10 @@ class ColumnarShuffleWriter[K, V](
 
   private val writeSchema = GlutenConfig.getConf.columnarShuffleWriteSchema
 
+  private val sortBasedShuffleThreshold = GlutenConfig.getConf.columnarShuffleSortThreshold
+
+  private val pipelinedWrite = GlutenConfig.getConf.columnarShufflePipelinedWrite
+
   private val jniWrapper = new ShuffleWriterJniWrapper
 
   private var nativeShuffleWriter: Long = -1L
@@ -153,7 +157,9 @@ class ColumnarShuffleWriter[K, V](
               .getNativeInstanceId,
             writeSchema,
             handle,
-            taskContext.taskAttemptId()
+            taskContext.taskAttemptId(),
+            sortBasedShuffleThreshold,
+            pipelinedWrite
           )
         }
         val startTime = System.nanoTime()
@@ -176,10 +182,12 @@ class ColumnarShuffleWriter[K, V](
       .metrics("splitTime")
       .add(
         System.nanoTime() - startTime - splitResult.getTotalSpillTime -
-          splitResult.getTotalWriteTime -
-          splitResult.getTotalCompressTime)
+          splitResult.getTotalWriteWallTime -
+          splitResult.getTotalCompressWallTime)
     dep.metrics("spillTime").add(splitResult.getTotalSpillTime)
     dep.metrics("compressTime").add(splitResult.getTotalCompressTime)
+    dep.metrics("compressWallTime").add(splitResult.getTotalCompressWallTime)
+    dep.metrics("writeWallTime").add(splitResult.getTotalWriteWallTime)
     dep.metrics("bytesSpilled").add(splitResult.getTotalBytesSpilled)
     writeMetrics.incBytesWritten(splitResult.getTotalBytesWritten)
     writeMetrics.incWriteTime(splitResult.getTotalWriteTime + splitResult.getTotalSpillTime)
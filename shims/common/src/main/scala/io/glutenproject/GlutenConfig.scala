@@ -140,6 +140,10 @@ class GlutenConfig(conf: SQLConf) extends Logging {
   def columnarShuffleBatchCompressThreshold: Int =
     conf.getConf(COLUMNAR_SHUFFLE_BATCH_COMPRESS_THRESHOLD)
 
+  def columnarShuffleSortThreshold: Int = conf.getConf(COLUMNAR_SHUFFLE_SORT_THRESHOLD)
+
+  def columnarShufflePipelinedWrite: Boolean = conf.getConf(COLUMNAR_SHUFFLE_PIPELINED_WRITE)
+
   def maxBatchSize: Int = conf.getConf(COLUMNAR_MAX_BATCH_SIZE)
 
   def enableColumnarLimit: Boolean = conf.getConf(COLUMNAR_LIMIT_ENABLED)
@@ -310,6 +314,8 @@ object GlutenConfig {
   // Added back to Spark Conf during executor initialization
   val GLUTEN_OFFHEAP_SIZE_IN_BYTES_KEY = "spark.gluten.memory.offHeap.size.in.bytes"
   val GLUTEN_TASK_OFFHEAP_SIZE_IN_BYTES_KEY = "spark.gluten.memory.task.offHeap.size.in.bytes"
+  // Granularity in which native memory is reserved from Spark's memory manager.
+  val GLUTEN_RESERVATION_BLOCK_SIZE_KEY = "spark.gluten.memory.reservationBlockSize"
 
   // Batch size.
   val GLUTEN_MAX_BATCH_SIZE_KEY = "spark.gluten.sql.columnar.maxBatchSize"
@@ -416,6 +422,21 @@ object GlutenConfig {
         COLUMNAR_VELOX_SPLIT_PRELOAD_PER_DRIVER.defaultValueString),
       (COLUMNAR_SHUFFLE_CODEC.key, ""),
       (COLUMNAR_SHUFFLE_CODEC_BACKEND.key, ""),
+      (
+        COLUMNAR_SHUFFLE_READER_PREFETCH_BATCHES.key,
+        COLUMNAR_SHUFFLE_READER_PREFETCH_BATCHES.defaultValueString),
+      (
+        COLUMNAR_SHUFFLE_READER_COALESCE_BATCH_ROWS.key,
+        COLUMNAR_SHUFFLE_READER_COALESCE_BATCH_ROWS.defaultValueString),
+      (
+        COLUMNAR_SHUFFLE_READER_COALESCE_BATCH_BYTES.key,
+        COLUMNAR_SHUFFLE_READER_COALESCE_BATCH_BYTES.defaultValueString),
+      (
+        COLUMNAR_SHUFFLE_PIPELINE_THREADS.key,
+        COLUMNAR_SHUFFLE_PIPELINE_THREADS.defaultValueString),
+      (
+        COLUMNAR_SHUFFLE_PIPELINE_MAX_PENDING_BYTES.key,
+        COLUMNAR_SHUFFLE_PIPELINE_MAX_PENDING_BYTES.defaultValueString),
       ("spark.hadoop.input.connect.timeout", "180000"),
       ("spark.hadoop.input.read.timeout", "180000"),
       ("spark.hadoop.input.write.timeout", "180000"),
@@ -724,12 +745,76 @@ object GlutenConfig {
       .transform(_.toLowerCase(Locale.ROOT))
       .createOptional
 
+  val COLUMNAR_SHUFFLE_READER_PREFETCH_BATCHES =
+    buildConf("spark.gluten.sql.columnar.shuffle.reader.prefetchBatches")
+      .internal()
+      .doc("Number of shuffle batches the native reader reads and decompresses ahead in a " +
+        "background thread. 0 disables prefetching.")
+      .intConf
+      .checkValue(_ >= 0, "must be non-negative")
+      .createWithDefault(0)
+
+  val COLUMNAR_SHUFFLE_READER_COALESCE_BATCH_ROWS =
+    buildConf("spark.gluten.sql.columnar.shuffle.reader.coalesceBatchRows")
+      .internal()
+      .doc("Concatenate small batches read from shuffle until they reach this number of rows. " +
+        "0 disables the row limit.")
+      .intConf
+      .checkValue(_ >= 0, "must be non-negative")
+      .createWithDefault(0)
+
+  val COLUMNAR_SHUFFLE_READER_COALESCE_BATCH_BYTES =
+    buildConf("spark.gluten.sql.columnar.shuffle.reader.coalesceBatchBytes")
+      .internal()
+      .doc("Concatenate small batches read from shuffle until they reach this size in bytes. " +
+        "0 disables the size limit.")
+      .longConf
+      .checkValue(_ >= 0, "must be non-negative")
+      .createWithDefault(0)
+
   val COLUMNAR_SHUFFLE_BATCH_COMPRESS_THRESHOLD =
     buildConf("spark.gluten.sql.columnar.shuffle.batchCompressThreshold")
       .internal()
       .intConf
       .createWithDefault(100)
 
+  val COLUMNAR_SHUFFLE_SORT_THRESHOLD =
+    buildConf("spark.gluten.sql.columnar.shuffle.sort.threshold")
+      .internal()
+      .doc("Velox shuffle writer sorts rows by partition id in one buffer instead of splitting " +
+        "them into per-partition buffers once the number of partitions reaches this value.")
+      .intConf
+      .checkValue(_ > 0, "must be positive")
+      .createWithDefault(10000)
+
+  val COLUMNAR_SHUFFLE_PIPELINED_WRITE =
+    buildConf("spark.gluten.sql.columnar.shuffle.pipelinedWrite")
+      .internal()
+      .doc("Compress shuffle payloads and write evicted partitions in background threads while " +
+        "the task keeps splitting. Only used when spark.gluten.sql.columnar.shuffle.preferSpill " +
+        "is enabled.")
+      .booleanConf
+      .createWithDefault(false)
+
+  val COLUMNAR_SHUFFLE_PIPELINE_THREADS =
+    buildConf("spark.gluten.sql.columnar.shuffle.pipelineThreads")
+      .internal()
+      .doc("Number of threads shared by the shuffle writers of an executor to compress payloads " +
+        "when spark.gluten.sql.columnar.shuffle.pipelinedWrite is enabled.")
+      .intConf
+      .checkValue(_ > 0, "must be positive")
+      .createWithDefault(2)
+
+  val COLUMNAR_SHUFFLE_PIPELINE_MAX_PENDING_BYTES =
+    buildConf("spark.gluten.sql.columnar.shuffle.pipelineMaxPendingBytes")
+      .internal()
+      .doc("Max bytes a shuffle writer keeps in flight in the background compression and writes " +
+        "when spark.gluten.sql.columnar.shuffle.pipelinedWrite is enabled. A quarter of the " +
+        "off-heap memory of the task is used instead if it is smaller.")
+      .longConf
+      .checkValue(_ > 0, "must be positive")
+      .createWithDefault(64L * 1024 * 1024)
+
   val COLUMNAR_MAX_BATCH_SIZE =
     buildConf(GLUTEN_MAX_BATCH_SIZE_KEY)
       .internal()
@@ -878,6 +963,34 @@ object GlutenConfig {
       .intConf
       .createWithDefault(2)
 
+  val COLUMNAR_VELOX_PLAN_CACHE_SIZE =
+    buildConf("spark.gluten.sql.columnar.backend.velox.planCacheSize")
+      .internal()
+      .doc("Number of converted Velox plans cached per executor and shared by the tasks of a " +
+        "stage. 0 disables the cache. Hits and misses are reported as the planCache.hits and " +
+        "planCache.misses executor metrics of the Gluten plugin.")
+      .intConf
+      .checkValue(_ >= 0, "must be non-negative")
+      .createWithDefault(0)
+
+  val COLUMNAR_VELOX_DRIVER_THREADS =
+    buildConf("spark.gluten.sql.columnar.backend.velox.driverThreads")
+      .internal()
+      .doc("Size of the executor-wide thread pool running tasks with more than one driver. " +
+        "0 disables multi-threaded task execution.")
+      .intConf
+      .checkValue(_ >= 0, "must be non-negative")
+      .createWithDefault(0)
+
+  val COLUMNAR_VELOX_MAX_DRIVERS =
+    buildConf("spark.gluten.sql.columnar.backend.velox.maxDrivers")
+      .internal()
+      .doc("Maximum number of drivers per Spark task for stages reading from scans only. " +
+        "Values above 1 take effect when driverThreads is positive.")
+      .intConf
+      .checkValue(_ >= 1, "must be positive")
+      .createWithDefault(1)
+
   val COLUMNAR_VELOX_SPILL_STRATEGY =
     buildConf("spark.gluten.sql.columnar.backend.velox.spillStrategy")
       .internal()